@@ -0,0 +1,120 @@
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "basic_graphics.h"
+#include "bgfx_canvas.hpp"
+
+
+/*
+ * Compares the runtime-dispatched C functions with the compile-time
+ * specialized bgfx::Canvas, drawing the same scenes into buffers of the
+ * same layout. Both images are checked to be identical, which is the
+ * check that bgfx::detail still draws what the C functions draw, then the
+ * time per scene is printed for each rotation and pixel format.
+ *
+ * Build on a host, with optimizations, for example:
+ *   g++ -O2 -Isource example/example_canvas_benchmark.cpp \
+ *       source/basic_graphics.c -o canvas_benchmark
+ */
+
+
+#define ROUNDS 200
+
+
+/* Monotonic time in nanoseconds */
+static uint64_t Now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+
+/* Scene drawn with the C API */
+static void SceneC(BGFX_Parameters_t d, uint16_t fg, uint16_t bg)
+{
+  for (uint16_t i = 0; i < 64; i++) {
+    BGFX_DrawLine(0, i, d.Width - 1, d.Height - 1 - i, fg, d);
+    BGFX_DrawPixel(i * 3, i * 2, fg, d);
+  }
+  BGFX_DrawRect(2, 2, d.Width - 4, d.Height - 4, fg, d);
+  BGFX_DrawRectFill(10, 10, 60, 40, fg, d);
+  BGFX_DrawRoundRectFill(80, 10, 50, 40, 8, fg, d);
+  BGFX_DrawCircle(60, 60, 30, fg, d);
+  BGFX_DrawCircleFill(100, 40, 20, bg, d);
+  BGFX_DrawTriangleFill(5, 60, 60, 10, 110, 50, fg, d);
+  BGFX_DrawRoundRect(70, 30, 40, 30, 6, bg, d);
+  BGFX_DrawRoundRectFill(74, 34, 12, 10, -3, fg, d);
+  BGFX_DrawCircle(20, 40, 1, bg, d);
+  BGFX_DrawTriangle(8, 55, 100, 20, 40, 62, bg, d);
+  BGFX_SendString(0, 0, (uint8_t *)"Hello world", 11, fg, bg, 1, 1, d);
+  BGFX_SendString(4, 44, (uint8_t *)"Ab", 2, bg, fg, 2, 3, d);
+}
+
+
+/* Same scene drawn with the canvas */
+template <typename C>
+static void SceneCanvas(C &c, uint16_t fg, uint16_t bg)
+{
+  for (uint16_t i = 0; i < 64; i++) {
+    c.DrawLine(0, i, c.Width - 1, c.Height - 1 - i, fg);
+    c.DrawPixel(i * 3, i * 2, fg);
+  }
+  c.DrawRect(2, 2, c.Width - 4, c.Height - 4, fg);
+  c.DrawRectFill(10, 10, 60, 40, fg);
+  c.DrawRoundRectFill(80, 10, 50, 40, 8, fg);
+  c.DrawCircle(60, 60, 30, fg);
+  c.DrawCircleFill(100, 40, 20, bg);
+  c.DrawTriangleFill(5, 60, 60, 10, 110, 50, fg);
+  c.DrawRoundRect(70, 30, 40, 30, 6, bg);
+  c.DrawRoundRectFill(74, 34, 12, 10, -3, fg);
+  c.DrawCircle(20, 40, 1, bg);
+  c.DrawTriangle(8, 55, 100, 20, 40, 62, bg);
+  c.SendString(0, 0, "Hello world", 11, fg, bg);
+  c.SendString(4, 44, "Ab", 2, bg, fg, 2, 3);
+}
+
+
+template <typename Format, uint16_t W, uint16_t H, uint8_t R>
+static void Run(const char *Name, uint16_t fg, uint16_t bg)
+{
+  static bgfx::Canvas<Format, W, H, R> canvas;
+  static typename Format::Storage buffer[bgfx::Canvas<Format, W, H, R>::Length];
+  BGFX_Parameters_t d = canvas.Parameters();
+  uint64_t t0, t_c, t_canvas;
+  uint32_t i;
+
+  d.Buffer = buffer;
+  memset(buffer, 0, sizeof(buffer));
+  canvas.Clear(0);
+
+  t0 = Now();
+  for (i = 0; i < ROUNDS; i++) {
+    SceneC(d, fg, bg);
+  }
+  t_c = Now() - t0;
+
+  t0 = Now();
+  for (i = 0; i < ROUNDS; i++) {
+    SceneCanvas(canvas, fg, bg);
+  }
+  t_canvas = Now() - t0;
+
+  printf("%-8s rot %u: C %8.1f us  canvas %8.1f us  x%5.1f  %s\n", Name,
+      (unsigned)R, t_c / 1000.0 / ROUNDS, t_canvas / 1000.0 / ROUNDS,
+      (double)t_c / (t_canvas ? t_canvas : 1),
+      memcmp(buffer, canvas.Data(), sizeof(buffer)) ? "MISMATCH" : "same");
+}
+
+
+int main(void)
+{
+  Run<bgfx::Rgb565, 320, 240, 0>("rgb565", 0xF800, 0x001F);
+  Run<bgfx::Rgb565, 320, 240, 1>("rgb565", 0xF800, 0x001F);
+  Run<bgfx::Color8, 320, 240, 0>("color8", 0xE0, 0x1C);
+  Run<bgfx::Color8, 320, 240, 3>("color8", 0xE0, 0x1C);
+  Run<bgfx::Mono, 128, 64, 0>("mono", 1, 0);
+  Run<bgfx::Mono, 128, 64, 2>("mono", 1, 0);
+  return 0;
+}
@@ -0,0 +1,126 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "basic_graphics.h"
+#include "bgfx_console.h"
+#include "bgfx_sim.h"
+
+
+/*
+ * Log output on a console, on a simulated ILI9341 320x240 over SPI. Every
+ * frame a few log lines are written, the console is drawn and the changed
+ * area sent. Printed: CPU time spent drawing (scrolled pixels and changed
+ * cells only) against redrawing the whole console every frame, and the
+ * simulated bus time of the changed areas. The last frame is written to console.ppm.
+ *
+ * Usage: example_console_log [frames] [lines_per_frame]
+ */
+
+
+#define COLS        53
+#define ROWS        30
+#define SCROLLBACK  100
+
+
+static const uint16_t Palette[16] = {
+  0x0000, 0x8000, 0x0400, 0x8400, 0x0010, 0x8010, 0x0410, 0xC618,
+  0x8410, 0xF800, 0x07E0, 0xFFE0, 0x001F, 0xF81F, 0x07FF, 0xFFFF,
+};
+
+static BGFX_Cell_t Cells[2][BGFX_CONSOLE_STORAGE(COLS, ROWS, SCROLLBACK)];
+
+
+/* Writes one line of made up log */
+static void Log(BGFX_Console_t *Console, uint32_t n)
+{
+  char line[64];
+  int length;
+
+  Console->Attr = BGFX_ATTR((n % 7 == 0) ? 9 : 10, 0);
+  length = snprintf(line, sizeof(line), "[%6lu.%03lu] ",
+      (unsigned long)(n / 50), (unsigned long)(n % 50) * 20);
+  BGFX_ConsoleWrite(Console, (const uint8_t *)line, length);
+  Console->Attr = BGFX_ATTR(15, 0);
+  length = snprintf(line, sizeof(line), "sensor %lu\tvalue %lu%s\n",
+      (unsigned long)(n % 5), (unsigned long)((n * 7919) % 10000),
+      (n % 7 == 0) ? " out of range" : "");
+  BGFX_ConsoleWrite(Console, (const uint8_t *)line, length);
+}
+
+
+int main(int argc, char *argv[])
+{
+  static uint16_t lcd[2][320 * 240];
+  static uint8_t gram[320 * 240 * 2];
+  uint32_t frames = (argc > 1) ? strtoul(argv[1], NULL, 0) : 200;
+  uint32_t lines = (argc > 2) ? strtoul(argv[2], NULL, 0) : 3;
+  BGFX_Parameters_t display, other;
+  BGFX_Console_t console, reference;
+  BGFX_Sim_t sim;
+  BGFX_Rect_t region;
+  clock_t start, incremental = 0, full = 0;
+  uint32_t frame, i, n = 0;
+  uint8_t drawn;
+
+  memset(&display, 0, sizeof(display));
+  display.WIDTH = 320;
+  display.HEIGHT = 240;
+  display.ColorScheme = BGFX_16BITS;
+  display.Buffer = lcd[0];
+  BGFX_SetRotation(0, &display);
+  other = display;
+  other.Buffer = lcd[1];
+  BGFX_SimInit(&sim, BGFX_SIM_ILI9341, 320, 240, gram, BGFX_SimSpi(40000000));
+
+  memset(&console, 0, sizeof(console));
+  console.X = 1;
+  console.Cols = COLS;
+  console.Rows = ROWS;
+  console.Scrollback = SCROLLBACK;
+  console.Size = 1;
+  console.Palette = Palette;
+  console.Attr = BGFX_ATTR(15, 0);
+  console.Cells = Cells[0];
+  reference = console;
+  reference.Cells = Cells[1];
+  BGFX_ConsoleInit(&console);
+  BGFX_ConsoleInit(&reference);
+
+  for (frame = 0; frame < frames; frame++) {
+    for (i = 0; i < lines; i++) {
+      Log(&console, n);
+      Log(&reference, n++);
+    }
+
+    /* Same console rendered from scratch, for comparison only */
+    start = clock();
+    BGFX_ConsoleInvalidate(&reference);
+    BGFX_ConsoleDraw(&reference, NULL, other);
+    full += clock() - start;
+
+    start = clock();
+    drawn = BGFX_ConsoleDraw(&console, &region, display);
+    incremental += clock() - start;
+    if (drawn) {
+      BGFX_SimFlush(&sim, BGFX_RectToBuffer(region, display), display);
+    }
+  }
+
+  printf("%lu frames, %lu lines per frame\n", (unsigned long)frames,
+      (unsigned long)lines);
+  printf("  full redraw   %8.3f ms CPU per frame\n",
+      1e3 * full / CLOCKS_PER_SEC / frames);
+  printf("  incremental   %8.3f ms CPU per frame\n",
+      1e3 * incremental / CLOCKS_PER_SEC / frames);
+  printf("  bus           %8.3f ms per frame%s\n",
+      sim.Stats.TimeNs / 1e6 / frames,
+      memcmp(lcd[0], lcd[1], sizeof(lcd[0])) ? "  (picture differs)" : "");
+
+  if (BGFX_SimDump(&sim, "console.ppm") != 0) {
+    perror("console.ppm");
+  }
+  return 0;
+}
@@ -0,0 +1,87 @@
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include "basic_graphics.h"
+#include "bgfx_band.h"
+/* #include "your_display.h" */
+
+
+#define BAND_ROWS 16 /* 320 x 16 x 2 bytes = 10 KB instead of 150 KB */
+
+
+/* Prototype to a possible function to set the display window */
+void DISP_SetWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+  /* Your display code here */
+}
+
+/* Prototype to a possible function to write the pixels to the display */
+void DISP_WritePixels(uint8_t *Buffer, uint32_t Size)
+{
+  /* Your display code here */
+}
+
+/* Blocking delay */
+void Delay(void)
+{
+  /* Change for your system's delay */
+  for(int i = 0; i < 5000000; i++);
+}
+
+
+/* State of the frame, read by the drawing function */
+typedef struct
+{
+  uint16_t Counter;
+}Frame_t;
+
+
+/* Draws the whole frame, called once per band */
+void DrawFrame(BGFX_Parameters_t Display, void *Context)
+{
+  Frame_t *frame = (Frame_t *)Context;
+  uint16_t x = frame->Counter % Display.Width;
+
+  BGFX_DrawRect(0, 0, Display.Width, Display.Height, 0x0000, Display);
+  BGFX_DrawLine(0, 0, Display.Width - 1, Display.Height - 1, 0xF800, Display);
+  BGFX_DrawLine(0, Display.Height - 1, Display.Width - 1, 0, 0x07E0, Display);
+  BGFX_DrawCircleFill(Display.Width / 2, Display.Height / 2, 60, 0x001F,
+      Display);
+  BGFX_DrawRoundRectFill(x, 10, 40, 30, 8, 0xFFE0, Display);
+  BGFX_SendString(10, Display.Height - 20, (uint8_t *)"Band rendering", 14,
+      0x0000, 0xFFFF, 1, 1, Display);
+}
+
+/* Sends a band to its window of the display */
+void FlushBand(const void *Buffer, uint16_t y, uint16_t Rows, void *Context)
+{
+  DISP_SetWindow(0, y, 320, Rows);
+  DISP_WritePixels((uint8_t *)Buffer, 320 * Rows * sizeof(uint16_t));
+}
+
+
+void main(void)
+{
+  static uint16_t band[320 * BAND_ROWS]; /* One band of pixels */
+  static BGFX_Parameters_t BGFX_1;
+  Frame_t frame;
+
+  memset(&BGFX_1, 0, sizeof(BGFX_1));
+  BGFX_1.HEIGHT      = 240;
+  BGFX_1.WIDTH       = 320;
+  BGFX_1.ColorScheme = BGFX_16BITS;
+  BGFX_1.Buffer      = NULL; /* Set by BGFX_RenderBands */
+  BGFX_1.DrawPixel   = NULL;
+  BGFX_1.GfxFont     = NULL;
+
+  /* Setting rotation to zero */
+  BGFX_SetRotation(0, &BGFX_1);
+
+  for (frame.Counter = 0; ; frame.Counter += 4) {
+    /* The frame is drawn 15 times, once per band of 16 rows */
+    BGFX_RenderBands(band, BAND_ROWS, 0xFFFF, DrawFrame, FlushBand, &frame,
+        BGFX_1);
+    Delay();
+  }
+}
@@ -4,6 +4,7 @@
 #include <stdlib.h>
 #include <stddef.h>
 #include "basic_graphics.h"
+#include "bgfx_chart.h"
 /* #include "your_display.h" */
 
 
@@ -158,44 +159,37 @@ void main(void)
   Delay();
 
 
-  /* Plotting a sine wave */
-  /* Cleaning the space where the plot will be positioned */
-  BGFX_DrawRectFill(0, 25, 128, 25, main_color, BGFX_1);
+  /* Plotting a sine wave with a strip chart */
+  static int16_t chart_columns[BGFX_CHART_STORAGE(128, 1)];
+  static const uint16_t chart_colors[1] = {0xFFFF}; /* White trace */
+  static BGFX_Chart_t chart;
+  int16_t dirty_x, dirty_w;
+
+  chart.X = 0;
+  chart.Y = 25;
+  chart.W = 128;
+  chart.H = 25;
+  chart.Min = -12;
+  chart.Max = 12;
+  chart.Channels = 1;
+  chart.Colors = chart_colors;
+  chart.Background = main_color;
+  chart.Decimation = 1;
+  chart.Mode = BGFX_CHART_SCROLL;
+  chart.Columns = chart_columns;
+  BGFX_ChartInit(&chart, BGFX_1);
 
-
-  /* Pre-computing sine table */
-  uint16_t sine_table[128];
-  for(uint32_t i = 0; i < 128; i++)
-  {
-    float auxf = sinf((float)(i + counter)*0.2);
-    auxf *= 12;
-    auxf += 37;
-    sine_table[i] = auxf;
-  }
-
-  uint8_t head = 0;
-  uint8_t tail = 127;
   while(1)
   {
-    for(uint32_t i = 0; i < 128; i++)
+    /* One new sample per step, only the newest column is drawn */
+    int16_t sample = (int16_t)(sinf((float)counter*0.2f)*12);
+    counter++;
+    BGFX_ChartPush(&chart, &sample, 1, BGFX_1);
+    if(BGFX_ChartGetDirty(&chart, &dirty_x, &dirty_w))
     {
-      if(head+i < 128)
-      {
-        BGFX_DrawPixel(i, sine_table[head+i], background_color, BGFX_1);
-      }else
-      {
-        BGFX_DrawPixel(i, sine_table[(head+i)-128], background_color, BGFX_1);
-      }
-      if(tail+i < 128)
-      {
-        BGFX_DrawPixel(i, sine_table[tail+i], main_color, BGFX_1);
-      }else
-      {
-        BGFX_DrawPixel(i, sine_table[(tail+i)-128], main_color, BGFX_1);
-      }
+      /* Rows 25 to 49 hold the plot, send only them */
+      DISP_WritePixels((uint8_t*)&buffer[chart.Y*128],
+          chart.H*128*sizeof(uint16_t));
     }
-    head++;  if(head >= 128){head = 0;}
-    tail++;  if(tail >= 128){tail = 0;}
-    DISP_WritePixels(buffer, buffer_size);
   }
 }
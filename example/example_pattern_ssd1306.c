@@ -0,0 +1,148 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "basic_graphics.h"
+#include "bgfx_pattern.h"
+#include "bgfx_sim.h"
+
+
+/*
+ * Grid lines and hatched areas on a simulated SSD1306 128x64, the way a
+ * chart background or a disabled widget is drawn. Every frame is drawn
+ * twice: with dashed lines and pattern fills, and with the BGFX_DrawPixel
+ * loops they replace. Printed: CPU time of both per frame. The last frame
+ * is sent to the simulator and written to pattern.pbm.
+ *
+ * Usage: example_pattern_ssd1306 [frames]
+ */
+
+
+#define OLED_WIDTH  128
+#define OLED_HEIGHT  64
+
+
+/* Diagonal hatch, one pixel every 4 */
+static const BGFX_Pattern_t Hatch = {
+  {0x11, 0x22, 0x44, 0x88, 0x11, 0x22, 0x44, 0x88}, 8, 0, 0
+};
+
+/* 50% checkerboard */
+static const BGFX_Pattern_t Checker = {
+  {0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA, 0x55, 0xAA}, 8, 0, 0
+};
+
+
+/* Frame drawn with the pattern functions */
+static void DrawPatterns(BGFX_Parameters_t Display)
+{
+  static const BGFX_Dash_t dotted = BGFX_DASH(1, 1);
+  static const BGFX_Dash_t dashed = BGFX_DASH(4, 2);
+  int16_t i;
+
+  for (i = 0; i < OLED_WIDTH; i += 16) {
+    BGFX_DrawLineDashed(i, 0, i, OLED_HEIGHT - 1, &dotted, 0, 1, 1,
+        Display);
+  }
+  for (i = 0; i < OLED_HEIGHT; i += 16) {
+    BGFX_DrawLineDashed(0, i, OLED_WIDTH - 1, i, &dotted, 0, 1, 1, Display);
+  }
+  BGFX_DrawRectPattern(8, 8, 48, 24, &Hatch, 1, 0, Display);
+  BGFX_DrawCirclePattern(96, 40, 20, &Checker, 1, 1, Display);
+  BGFX_DrawRectDashed(4, 36, 56, 24, &dashed, 1, 1, Display);
+}
+
+
+/* Same frame, one BGFX_DrawPixel per pixel */
+static void DrawPixels(BGFX_Parameters_t Display)
+{
+  int16_t i, x, y;
+
+  for (i = 0; i < OLED_WIDTH; i += 16) {
+    for (y = 0; y < OLED_HEIGHT; y += 2) {
+      BGFX_DrawPixel(i, y, 1, Display);
+    }
+  }
+  for (i = 0; i < OLED_HEIGHT; i += 16) {
+    for (x = 0; x < OLED_WIDTH; x += 2) {
+      BGFX_DrawPixel(x, i, 1, Display);
+    }
+  }
+  for (y = 8; y < 32; y++) {
+    for (x = 8; x < 56; x++) {
+      BGFX_DrawPixel(x, y, (Hatch.Rows[y % 8] >> (x % 8)) & 1, Display);
+    }
+  }
+  for (y = -20; y <= 20; y++) {
+    for (x = -20; x <= 20; x++) {
+      if ((x * x + y * y <= 20 * 20 + 20) && (((x + y) & 1) == 0)) {
+        BGFX_DrawPixel(96 + x, 40 + y, 1, Display);
+      }
+    }
+  }
+  for (i = 0; i < 2 * (56 + 24) - 4; i++) {
+    if (i % 6 >= 4) {
+      continue;
+    }
+    if (i < 55) {
+      x = 4 + i; y = 36;
+    } else if (i < 55 + 23) {
+      x = 59; y = 36 + i - 55;
+    } else if (i < 2 * 55 + 23) {
+      x = 59 - (i - 55 - 23); y = 59;
+    } else {
+      x = 4; y = 59 - (i - 2 * 55 - 23);
+    }
+    BGFX_DrawPixel(x, y, 1, Display);
+  }
+}
+
+
+int main(int argc, char *argv[])
+{
+  static uint8_t buffer[OLED_WIDTH * OLED_HEIGHT / 8];
+  static uint8_t gram[OLED_WIDTH * OLED_HEIGHT / 8];
+  uint32_t frames = (argc > 1) ? strtoul(argv[1], NULL, 0) : 2000;
+  BGFX_Parameters_t display;
+  BGFX_Rect_t screen = {0, 0, OLED_WIDTH, OLED_HEIGHT};
+  BGFX_Sim_t sim;
+  clock_t start, patterns = 0, pixels = 0;
+  uint32_t frame;
+
+  memset(&display, 0, sizeof(display));
+  display.WIDTH = OLED_WIDTH;
+  display.HEIGHT = OLED_HEIGHT;
+  display.WidthPixelsOnWrite = 1;
+  display.HeightPixelsOnWrite = 8;
+  display.ColorScheme = BGFX_MONOCHROMATIC;
+  display.Buffer = buffer;
+  BGFX_SetRotation(0, &display);
+  BGFX_SimInit(&sim, BGFX_SIM_SSD1306, OLED_WIDTH, OLED_HEIGHT, gram,
+      BGFX_SimI2c(400000));
+
+  for (frame = 0; frame < frames; frame++) {
+    memset(buffer, 0, sizeof(buffer));
+    start = clock();
+    DrawPixels(display);
+    pixels += clock() - start;
+
+    memset(buffer, 0, sizeof(buffer));
+    start = clock();
+    DrawPatterns(display);
+    patterns += clock() - start;
+  }
+
+  printf("%lu frames\n", (unsigned long)frames);
+  printf("  BGFX_DrawPixel  %8.4f ms CPU per frame\n",
+      1e3 * pixels / CLOCKS_PER_SEC / frames);
+  printf("  patterns        %8.4f ms CPU per frame\n",
+      1e3 * patterns / CLOCKS_PER_SEC / frames);
+
+  BGFX_SimFlush(&sim, screen, display);
+  if (BGFX_SimDump(&sim, "pattern.pbm") != 0) {
+    perror("pattern.pbm");
+  }
+  return 0;
+}
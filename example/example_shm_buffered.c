@@ -0,0 +1,79 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L /* nanosleep */
+#endif
+#include <math.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+#include "basic_graphics.h"
+#include "bgfx_shm.h"
+
+
+/* Clears the buffer */
+void DISP_ClearBuffer(uint16_t *Buffer, uint32_t Size, uint16_t color)
+{
+  for(int i=0; i<Size; i++) {Buffer[i] = color;}
+}
+
+
+int main(void)
+{
+  /* Writing in an area with size 320 x 240, equivalent to ILI9341. The
+   * buffer lives in the POSIX shared memory object "/bgfx0", run
+   * example_shm_dump to look at the frames. */
+  static BGFX_Shm_t shm;
+  static BGFX_Parameters_t BGFX_1;
+  uint16_t main_color = 0x0000; //Black
+  uint16_t background_color = 0xFFFF; //White
+  const struct timespec frame_time = {0, 33000000};
+  uint32_t buffer_size;
+  uint32_t counter = 0;
+
+  BGFX_1.HEIGHT      = 240;
+  BGFX_1.WIDTH       = 320;
+  BGFX_1.WidthPixelsOnWrite  = 1;
+  BGFX_1.HeightPixelsOnWrite = 1;
+  BGFX_1.Rotation = 0; /* No software rotation intended */
+  BGFX_1.ColorScheme = BGFX_16BITS;
+  BGFX_1.DrawPixel   = NULL;
+  BGFX_1.GfxFont     = NULL;
+
+  /* Allocating the buffer, this sets BGFX_1.Buffer */
+  if (BGFX_ShmCreate(&shm, BGFX_SHM_POSIX, "/bgfx0", &BGFX_1) != 0) {
+    perror("BGFX_ShmCreate");
+    return 1;
+  }
+  buffer_size = BGFX_GetBufferSize(BGFX_1) / sizeof(uint16_t);
+
+  /* Setting rotation to zero */
+  BGFX_SetRotation(0, &BGFX_1);
+
+
+  /* Plotting a moving sine wave, one published frame per step */
+  while(1)
+  {
+    BGFX_ShmBeginFrame(&shm);
+
+    DISP_ClearBuffer((uint16_t *)BGFX_1.Buffer, buffer_size, background_color);
+    BGFX_DrawRect(0, 0, 320, 240, main_color, BGFX_1);
+    BGFX_SendString(4, 4, (uint8_t*)"Hello world", 11, main_color,
+        background_color, 2, 2, BGFX_1);
+    for(uint32_t i = 0; i < 320; i++)
+    {
+      float auxf = sinf((float)(i + counter)*0.05);
+      auxf *= 80;
+      auxf += 130;
+      BGFX_DrawPixel(i, auxf, main_color, BGFX_1);
+    }
+    counter += 2;
+
+    BGFX_ShmEndFrame(&shm);
+    nanosleep(&frame_time, NULL);
+  }
+
+  BGFX_ShmClose(&shm, BGFX_SHM_POSIX, "/bgfx0");
+  return 0;
+}
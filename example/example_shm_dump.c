@@ -0,0 +1,127 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L /* nanosleep */
+#endif
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "basic_graphics.h"
+#include "bgfx_shm.h"
+
+
+/*
+ * Reference consumer for the shared-memory framebuffer. It maps the segment
+ * read-only, waits for new frames and writes each one as a netpbm image:
+ * PBM for monochromatic buffers, PGM for 8 bits and PPM for 16 bits 5-6-5.
+ *
+ * Usage: example_shm_dump [name] [frames]
+ *   name    POSIX object name ("/bgfx0") or a file path, including
+ *           "/proc/<pid>/fd/<fd>" for a memfd
+ *   frames  Number of frames to dump, default 1
+ */
+
+
+/* Writes one frame, the pixels are decoded with BGFX_GetPixel */
+static void DumpFrame(FILE *f, BGFX_Parameters_t Display)
+{
+  uint16_t x, y, c;
+
+  switch (Display.ColorScheme) {
+  case BGFX_MONOCHROMATIC:
+    fprintf(f, "P1\n%u %u\n", Display.Width, Display.Height);
+    break;
+  case BGFX_8BITS:
+    fprintf(f, "P5\n%u %u\n255\n", Display.Width, Display.Height);
+    break;
+  default:
+    fprintf(f, "P6\n%u %u\n255\n", Display.Width, Display.Height);
+    break;
+  }
+
+  for (y = 0; y < Display.Height; y++) {
+    for (x = 0; x < Display.Width; x++) {
+      c = BGFX_GetPixel(x, y, Display);
+      switch (Display.ColorScheme) {
+      case BGFX_MONOCHROMATIC:
+        fputc(c ? '0' : '1', f); /* PBM 1 is black */
+        break;
+      case BGFX_8BITS:
+        fputc(c, f);
+        break;
+      default:
+        fputc(((c >> 11) & 0x1F) * 255 / 31, f);
+        fputc(((c >> 5) & 0x3F) * 255 / 63, f);
+        fputc((c & 0x1F) * 255 / 31, f);
+        break;
+      }
+    }
+    if (Display.ColorScheme == BGFX_MONOCHROMATIC) {
+      fputc('\n', f);
+    }
+  }
+}
+
+
+int main(int argc, char *argv[])
+{
+  static BGFX_Shm_t shm;
+  static BGFX_Parameters_t BGFX_1;
+  const char *name = (argc > 1) ? argv[1] : "/bgfx0";
+  uint32_t frames = (argc > 2) ? strtoul(argv[2], NULL, 0) : 1;
+  const struct timespec poll = {0, 1000000};
+  uint32_t last = 0, seq;
+  uint8_t *copy;
+  char path[64];
+  FILE *f;
+
+  if (BGFX_ShmOpen(&shm, (name[0] == '/' && strchr(name + 1, '/') == NULL) ?
+      BGFX_SHM_POSIX : BGFX_SHM_FILE, name) != 0)
+  {
+    perror(name);
+    return 1;
+  }
+  BGFX_ShmGetParameters(&shm, &BGFX_1);
+  printf("%ux%u, color scheme %u, %u bytes\n", BGFX_1.WIDTH, BGFX_1.HEIGHT,
+      (unsigned)BGFX_1.ColorScheme, shm.Header->BufferSize);
+
+  /* Encoding straight from the mapping could be done zero-copy, but the
+   * file output is slow, so the frame is snapshot first to keep the
+   * producer from tearing it */
+  copy = malloc(shm.Header->BufferSize);
+  if (copy == NULL) {
+    return 1;
+  }
+
+  while (frames > 0) {
+    seq = BGFX_ShmReadBegin(&shm);
+    if (seq == last) {
+      nanosleep(&poll, NULL);
+      continue;
+    }
+    memcpy(copy, shm.Buffer, shm.Header->BufferSize);
+    if (!BGFX_ShmReadValid(&shm, seq)) {
+      continue;
+    }
+    last = seq;
+
+    snprintf(path, sizeof(path), "frame_%06u.%s", seq / 2,
+        (BGFX_1.ColorScheme == BGFX_MONOCHROMATIC) ? "pbm" :
+        (BGFX_1.ColorScheme == BGFX_8BITS) ? "pgm" : "ppm");
+    f = fopen(path, "wb");
+    if (f == NULL) {
+      perror(path);
+      break;
+    }
+    BGFX_1.Buffer = copy;
+    DumpFrame(f, BGFX_1);
+    fclose(f);
+    printf("%s\n", path);
+    frames--;
+  }
+
+  free(copy);
+  BGFX_ShmClose(&shm, BGFX_SHM_POSIX, NULL);
+  return 0;
+}
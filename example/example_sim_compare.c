@@ -0,0 +1,198 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "basic_graphics.h"
+#include "bgfx_sim.h"
+#include "bgfx_widget.h"
+
+
+/*
+ * Compares three ways of updating a display, on a simulated ILI9341 over
+ * SPI and a simulated SSD1306 over I2C:
+ * - full:   draw into a framebuffer, send the whole frame
+ * - dirty:  draw into a framebuffer, send the area the widgets changed
+ * - direct: no framebuffer, every pixel is sent as it is drawn
+ * Every strategy draws the same frames, a few widgets updated each frame.
+ * The simulated time is the bus time only. The last frame of each display
+ * is written to sim_ili9341.ppm and sim_ssd1306.pbm.
+ *
+ * Usage: example_sim_compare [frames] [spi_hz] [i2c_hz]
+ */
+
+
+typedef enum
+{
+  STRATEGY_FULL = 0,
+  STRATEGY_DIRTY,
+  STRATEGY_DIRECT,
+}Strategy_t;
+
+static const char *Names[] = {"full", "dirty", "direct"};
+
+
+/* Display used by the unbuffered strategy, DrawPixel has no context */
+static BGFX_Sim_t *Direct;
+
+static void DirectPixel(uint16_t x, uint16_t y, uint16_t color)
+{
+  BGFX_SimWritePixel(Direct, x, y, color);
+}
+
+
+/* Runs one strategy, returns the statistics of all frames but the first */
+static BGFX_SimStats_t Run(BGFX_Sim_t *Sim, Strategy_t Strategy,
+    uint32_t Frames, BGFX_Parameters_t Display, uint16_t fg, uint16_t bg)
+{
+  BGFX_Widget_t widgets[3];
+  BGFX_SimStats_t total;
+  BGFX_Rect_t region, screen = {0, 0, 0, 0};
+  uint16_t unit = Display.Height / 8;
+  uint32_t frame;
+
+  memset(&total, 0, sizeof(total));
+  memset(widgets, 0, sizeof(widgets));
+  widgets[0].Type = BGFX_WIDGET_LABEL;
+  widgets[1].Type = BGFX_WIDGET_NUMBER;
+  widgets[2].Type = BGFX_WIDGET_BAR;
+  for (frame = 0; frame < 3; frame++) {
+    widgets[frame].Bounds.X = unit;
+    widgets[frame].Bounds.Y = unit + frame * 2 * unit;
+    widgets[frame].Bounds.W = Display.Width - 2 * unit;
+    widgets[frame].Bounds.H = (unit > 10) ? unit : 10;
+    widgets[frame].Color = fg;
+    widgets[frame].Background = bg;
+    widgets[frame].Size = (unit >= 16) ? 2 : 1;
+    widgets[frame].Max = 1000;
+  }
+  BGFX_WidgetSetText(&widgets[0], "Flow");
+  BGFX_WidgetSetText(&widgets[1], " l/h");
+
+  if (Strategy == STRATEGY_DIRECT) {
+    Direct = Sim;
+    Display.DrawPixel = DirectPixel;
+  }
+  screen.W = Display.Width;
+  screen.H = Display.Height;
+
+  for (frame = 0; frame < Frames; frame++) {
+    BGFX_SimResetStats(Sim);
+    if (frame == 0) {
+      BGFX_DrawRectFill(0, 0, Display.Width, Display.Height, bg, Display);
+    }
+    widgets[1].Value = (frame * 37) % 1000;
+    widgets[2].Value = (frame * 53) % 1000;
+    BGFX_WidgetsDraw(widgets, 3, &region, Display);
+
+    switch (Strategy) {
+    case STRATEGY_FULL:
+      BGFX_SimFlush(Sim, BGFX_RectToBuffer(screen, Display), Display);
+      break;
+    case STRATEGY_DIRTY:
+      if (frame == 0) {
+        region = screen;
+      }
+      BGFX_SimFlush(Sim, BGFX_RectToBuffer(region, Display), Display);
+      break;
+    default:
+      break;
+    }
+
+    /* First frame draws everything, it is not part of the average */
+    if (frame > 0) {
+      total.TimeNs += Sim->Stats.TimeNs;
+      total.Commands += Sim->Stats.Commands;
+      total.CommandBytes += Sim->Stats.CommandBytes;
+      total.Transfers += Sim->Stats.Transfers;
+      total.DataBytes += Sim->Stats.DataBytes;
+    }
+  }
+
+  return total;
+}
+
+
+/* Runs every strategy on one display and checks they end on the same
+ * picture */
+static void Compare(const char *Title, BGFX_SimController_t Controller,
+    BGFX_SimBus_t Bus, uint32_t Frames, BGFX_Parameters_t Display,
+    uint16_t fg, uint16_t bg, const char *Path)
+{
+  uint32_t gram_size = BGFX_SimGramSize(Controller, Display.WIDTH,
+      Display.HEIGHT);
+  uint8_t *gram = malloc(gram_size);
+  uint8_t *first = malloc(gram_size);
+  BGFX_SimStats_t s;
+  BGFX_Sim_t sim;
+  uint32_t n = (Frames > 1) ? Frames - 1 : 1;
+  int strategy;
+
+  if ((gram == NULL) || (first == NULL)) {
+    return;
+  }
+
+  printf("%s\n", Title);
+  printf("  %-7s %12s %10s %12s %10s\n", "", "ms/frame", "cmd/frame",
+      "bytes/frame", "fps max");
+  for (strategy = STRATEGY_FULL; strategy <= STRATEGY_DIRECT; strategy++) {
+    BGFX_SimInit(&sim, Controller, Display.WIDTH, Display.HEIGHT, gram, Bus);
+    if (Display.Buffer != NULL) {
+      memset(Display.Buffer, 0, BGFX_GetBufferSize(Display));
+    }
+    s = Run(&sim, (Strategy_t)strategy, Frames, Display, fg, bg);
+    printf("  %-7s %12.3f %10lu %12lu %10.1f%s\n", Names[strategy],
+        s.TimeNs / 1e6 / n, (unsigned long)(s.Commands / n),
+        (unsigned long)((s.CommandBytes + s.DataBytes) / n),
+        (s.TimeNs > 0) ? 1e9 * n / s.TimeNs : 0.0,
+        ((strategy > STRATEGY_FULL) && memcmp(first, gram, gram_size)) ?
+        "  (picture differs)" : "");
+    if (strategy == STRATEGY_FULL) {
+      memcpy(first, gram, gram_size);
+    }
+  }
+
+  if (BGFX_SimDump(&sim, Path) != 0) {
+    perror(Path);
+  }
+  free(first);
+  free(gram);
+}
+
+
+int main(int argc, char *argv[])
+{
+  static uint16_t lcd[320 * 240];
+  static uint8_t oled[128 * 64 / 8];
+  BGFX_Parameters_t display;
+  uint32_t frames = (argc > 1) ? strtoul(argv[1], NULL, 0) : 50;
+  uint32_t spi_hz = (argc > 2) ? strtoul(argv[2], NULL, 0) : 40000000;
+  uint32_t i2c_hz = (argc > 3) ? strtoul(argv[3], NULL, 0) : 400000;
+  char title[64];
+
+  memset(&display, 0, sizeof(display));
+  display.WIDTH = 320;
+  display.HEIGHT = 240;
+  display.ColorScheme = BGFX_16BITS;
+  display.Buffer = lcd;
+  BGFX_SetRotation(0, &display);
+  snprintf(title, sizeof(title), "ILI9341 320x240, SPI %lu Hz",
+      (unsigned long)spi_hz);
+  Compare(title, BGFX_SIM_ILI9341, BGFX_SimSpi(spi_hz), frames, display,
+      0xFFFF, 0x0010, "sim_ili9341.ppm");
+
+  memset(&display, 0, sizeof(display));
+  display.WIDTH = 128;
+  display.HEIGHT = 64;
+  display.WidthPixelsOnWrite = 1;
+  display.HeightPixelsOnWrite = 8;
+  display.ColorScheme = BGFX_MONOCHROMATIC;
+  display.Buffer = oled;
+  BGFX_SetRotation(0, &display);
+  snprintf(title, sizeof(title), "SSD1306 128x64, I2C %lu Hz",
+      (unsigned long)i2c_hz);
+  Compare(title, BGFX_SIM_SSD1306, BGFX_SimI2c(i2c_hz), frames, display,
+      1, 0, "sim_ssd1306.pbm");
+
+  return 0;
+}
@@ -0,0 +1,161 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "basic_graphics.h"
+#include "bgfx_text.h"
+#include "bgfx_supersample.h"
+#include "bgfx_sim.h"
+
+
+/*
+ * A gauge face drawn on a simulated ILI9341 320x240 with supersampling, at
+ * 2x and 4x: triangles, circles, lines and text drawn with the usual
+ * functions on the larger surface, then averaged to the display. Printed
+ * per frame and per scale: CPU time to draw, to resolve the whole screen,
+ * to resolve the area of the needle only, and to resolve with a plain
+ * per-component loop for comparison. The 4x frame is sent to the simulator
+ * and written to supersample.ppm.
+ *
+ * Usage: example_supersample_ili9341 [frames]
+ */
+
+
+#define LCD_WIDTH  320
+#define LCD_HEIGHT 240
+
+
+/* Gauge face, in display pixels times Scale */
+static void DrawScene(int16_t s, BGFX_Parameters_t Surface)
+{
+  BGFX_Rect_t box;
+  int16_t i;
+
+  BGFX_DrawRectFill(0, 0, LCD_WIDTH * s, LCD_HEIGHT * s, 0x0000, Surface);
+  BGFX_DrawCircleFill(160 * s, 130 * s, 100 * s, 0x18E3, Surface);
+  for (i = 0; i < 4 * s; i++) {
+    BGFX_DrawCircle(160 * s, 130 * s, 100 * s - i, 0xFD20, Surface);
+  }
+  for (i = 0; i < 9; i++) {
+    BGFX_DrawLine((70 + 22 * i) * s, 60 * s, (160 + 2 * (i - 4)) * s,
+        120 * s, 0xFFFF, Surface);
+  }
+  BGFX_DrawTriangleFill(160 * s, 130 * s, 240 * s, 70 * s, 168 * s,
+      142 * s, 0xF800, Surface);
+  BGFX_DrawCircleFill(160 * s, 130 * s, 12 * s, 0xC618, Surface);
+  box.X = 0;
+  box.Y = 200 * s;
+  box.W = LCD_WIDTH * s;
+  box.H = 24 * s;
+  BGFX_DrawText("1234 rpm", box, BGFX_ALIGN_CENTER, 0, 0xFFFF, 0xFFFF,
+      2 * s, Surface);
+}
+
+
+/* Same average as BGFX_SupersampleResolve, one component at a time */
+static void ResolvePlain(const uint16_t *Src, uint16_t *Dst, int16_t s)
+{
+  uint32_t r, g, b, n = (uint32_t)s * s;
+  uint16_t p;
+  int16_t x, y, i, j;
+
+  for (y = 0; y < LCD_HEIGHT; y++) {
+    for (x = 0; x < LCD_WIDTH; x++) {
+      r = g = b = n / 2;
+      for (j = 0; j < s; j++) {
+        for (i = 0; i < s; i++) {
+          p = Src[((uint32_t)y * s + j) * LCD_WIDTH * s + x * s + i];
+          r += p >> 11;
+          g += (p >> 5) & 0x3F;
+          b += p & 0x1F;
+        }
+      }
+      Dst[y * LCD_WIDTH + x] =
+          (uint16_t)(((r / n) << 11) | ((g / n) << 5) | (b / n));
+    }
+  }
+}
+
+
+int main(int argc, char *argv[])
+{
+  static uint16_t lcd[LCD_WIDTH * LCD_HEIGHT];
+  static uint16_t plain[LCD_WIDTH * LCD_HEIGHT];
+  uint32_t frames = (argc > 1) ? strtoul(argv[1], NULL, 0) : 50;
+  uint32_t gram_size = BGFX_SimGramSize(BGFX_SIM_ILI9341, LCD_WIDTH,
+      LCD_HEIGHT);
+  uint8_t *gram = malloc(gram_size);
+  BGFX_Parameters_t display;
+  BGFX_Supersample_t ss;
+  BGFX_Rect_t screen = {0, 0, LCD_WIDTH, LCD_HEIGHT};
+  BGFX_Rect_t region;
+  BGFX_Sim_t sim;
+  clock_t start, draw, full, part, loop;
+  uint32_t frame;
+  void *surface;
+  int16_t s;
+
+  memset(&display, 0, sizeof(display));
+  display.WIDTH = LCD_WIDTH;
+  display.HEIGHT = LCD_HEIGHT;
+  display.ColorScheme = BGFX_16BITS;
+  display.Buffer = lcd;
+  BGFX_SetRotation(0, &display);
+
+  printf("%lu frames\n", (unsigned long)frames);
+  for (s = 2; s <= 4; s += 2) {
+    surface = malloc(BGFX_SupersampleBufferSize(s, display));
+    if ((surface == NULL) ||
+        (BGFX_SupersampleInit(&ss, surface, s, display) != 0)) {
+      return 1;
+    }
+    draw = full = part = loop = 0;
+
+    for (frame = 0; frame < frames; frame++) {
+      start = clock();
+      DrawScene(s, ss.Surface);
+      draw += clock() - start;
+
+      BGFX_SupersampleInvalidate(&ss, 0, 0, LCD_WIDTH * s, LCD_HEIGHT * s);
+      start = clock();
+      BGFX_SupersampleResolve(&ss, &region, display);
+      full += clock() - start;
+
+      /* Needle box only */
+      BGFX_SupersampleInvalidate(&ss, 148 * s, 60 * s, 104 * s, 94 * s);
+      start = clock();
+      BGFX_SupersampleResolve(&ss, &region, display);
+      part += clock() - start;
+
+      start = clock();
+      ResolvePlain((const uint16_t *)surface, plain, s);
+      loop += clock() - start;
+    }
+
+    printf("%dx, surface %lu bytes\n", s,
+        (unsigned long)BGFX_SupersampleBufferSize(s, display));
+    printf("  draw              %8.4f ms CPU per frame\n",
+        1e3 * draw / CLOCKS_PER_SEC / frames);
+    printf("  resolve screen    %8.4f ms CPU per frame\n",
+        1e3 * full / CLOCKS_PER_SEC / frames);
+    printf("  resolve %3dx%-3d   %8.4f ms CPU per frame\n", region.W,
+        region.H, 1e3 * part / CLOCKS_PER_SEC / frames);
+    printf("  plain loop        %8.4f ms CPU per frame%s\n",
+        1e3 * loop / CLOCKS_PER_SEC / frames,
+        memcmp(lcd, plain, sizeof(lcd)) ? ", DIFFERENT" : "");
+    free(surface);
+  }
+
+  if (gram != NULL) {
+    BGFX_SimInit(&sim, BGFX_SIM_ILI9341, LCD_WIDTH, LCD_HEIGHT, gram,
+        BGFX_SimSpi(40000000));
+    BGFX_SimFlush(&sim, screen, display);
+    if (BGFX_SimDump(&sim, "supersample.ppm") != 0) {
+      perror("supersample.ppm");
+    }
+    free(gram);
+  }
+  return 0;
+}
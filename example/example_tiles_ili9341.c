@@ -0,0 +1,155 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "basic_graphics.h"
+#include "bgfx_text.h"
+#include "bgfx_tiles.h"
+#include "bgfx_sim.h"
+
+
+/*
+ * A flat settings screen on a simulated ILI9341 320x240, drawn into a tiled
+ * framebuffer instead of a full BGFX_16BITS buffer: panels and buttons as
+ * tile fills, the text through a DrawPixel function writing the tiles. The
+ * frame is streamed to the simulator row by row. Printed: memory used by
+ * the tiles against the full buffer, CPU time to draw and to expand a
+ * frame, and the simulated bus time. The frame is written to tiles.ppm.
+ *
+ * Usage: example_tiles_ili9341 [frames]
+ */
+
+
+#define LCD_WIDTH  320
+#define LCD_HEIGHT 240
+#define POOL_TILES 160
+
+
+static BGFX_Tiles_t Tiles;
+
+
+/* Used by everything drawn pixel by pixel */
+static void TilesPixel(uint16_t x, uint16_t y, uint16_t color)
+{
+  BGFX_TilesWritePixel(&Tiles, x, y, color);
+}
+
+
+/* Rows go straight to the panel, 5-6-5 high byte first */
+static void SendRow(const uint16_t *Pixels, uint16_t x, uint16_t y,
+    uint16_t Count, void *Context)
+{
+  uint8_t bytes[LCD_WIDTH * 2];
+  uint16_t i;
+
+  (void)x;
+  (void)y;
+  for (i = 0; i < Count; i++) {
+    bytes[2 * i] = Pixels[i] >> 8;
+    bytes[2 * i + 1] = Pixels[i] & 0xFF;
+  }
+  if (Context != NULL) {
+    BGFX_SimData((BGFX_Sim_t *)Context, bytes, 2 * Count);
+  }
+}
+
+
+static void DrawScreen(BGFX_Parameters_t Display)
+{
+  BGFX_Parameters_t text = Display;
+  BGFX_Rect_t box;
+  int16_t i;
+
+  text.DrawPixel = TilesPixel;
+
+  BGFX_TilesFillRect(&Tiles, 0, 0, LCD_WIDTH, LCD_HEIGHT, 0xEF7D, Display);
+  BGFX_TilesFillRect(&Tiles, 0, 0, LCD_WIDTH, 32, 0x2945, Display);
+  box.X = 8;
+  box.Y = 8;
+  box.W = 200;
+  box.H = 16;
+  BGFX_DrawText("Settings", box, BGFX_ALIGN_LEFT, 0, 0xFFFF, 0xFFFF, 2,
+      text);
+
+  for (i = 0; i < 3; i++) {
+    BGFX_TilesFillRoundRect(&Tiles, 16, 48 + 56 * i, 288, 48, 8, 0xFFFF,
+        Display);
+    box.X = 32;
+    box.Y = 64 + 56 * i;
+    box.W = 180;
+    box.H = 16;
+    BGFX_DrawText((i == 0) ? "Brightness" : (i == 1) ? "Sound" : "Network",
+        box, BGFX_ALIGN_LEFT, 0, 0x0000, 0x0000, 2, text);
+    BGFX_TilesFillRoundRect(&Tiles, 240, 60 + 56 * i, 48, 24, 12,
+        (i == 1) ? 0xC618 : 0x2E8B, Display);
+    BGFX_TilesFillCircle(&Tiles, (i == 1) ? 252 : 276, 72 + 56 * i, 9,
+        0xFFFF, Display);
+  }
+}
+
+
+int main(int argc, char *argv[])
+{
+  static uint16_t pool[POOL_TILES * BGFX_TILE_SIZE * BGFX_TILE_SIZE];
+  static uint16_t row[LCD_WIDTH];
+  uint32_t frames = (argc > 1) ? strtoul(argv[1], NULL, 0) : 200;
+  uint32_t gram_size = BGFX_SimGramSize(BGFX_SIM_ILI9341, LCD_WIDTH,
+      LCD_HEIGHT);
+  uint8_t *gram = malloc(gram_size);
+  BGFX_Parameters_t display;
+  BGFX_Rect_t screen = {0, 0, LCD_WIDTH, LCD_HEIGHT};
+  BGFX_Sim_t sim;
+  clock_t start, draw = 0, expand = 0;
+  uint32_t frame, tiles_bytes;
+  void *grid;
+
+  memset(&display, 0, sizeof(display));
+  display.WIDTH = LCD_WIDTH;
+  display.HEIGHT = LCD_HEIGHT;
+  display.ColorScheme = BGFX_16BITS;
+  BGFX_SetRotation(0, &display);
+  grid = malloc(BGFX_TilesGridSize(display));
+  if ((grid == NULL) || (gram == NULL) ||
+      (BGFX_TilesInit(&Tiles, grid, pool, sizeof(pool), 0x0000, display) != 0))
+  {
+    return 1;
+  }
+
+  for (frame = 0; frame < frames; frame++) {
+    start = clock();
+    DrawScreen(display);
+    draw += clock() - start;
+
+    start = clock();
+    BGFX_TilesFlush(&Tiles, screen, row, SendRow, NULL);
+    expand += clock() - start;
+  }
+
+  BGFX_SimInit(&sim, BGFX_SIM_ILI9341, LCD_WIDTH, LCD_HEIGHT, gram,
+      BGFX_SimSpi(40000000));
+  BGFX_SimSetWindow(&sim, screen);
+  BGFX_TilesFlush(&Tiles, screen, row, SendRow, &sim);
+
+  tiles_bytes = BGFX_TilesGridSize(display) +
+      (uint32_t)Tiles.Peak * BGFX_TILE_SIZE * BGFX_TILE_SIZE * 2;
+  printf("%lu frames\n", (unsigned long)frames);
+  printf("  full buffer       %8lu bytes\n",
+      (unsigned long)LCD_WIDTH * LCD_HEIGHT * 2);
+  printf("  tiles             %8lu bytes (%u of %u tiles detailed, "
+      "%lu writes dropped)\n", (unsigned long)tiles_bytes, Tiles.Peak,
+      Tiles.Columns * Tiles.Rows, (unsigned long)Tiles.Dropped);
+  printf("  draw              %8.4f ms CPU per frame\n",
+      1e3 * draw / CLOCKS_PER_SEC / frames);
+  printf("  expand rows       %8.4f ms CPU per frame\n",
+      1e3 * expand / CLOCKS_PER_SEC / frames);
+  printf("  bus               %8.4f ms per frame\n", sim.Stats.TimeNs / 1e6);
+
+  if (BGFX_SimDump(&sim, "tiles.ppm") != 0) {
+    perror("tiles.ppm");
+  }
+  free(grid);
+  free(gram);
+  return 0;
+}
@@ -1,5 +1,6 @@
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #include "basic_graphics.h"
 #include "glcdfont.h"
 
@@ -7,6 +8,10 @@
 #define min(a, b)                                      (((a) < (b)) ? (a) : (b))
 #endif
 
+#ifndef max
+#define max(a, b)                                      (((a) > (b)) ? (a) : (b))
+#endif
+
 #ifndef _swap_int16_t
 #define _swap_int16_t(a, b)                                                    \
     do                                                                         \
@@ -17,6 +22,12 @@
     }while(0);
 #endif
 
+/* What a raster operation does to the bits of a monochromatic pixel */
+#define BGFX_BITS_KEEP    0
+#define BGFX_BITS_SET     1
+#define BGFX_BITS_CLEAR   2
+#define BGFX_BITS_TOGGLE  3
+
 
 
 
@@ -30,6 +41,91 @@ void BGFX_DrawPixel_8(uint16_t x, uint16_t y, uint16_t color,
 void BGFX_DrawPixel_16(uint16_t x, uint16_t y, uint16_t color,
     BGFX_Parameters_t Display);
 
+static uint16_t BGFX_GetPixel_01(uint16_t x, uint16_t y,
+    BGFX_Parameters_t Display);
+
+static int16_t BGFX_ClipRun(int16_t *Start, int16_t Length, int16_t Min,
+    int16_t Max);
+
+static uint8_t BGFX_Outside(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    BGFX_Parameters_t Display);
+
+static int32_t BGFX_Locate(int16_t x, int16_t y, int32_t *StepX,
+    int32_t *StepY, BGFX_Parameters_t Display);
+
+static uint8_t BGFX_IsDirect(BGFX_Parameters_t Display);
+
+static void BGFX_PointClipped(int16_t x, int16_t y, uint16_t color,
+    BGFX_Rect_t Clip, BGFX_Parameters_t Display);
+
+static void BGFX_FillClipped(int16_t x, int16_t y, int16_t w, int16_t h,
+    uint16_t color, BGFX_Rect_t Clip, BGFX_Parameters_t Display);
+
+static void BGFX_RectClipped(int16_t x, int16_t y, uint16_t w,
+    uint16_t h, uint16_t color, BGFX_Rect_t Clip, BGFX_Parameters_t Display);
+
+static void BGFX_LineClipped(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    uint16_t color, BGFX_Rect_t Clip, BGFX_Parameters_t Display);
+
+static void BGFX_LineRuns(int16_t x0, int16_t y0, int16_t x1, int16_t dx,
+    int16_t dy, int16_t ystep, int16_t steep, uint16_t color,
+    BGFX_Rect_t Clip, BGFX_Parameters_t Display);
+
+static uint8_t BGFX_LineRow(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t y, int16_t *Start, int16_t *End);
+
+static void BGFX_FillRun(int32_t Index, int32_t Step, int16_t Count,
+    uint16_t color, BGFX_Parameters_t Display);
+
+static void BGFX_FillBlock(int32_t Index, int32_t Step, int16_t Count,
+    int32_t Next, int16_t Runs, uint16_t color, BGFX_Parameters_t Display);
+
+static void BGFX_RopRun(int32_t Index, int32_t Step, int16_t Count,
+    uint16_t color, BGFX_Parameters_t Display);
+
+static void BGFX_BitsRun(int32_t Index, int32_t Step, int16_t Count,
+    uint32_t Bits, uint8_t Length, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display);
+
+static void BGFX_BitsRun01(int32_t Index, int32_t Step, int16_t Count,
+    uint64_t Wide, uint8_t Length, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display);
+
+static uint8_t BGFX_IsDirect01(BGFX_Parameters_t Display);
+
+static void BGFX_FillRect01(int16_t x, int16_t y, int16_t w, int16_t h,
+    uint16_t color, BGFX_Parameters_t Display);
+
+static void BGFX_MaskRun01(uint8_t *Ptr, int32_t Count, uint8_t Mask,
+    uint8_t Action);
+
+static void BGFX_CopyBits01(uint8_t *Buffer, uint16_t Stride, int32_t SrcA,
+    int32_t DstA, int32_t CountA, int32_t SrcB, int32_t DstB, int32_t CountB);
+
+static uint8_t BGFX_Rop01(uint16_t color, BGFX_RasterOp_t RasterOp);
+
+static uint16_t BGFX_Rop(uint16_t Dst, uint16_t color,
+    BGFX_RasterOp_t RasterOp);
+
+static uint64_t BGFX_RopWord(uint64_t Dst, uint64_t Wide,
+    BGFX_RasterOp_t RasterOp);
+
+static const uint16_t *BGFX_CircleLookup(int16_t r, uint16_t *Steps,
+    BGFX_Parameters_t Display);
+
+static void BGFX_CircleBuild(uint16_t *Table, int16_t r, uint16_t *Steps);
+
+static void BGFX_CircleRuns(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t r, const uint16_t *Ys, uint16_t Steps, uint16_t color,
+    BGFX_Parameters_t Display);
+
+static void BGFX_CirclePoints(int16_t x0, int16_t y0, int16_t x, int16_t y,
+    uint8_t Corners, uint16_t color, BGFX_Parameters_t Display);
+
+static void BGFX_CircleRows(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t r, const uint16_t *Widths, uint16_t color,
+    BGFX_Parameters_t Display);
+
 void BGFX_DrawCircleHelper(uint16_t x0, uint16_t y0, uint16_t r,
     uint8_t cornername, uint16_t color, BGFX_Parameters_t Display);
 
@@ -62,6 +158,13 @@ void BGFX_DrawPixel(uint16_t x, uint16_t y, uint16_t color,
   {
     return;
   }
+  if (((Display.Clip.W > 0) && (Display.Clip.H > 0)) ||
+      (Display.BandHeight > 0))
+  {
+    if (BGFX_Outside(x, y, x, y, Display)) {
+      return;
+    }
+  }
 
   /* Applying rotation */
   switch (Display.Rotation) {
@@ -86,12 +189,16 @@ void BGFX_DrawPixel(uint16_t x, uint16_t y, uint16_t color,
     Display.DrawPixel(x, y, color);
   }else if(Display.Buffer != NULL){
 
+    /* The buffer may only hold a band of rows */
+    y -= Display.BandY;
+
     /* Using one of the default functions */
     switch(Display.ColorScheme){
     case BGFX_MONOCHROMATIC:
       BGFX_DrawPixel_01(x, y, color, Display);
       break;
     case BGFX_8BITS:
+    case BGFX_INDEXED8:
       BGFX_DrawPixel_8(x, y, color, Display);
       break;
     case BGFX_16BITS:
@@ -113,57 +220,258 @@ void BGFX_DrawPixel(uint16_t x, uint16_t y, uint16_t color,
 void BGFX_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
     uint16_t color, BGFX_Parameters_t Display)
 {
-  int16_t steep;
-  int16_t dx, dy, err, ystep;
+  BGFX_SetRotation(Display.Rotation, &Display);
+  BGFX_LineClipped(x0, y0, x1, y1, color, BGFX_GetClip(Display), Display);
+}
 
-  steep = abs(y1 - y0) > abs(x1 - x0);
 
-  if (steep) {
-    _swap_int16_t(x0, y0);
-    _swap_int16_t(x1, y1);
+
+
+
+void BGFX_DrawHLine(int16_t x, int16_t y, int16_t w, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_SetRotation(Display.Rotation, &Display);
+  BGFX_FillClipped(x, y, w, 1, color, BGFX_GetClip(Display), Display);
+}
+
+
+
+
+void BGFX_DrawVLine(int16_t x, int16_t y, int16_t h, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_SetRotation(Display.Rotation, &Display);
+  BGFX_FillClipped(x, y, 1, h, color, BGFX_GetClip(Display), Display);
+}
+
+
+
+
+void BGFX_WriteSpan(int16_t x, int16_t y, int16_t w, const uint16_t *Colors,
+    BGFX_Parameters_t Display)
+{
+  int32_t index, step_x, step_y;
+  int16_t x_start = x;
+  int16_t i;
+  BGFX_Rect_t clip;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+  if ((y < clip.Y) || (y >= clip.Y + clip.H)) {
+    return;
+  }
+  w = BGFX_ClipRun(&x, w, clip.X, clip.X + clip.W);
+  if (w <= 0) {
+    return;
   }
+  Colors += x - x_start;
 
-  if (x0 > x1) {
-    _swap_int16_t(x0, x1);
-    _swap_int16_t(y0, y1);
+  if (!BGFX_IsDirect(Display)) {
+    for (i = 0; i < w; i++) {
+      BGFX_DrawPixel(x + i, y, Colors[i], Display);
+    }
+    return;
   }
 
-  dx = x1 - x0;
-  dy = abs(y1 - y0);
+  index = BGFX_Locate(x, y, &step_x, &step_y, Display);
+  if (Display.ColorScheme == BGFX_16BITS) {
+    uint16_t *p = (uint16_t *)Display.Buffer + index;
+    if (Display.RasterOp != BGFX_ROP_COPY) {
+      for (i = 0; i < w; i++, p += step_x) {
+        *p = BGFX_Rop(*p, Colors[i], Display.RasterOp);
+      }
+    } else if (step_x == 1) {
+      memcpy(p, Colors, w * sizeof(uint16_t));
+    } else {
+      for (i = 0; i < w; i++, p += step_x) {
+        *p = Colors[i];
+      }
+    }
+  } else {
+    uint8_t *p = (uint8_t *)Display.Buffer + index;
+    for (i = 0; i < w; i++, p += step_x) {
+      *p = BGFX_Rop(*p, Colors[i], Display.RasterOp) & 0xFF;
+    }
+  }
+}
 
-  err = dx / 2;
 
-  if (y0 < y1) {
-    ystep = 1;
-  } else {
-    ystep = -1;
+
+
+void BGFX_DrawHLineBits(int16_t x, int16_t y, int16_t w, uint32_t Bits,
+    uint8_t Length, uint16_t color, uint16_t bg, BGFX_Parameters_t Display)
+{
+  int32_t index, step_x, step_y;
+  int16_t x_start = x;
+  uint8_t phase;
+  BGFX_Rect_t clip;
+
+  if ((Length == 0) || (Length > 32)) {
+    return;
+  }
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+  if ((y < clip.Y) || (y >= clip.Y + clip.H)) {
+    return;
+  }
+  w = BGFX_ClipRun(&x, w, clip.X, clip.X + clip.W);
+  if (w <= 0) {
+    return;
   }
 
-  for (; x0 <= x1; x0++) {
-    if (steep) {
-      BGFX_DrawPixel(y0, x0, color, Display);
-    } else {
-      BGFX_DrawPixel(x0, y0, color, Display);
+  /* Mask of the first pixel left after clipping */
+  Bits &= 0xFFFFFFFFUL >> (32 - Length);
+  phase = (x - x_start) % Length;
+  if (phase > 0) {
+    Bits = (uint32_t)((((uint64_t)Bits << Length) | Bits) >> phase);
+  }
+
+  if (!BGFX_IsDirect(Display) && !BGFX_IsDirect01(Display)) {
+    for (phase = 0; w > 0; w--, x++) {
+      if ((Bits >> phase) & 1) {
+        BGFX_DrawPixel(x, y, color, Display);
+      } else if (bg != color) {
+        BGFX_DrawPixel(x, y, bg, Display);
+      }
+      phase = (phase + 1 < Length) ? phase + 1 : 0;
     }
-    err -= dy;
-    if (err < 0) {
-      y0 += ystep;
-      err += dx;
+    return;
+  }
+
+  index = BGFX_Locate(x, y, &step_x, &step_y, Display);
+  BGFX_BitsRun(index, step_x, w, Bits, Length, color, bg, Display);
+}
+
+
+
+
+void BGFX_DrawVLineBits(int16_t x, int16_t y, int16_t h, uint32_t Bits,
+    uint8_t Length, uint16_t color, uint16_t bg, BGFX_Parameters_t Display)
+{
+  int32_t index, step_x, step_y;
+  int16_t y_start = y;
+  uint8_t phase;
+  BGFX_Rect_t clip;
+
+  if ((Length == 0) || (Length > 32)) {
+    return;
+  }
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+  if ((x < clip.X) || (x >= clip.X + clip.W)) {
+    return;
+  }
+  h = BGFX_ClipRun(&y, h, clip.Y, clip.Y + clip.H);
+  if (h <= 0) {
+    return;
+  }
+
+  Bits &= 0xFFFFFFFFUL >> (32 - Length);
+  phase = (y - y_start) % Length;
+  if (phase > 0) {
+    Bits = (uint32_t)((((uint64_t)Bits << Length) | Bits) >> phase);
+  }
+
+  if (!BGFX_IsDirect(Display) && !BGFX_IsDirect01(Display)) {
+    for (phase = 0; h > 0; h--, y++) {
+      if ((Bits >> phase) & 1) {
+        BGFX_DrawPixel(x, y, color, Display);
+      } else if (bg != color) {
+        BGFX_DrawPixel(x, y, bg, Display);
+      }
+      phase = (phase + 1 < Length) ? phase + 1 : 0;
     }
+    return;
   }
+
+  index = BGFX_Locate(x, y, &step_x, &step_y, Display);
+  BGFX_BitsRun(index, step_y, h, Bits, Length, color, bg, Display);
 }
 
 
 
 
+void BGFX_CopyArea(BGFX_Rect_t Src, int16_t x, int16_t y,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Parameters_t whole = Display;
+  BGFX_Rect_t dst;
+  int32_t step_x, step_y, i0, i1, s0, d0;
+  int16_t dx = x - Src.X, dy = y - Src.Y;
+  int16_t sx, sy, tx, ty, w, h, row;
+  uint8_t bytes, *buffer = (uint8_t *)Display.Buffer;
+
+  if ((Display.DrawPixel != NULL) || (Display.Buffer == NULL)) {
+    return;
+  }
+  BGFX_SetRotation(Display.Rotation, &Display);
+
+  /* Destination clipped to the drawable area, source to the pixels the
+   * buffer holds */
+  dst = Src;
+  dst.X += dx;
+  dst.Y += dy;
+  BGFX_RectIntersect(&dst, BGFX_GetClip(Display));
+  Src = dst;
+  Src.X -= dx;
+  Src.Y -= dy;
+  whole.Clip.W = 0;
+  BGFX_RectIntersect(&Src, BGFX_GetClip(whole));
+  if ((Src.W <= 0) || (Src.H <= 0)) {
+    return;
+  }
+
+  /* Rotation only turns the rectangles, the copy is done in unrotated
+   * buffer coordinates, rows counted from the band */
+  i0 = BGFX_Locate(Src.X, Src.Y, &step_x, &step_y, Display);
+  i1 = BGFX_Locate(Src.X + Src.W - 1, Src.Y + Src.H - 1, &step_x, &step_y,
+      Display);
+  sx = min(i0 % Display.WIDTH, i1 % Display.WIDTH);
+  sy = min(i0 / Display.WIDTH, i1 / Display.WIDTH);
+  w = abs(i0 % Display.WIDTH - i1 % Display.WIDTH) + 1;
+  h = abs(i0 / Display.WIDTH - i1 / Display.WIDTH) + 1;
+  i0 = BGFX_Locate(Src.X + dx, Src.Y + dy, &step_x, &step_y, Display);
+  i1 = BGFX_Locate(Src.X + dx + Src.W - 1, Src.Y + dy + Src.H - 1, &step_x,
+      &step_y, Display);
+  tx = min(i0 % Display.WIDTH, i1 % Display.WIDTH);
+  ty = min(i0 / Display.WIDTH, i1 / Display.WIDTH);
+
+  switch (Display.ColorScheme) {
+  case BGFX_MONOCHROMATIC:
+    if (Display.HeightPixelsOnWrite > 1 && Display.WidthPixelsOnWrite == 1) {
+      BGFX_CopyBits01(buffer, Display.WIDTH, sy, ty, h, sx, tx, w);
+    } else {
+      BGFX_CopyBits01(buffer, Display.WIDTH, sx, tx, w, sy, ty, h);
+    }
+    return;
+  case BGFX_16BITS:
+    bytes = 2;
+    break;
+  default:
+    bytes = 1;
+    break;
+  }
+
+  /* Rows in the order that reads every source row before it is
+   * overwritten, memmove takes care of the overlap within a row */
+  for (row = 0; row < h; row++) {
+    s0 = (ty > sy) ? sy + h - 1 - row : sy + row;
+    d0 = s0 + ty - sy;
+    memmove(buffer + ((int32_t)d0 * Display.WIDTH + tx) * bytes,
+        buffer + ((int32_t)s0 * Display.WIDTH + sx) * bytes,
+        (uint32_t)w * bytes);
+  }
+}
+
+
+
 
 void BGFX_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
     uint16_t color, BGFX_Parameters_t Display)
 {
-  BGFX_DrawLine(x        , y        , x + w - 1, y        , color, Display);
-  BGFX_DrawLine(x + w - 1, y        , x + w - 1, y + h - 1, color, Display);
-  BGFX_DrawLine(x + w - 1, y + h - 1, x        , y + h - 1, color, Display);
-  BGFX_DrawLine(x        , y + h - 1, x        , y        , color, Display);
+  BGFX_SetRotation(Display.Rotation, &Display);
+  BGFX_RectClipped(x, y, w, h, color, BGFX_GetClip(Display), Display);
 }
 
 
@@ -175,9 +483,116 @@ void BGFX_DrawRect(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
 void BGFX_DrawRectFill(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
     uint16_t color, BGFX_Parameters_t Display)
 {
+  BGFX_SetRotation(Display.Rotation, &Display);
+  BGFX_FillClipped(x, y, w, h, color, BGFX_GetClip(Display), Display);
+}
+
+
+
+
+void BGFX_DrawPoints(const int16_t *Points, uint16_t Count, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  int32_t origin, index, step_x, step_y;
+  int16_t x, y;
+  BGFX_Rect_t clip;
+  uint16_t i;
+
+  if (Points == NULL) {
+    return;
+  }
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+
+  if (!BGFX_IsDirect(Display)) {
+    for (i = 0; i < Count; i++, Points += 2) {
+      BGFX_PointClipped(Points[0], Points[1], color, clip, Display);
+    }
+    return;
+  }
+
+  /* The buffer index is linear in x and y (see BGFX_Locate), one multiply
+   * and add per point */
+  origin = BGFX_Locate(0, 0, &step_x, &step_y, Display);
+  for (i = 0; i < Count; i++, Points += 2) {
+    x = Points[0];
+    y = Points[1];
+    if ((x < clip.X) || (y < clip.Y) || (x >= clip.X + clip.W) ||
+        (y >= clip.Y + clip.H))
+    {
+      continue;
+    }
+    index = origin + x * step_x + y * step_y;
+    if (Display.ColorScheme == BGFX_16BITS) {
+      uint16_t *p = (uint16_t *)Display.Buffer + index;
+      *p = BGFX_Rop(*p, color, Display.RasterOp);
+    } else {
+      uint8_t *p = (uint8_t *)Display.Buffer + index;
+      *p = BGFX_Rop(*p, color, Display.RasterOp) & 0xFF;
+    }
+  }
+}
+
+
+
+
+void BGFX_DrawLines(const int16_t *Lines, uint16_t Count, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip;
+  uint16_t i;
+
+  if (Lines == NULL) {
+    return;
+  }
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+
+  for (i = 0; i < Count; i++, Lines += 4) {
+    BGFX_LineClipped(Lines[0], Lines[1], Lines[2], Lines[3], color, clip,
+        Display);
+  }
+}
+
+
+
+
+void BGFX_FillRects(const BGFX_Rect_t *Rects, uint16_t Count, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip;
+  uint16_t i;
+
+  if (Rects == NULL) {
+    return;
+  }
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+
+  for (i = 0; i < Count; i++) {
+    BGFX_FillClipped(Rects[i].X, Rects[i].Y, Rects[i].W, Rects[i].H, color,
+        clip, Display);
+  }
+}
+
+
+
+
+void BGFX_DrawRects(const BGFX_Rect_t *Rects, uint16_t Count, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip;
   uint16_t i;
-  for (i = x; i < x + w; i++) {
-    BGFX_DrawLine(i, y, i, y + h - 1, color, Display);
+
+  if (Rects == NULL) {
+    return;
+  }
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+
+  for (i = 0; i < Count; i++) {
+    BGFX_RectClipped(Rects[i].X, Rects[i].Y, Rects[i].W, Rects[i].H, color,
+        clip, Display);
   }
 }
 
@@ -187,22 +602,44 @@ void BGFX_DrawRectFill(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
 void BGFX_DrawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
     int16_t r, uint16_t color, BGFX_Parameters_t Display)
 {
+  const uint16_t *table = NULL;
+  uint16_t steps;
   int16_t max_radius;
 
+  if (BGFX_Outside(x, y, x + w - 1, y + h - 1, Display)) {
+    return;
+  }
+
   max_radius = ((w < h) ? w : h) / 2; /* 1/2 minor axiss */
   if (r > max_radius){
     r = max_radius;
   }
-  /* smarter version */
+  if (r <= 0) {
+    BGFX_DrawRect(x, y, w, h, color, Display);
+    return;
+  }
+  /* Sides between the corner centers, the corners draw the rest: each
+   * pixel once, for raster operations */
   /* Top */
-  BGFX_DrawLine(x + r, y        , x - r + w, y        , color, Display);
+  BGFX_DrawHLine(x + r, y, w - 2 * r, color, Display);
   /* Bottom */
-  BGFX_DrawLine(x + r, y + h - 1, x - r + w, y + h - 1, color, Display);
+  BGFX_DrawHLine(x + r, y + h - 1, w - 2 * r, color, Display);
   /* Left */
-  BGFX_DrawLine(x        , y + r, x        , y + h - r, color, Display);
+  BGFX_DrawVLine(x, y + r, h - 2 * r, color, Display);
   /* Right */
-  BGFX_DrawLine(x + w - 1, y + r, x + w - 1, y + h - r, color, Display);
-  /* draw four corners */
+  BGFX_DrawVLine(x + w - 1, y + r, h - 2 * r, color, Display);
+  /* draw four corners, at radius 1 the ends of the sides */
+  if (r == 1) {
+    return;
+  }
+  if (BGFX_IsDirect(Display)) {
+    table = BGFX_CircleLookup(r, &steps, Display);
+  }
+  if (table != NULL) {
+    BGFX_CircleRuns(x + r, y + r, x + w - r - 1, y + h - r - 1, r,
+        table + r + 1, steps, color, Display);
+    return;
+  }
   BGFX_DrawCircleHelper(x + r, y + r, r, 1, color, Display);
   BGFX_DrawCircleHelper(x + w - r - 1, y + r, r, 2, color, Display);
   BGFX_DrawCircleHelper(x + w - r - 1, y + h - r - 1, r, 4, color, Display);
@@ -214,12 +651,27 @@ void BGFX_DrawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
 
 void BGFX_DrawRoundRectFill(int16_t x, int16_t y, int16_t w, int16_t h,
     int16_t r, uint16_t color, BGFX_Parameters_t Display) {
+  const uint16_t *widths;
+  uint16_t steps;
   int16_t max_radius;
 
+  if (BGFX_Outside(x, y, x + w - 1, y + h - 1, Display)) {
+    return;
+  }
+
   max_radius = ((w < h) ? w : h) / 2; // 1/2 minor axis
   if (r > max_radius){
     r = max_radius;
   }
+  if (r < 0) {
+    r = 0;
+  }
+  widths = BGFX_CircleLookup(r, &steps, Display);
+  if (widths != NULL) {
+    BGFX_CircleRows(x + r, y + r, x + w - r - 1, y + h - r - 1, r, widths,
+        color, Display);
+    return;
+  }
   /* smarter version */
   BGFX_DrawRectFill(x + r, y, w - 2 * r, h, color, Display);
   /* draw four corners */
@@ -240,12 +692,33 @@ void BGFX_DrawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color,
   int16_t ddF_y = -2 * r;
   uint16_t x = 0;
   uint16_t y = r;
+  const uint16_t *table = NULL;
+  uint16_t steps;
+
+  if (BGFX_Outside((int16_t)x0 - r, (int16_t)y0 - r, (int16_t)x0 + r,
+      (int16_t)y0 + r, Display)) {
+    return;
+  }
 
+  if (r == 0) {
+    BGFX_DrawPixel(x0, y0, color, Display);
+    return;
+  }
   BGFX_DrawPixel(x0, y0 + r, color, Display);
   BGFX_DrawPixel(x0, y0 - r, color, Display);
   BGFX_DrawPixel(x0 + r, y0, color, Display);
   BGFX_DrawPixel(x0 - r, y0, color, Display);
 
+  /* Outlines drawn pixel by pixel gain nothing from the tables */
+  if (BGFX_IsDirect(Display)) {
+    table = BGFX_CircleLookup(r, &steps, Display);
+  }
+  if (table != NULL) {
+    BGFX_CircleRuns(x0, y0, x0, y0, r, table + r + 1, steps, color,
+        Display);
+    return;
+  }
+
   while (x < y) {
     if (f >= 0) {
       y--;
@@ -256,14 +729,7 @@ void BGFX_DrawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color,
     ddF_x += 2;
     f += ddF_x;
 
-    BGFX_DrawPixel(x0 + x, y0 + y, color,  Display);
-    BGFX_DrawPixel(x0 - x, y0 + y, color,  Display);
-    BGFX_DrawPixel(x0 + x, y0 - y, color,  Display);
-    BGFX_DrawPixel(x0 - x, y0 - y, color,  Display);
-    BGFX_DrawPixel(x0 + y, y0 + x, color,  Display);
-    BGFX_DrawPixel(x0 - y, y0 + x, color,  Display);
-    BGFX_DrawPixel(x0 + y, y0 - x, color,  Display);
-    BGFX_DrawPixel(x0 - y, y0 - x, color,  Display);
+    BGFX_CirclePoints(x0, y0, x, y, 0xF, color, Display);
   }
 }
 
@@ -273,6 +739,20 @@ void BGFX_DrawCircle(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color,
 void BGFX_DrawCircleFill(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color,
     BGFX_Parameters_t Display)
 {
+  const uint16_t *widths;
+  uint16_t steps;
+
+  if (BGFX_Outside((int16_t)x0 - r, (int16_t)y0 - r, (int16_t)x0 + r,
+      (int16_t)y0 + r, Display)) {
+    return;
+  }
+
+  widths = BGFX_CircleLookup(r, &steps, Display);
+  if (widths != NULL) {
+    BGFX_CircleRows(x0, y0, x0, y0, r, widths, color, Display);
+    return;
+  }
+
   BGFX_DrawLine(x0, y0 - r, x0, y0 + r, color, Display);
   BGFX_DrawCircleFillHelper(x0, y0, r, 3, 0, color, Display);
 }
@@ -284,9 +764,46 @@ void BGFX_DrawCircleFill(uint16_t x0, uint16_t y0, uint16_t r, uint16_t color,
 
 void BGFX_DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
     int16_t x2, int16_t y2, uint16_t color, BGFX_Parameters_t Display) {
-  BGFX_DrawLine(x0, y0, x1, y1, color, Display);
-  BGFX_DrawLine(x1, y1, x2, y2, color, Display);
-  BGFX_DrawLine(x2, y2, x0, y0, color, Display);
+  int16_t start[3], end[3];
+  int16_t y, top, bottom, n, i, j;
+  BGFX_Rect_t clip;
+
+  if ((Display.RasterOp != BGFX_ROP_XOR) &&
+      (Display.RasterOp != BGFX_ROP_INVERT)) {
+    BGFX_DrawLine(x0, y0, x1, y1, color, Display);
+    BGFX_DrawLine(x1, y1, x2, y2, color, Display);
+    BGFX_DrawLine(x2, y2, x0, y0, color, Display);
+    return;
+  }
+
+  /* The sides share their ends, and more pixels at sharp angles: row by
+   * row, the runs of the three lines are merged and each pixel drawn once */
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+  top = max(min(min(y0, y1), y2), clip.Y);
+  bottom = min(max(max(y0, y1), y2), clip.Y + clip.H - 1);
+  for (y = top; y <= bottom; y++) {
+    n = 0;
+    n += BGFX_LineRow(x0, y0, x1, y1, y, &start[n], &end[n]);
+    n += BGFX_LineRow(x1, y1, x2, y2, y, &start[n], &end[n]);
+    n += BGFX_LineRow(x2, y2, x0, y0, y, &start[n], &end[n]);
+    /* Sorted by start, then drawn with the overlaps removed */
+    for (i = 1; i < n; i++) {
+      for (j = i; (j > 0) && (start[j] < start[j - 1]); j--) {
+        _swap_int16_t(start[j], start[j - 1]);
+        _swap_int16_t(end[j], end[j - 1]);
+      }
+    }
+    for (i = 0; i < n; i++) {
+      if ((i + 1 < n) && (start[i + 1] <= end[i] + 1)) {
+        start[i + 1] = start[i];
+        end[i + 1] = max(end[i], end[i + 1]);
+        continue;
+      }
+      BGFX_FillClipped(start[i], y, end[i] - start[i] + 1, 1, color, clip,
+          Display);
+    }
+  }
 }
 
 
@@ -314,6 +831,11 @@ void BGFX_DrawTriangleFill(uint16_t x0, uint16_t y0, uint16_t x1,
     _swap_int16_t(x0, x1);
   }
 
+  if (BGFX_Outside(min(min((int16_t)x0, (int16_t)x1), (int16_t)x2), y0,
+      max(max((int16_t)x0, (int16_t)x1), (int16_t)x2), y2, Display)) {
+    return;
+  }
+
   if (y0 == y2) { /* Handle awkward all-on-same-line case as its own thing */
     a = b = x0;
     if (x1 < a){
@@ -326,7 +848,7 @@ void BGFX_DrawTriangleFill(uint16_t x0, uint16_t y0, uint16_t x1,
     }else if (x2 > b){
       b = x2;
     }
-    BGFX_DrawLine(a, y0, a + b - a + 1, y0,color, Display);
+    BGFX_DrawHLine(a, y0, b - a + 1, color, Display);
     return;
   }
 
@@ -360,8 +882,7 @@ void BGFX_DrawTriangleFill(uint16_t x0, uint16_t y0, uint16_t x1,
     if (a > b){
       _swap_int16_t(a, b);
     }
-    BGFX_DrawLine(a, y, a + b - a + 1, y,color, Display);
-    /* writeFastHLine(a, y, b - a + 1, color); */
+    BGFX_DrawHLine(a, y, b - a + 1, color, Display);
   }
 
   /* For lower part of triangle, find scanline crossings for segments
@@ -381,7 +902,7 @@ void BGFX_DrawTriangleFill(uint16_t x0, uint16_t y0, uint16_t x1,
     if (a > b){
       _swap_int16_t(a, b);
     }
-    BGFX_DrawLine(a, y, a + b - a + 1, y,color, Display);
+    BGFX_DrawHLine(a, y, b - a + 1, color, Display);
   }
 }
 
@@ -403,80 +924,1724 @@ void BGFX_DrawChar(uint16_t x, uint16_t y, uint8_t c, uint16_t color,
     {
       return;
     }
+    if (BGFX_Outside(x, y, x + 6 * size_x - 1, y + 8 * size_y - 1, Display)) {
+      return;
+    }
+
+    if (!Display.Cp437 && (c >= 176)){
+      c++; /* Handle 'classic' charset behavior */
+    }
+
+
+    for (int8_t i = 0; i < 5; i++) { /* Char bitmap = 5 columns */
+      uint8_t line = glcdfont[c * 5 + i];
+      for (int8_t j = 0; j < 8; j++, line >>= 1) {
+        if (line & 1) {
+          if (size_x == 1 && size_y == 1){
+            BGFX_DrawPixel(x + i, y + j, color, Display);
+          }else{
+            BGFX_DrawRectFill(x + i * size_x, y + j * size_y, size_x, size_y,
+                color, Display);
+          }
+        } else if (bg != color) {
+          if (size_x == 1 && size_y == 1){
+            BGFX_DrawPixel(x + i, y + j, bg, Display);
+          }else{
+            BGFX_DrawRectFill(x + i * size_x, y + j * size_y, size_x, size_y,
+                bg, Display);
+          }
+        }
+      }
+    }
+    if (bg != color) { /* If opaque, draw vertical line for last column */
+      if (size_x == 1 && size_y == 1){
+        BGFX_DrawVLine(x + 5, y, 8, bg, Display);
+      }else{
+        BGFX_DrawRectFill(x + 5 * size_x, y, size_x, 8 * size_y, bg, Display);
+      }
+    }
+
+  }
+}
+
+
+
+
+void BGFX_SendString(uint16_t X, uint16_t Y, uint8_t *Buffer, uint32_t Length,
+    uint16_t Color, uint16_t Bgc, uint8_t SizeX, uint8_t SizeY,
+    BGFX_Parameters_t Display)
+{
+  uint32_t i;
+
+  if (Display.GfxFont == NULL) {
+    for(i = 0; i< Length; i++){
+      BGFX_DrawChar(X, Y, *(Buffer + i), Color, Bgc, SizeX,
+          SizeY, Display);
+      X += SizeX * 6; /* Advance x one char */
+    }
+  }
+}
+
+
+
+
+
+
+void BGFX_SetRotation(uint8_t Rotation, BGFX_Parameters_t *Display)
+{
+  Display->Rotation = (Rotation & 3);
+  switch (Display->Rotation) {
+  case 0:
+  case 2:
+    Display->Width = Display->WIDTH;
+    Display->Height = Display->HEIGHT;
+    break;
+  case 1:
+  case 3:
+    Display->Width = Display->HEIGHT;
+    Display->Height = Display->WIDTH;
+    break;
+  }
+}
+
+
+uint16_t BGFX_GetPixel(uint16_t x, uint16_t y, BGFX_Parameters_t Display)
+{
+  uint16_t t;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+
+  /* Testing if point is out of border */
+  if ((x >= Display.Width) || (y >= Display.Height) || (Display.Buffer == NULL))
+  {
+    return 0;
+  }
+
+  /* Applying rotation */
+  switch (Display.Rotation) {
+  case 1:
+    t = x;
+    x = Display.WIDTH - 1 - y;
+    y = t;
+    break;
+  case 2:
+    x = Display.WIDTH - 1 - x;
+    y = Display.HEIGHT - 1 - y;
+    break;
+  case 3:
+    t = x;
+    x = y;
+    y = Display.HEIGHT - 1 - t;
+    break;
+  }
+
+  /* The buffer may only hold a band of rows */
+  if (Display.BandHeight > 0) {
+    if ((y < Display.BandY) || (y >= Display.BandY + Display.BandHeight)) {
+      return 0;
+    }
+    y -= Display.BandY;
+  }
+
+  switch(Display.ColorScheme){
+  case BGFX_8BITS:
+  case BGFX_INDEXED8:
+    return ((uint8_t *)Display.Buffer)[x + y * Display.WIDTH];
+  case BGFX_16BITS:
+    return ((uint16_t *)Display.Buffer)[x + y * Display.WIDTH];
+  default:
+    return BGFX_GetPixel_01(x, y, Display);
+  }
+}
+
+
+
+
+uint32_t BGFX_GetBufferSize(BGFX_Parameters_t Display)
+{
+  switch(Display.ColorScheme){
+  case BGFX_MONOCHROMATIC:
+    if(Display.HeightPixelsOnWrite > 1 && Display.WidthPixelsOnWrite == 1)
+    {
+      /* Pages of 8 vertical pixels, WIDTH bytes per page */
+      return (uint32_t)((Display.HEIGHT + 7) / 8) * Display.WIDTH;
+    }
+    /* Columns of 8 horizontal pixels, see BGFX_DrawPixel_01 addressing */
+    return (uint32_t)((Display.WIDTH + 7) / 8 - 1) * Display.WIDTH +
+        Display.HEIGHT;
+  case BGFX_8BITS:
+  case BGFX_INDEXED8:
+    return (uint32_t)Display.WIDTH * Display.HEIGHT;
+  case BGFX_16BITS:
+    return (uint32_t)Display.WIDTH * Display.HEIGHT * sizeof(uint16_t);
+  default:
+    return 0;
+  }
+}
+
+
+
+
+void BGFX_RectUnion(BGFX_Rect_t *Dst, BGFX_Rect_t Src)
+{
+  int16_t x1, y1;
+
+  if ((Src.W <= 0) || (Src.H <= 0)) {
+    return;
+  }
+  if ((Dst->W <= 0) || (Dst->H <= 0)) {
+    *Dst = Src;
+    return;
+  }
+
+  x1 = (Dst->X + Dst->W > Src.X + Src.W) ? Dst->X + Dst->W : Src.X + Src.W;
+  y1 = (Dst->Y + Dst->H > Src.Y + Src.H) ? Dst->Y + Dst->H : Src.Y + Src.H;
+  Dst->X = (Dst->X < Src.X) ? Dst->X : Src.X;
+  Dst->Y = (Dst->Y < Src.Y) ? Dst->Y : Src.Y;
+  Dst->W = x1 - Dst->X;
+  Dst->H = y1 - Dst->Y;
+}
+
+
+
+
+void BGFX_RectIntersect(BGFX_Rect_t *Dst, BGFX_Rect_t Src)
+{
+  int16_t x1, y1;
+
+  x1 = (Dst->X + Dst->W < Src.X + Src.W) ? Dst->X + Dst->W : Src.X + Src.W;
+  y1 = (Dst->Y + Dst->H < Src.Y + Src.H) ? Dst->Y + Dst->H : Src.Y + Src.H;
+  Dst->X = (Dst->X > Src.X) ? Dst->X : Src.X;
+  Dst->Y = (Dst->Y > Src.Y) ? Dst->Y : Src.Y;
+  Dst->W = (x1 > Dst->X) ? x1 - Dst->X : 0;
+  Dst->H = (y1 > Dst->Y) ? y1 - Dst->Y : 0;
+}
+
+
+
+
+BGFX_Rect_t BGFX_RectToBuffer(BGFX_Rect_t Rect, BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t r = {0, 0, 0, 0};
+  int32_t step_x, step_y, i0, i1;
+  int16_t x0, y0, x1, y1;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  Rect.W = BGFX_ClipRun(&Rect.X, Rect.W, 0, Display.Width);
+  Rect.H = BGFX_ClipRun(&Rect.Y, Rect.H, 0, Display.Height);
+  if ((Rect.W <= 0) || (Rect.H <= 0)) {
+    return r;
+  }
+  Display.BandY = 0;
+
+  /* Opposite corners, see BGFX_Locate */
+  i0 = BGFX_Locate(Rect.X, Rect.Y, &step_x, &step_y, Display);
+  i1 = BGFX_Locate(Rect.X + Rect.W - 1, Rect.Y + Rect.H - 1, &step_x,
+      &step_y, Display);
+  x0 = i0 % Display.WIDTH;
+  y0 = i0 / Display.WIDTH;
+  x1 = i1 % Display.WIDTH;
+  y1 = i1 / Display.WIDTH;
+
+  r.X = (x0 < x1) ? x0 : x1;
+  r.Y = (y0 < y1) ? y0 : y1;
+  r.W = ((x0 < x1) ? x1 - x0 : x0 - x1) + 1;
+  r.H = ((y0 < y1) ? y1 - y0 : y0 - y1) + 1;
+  return r;
+}
+
+
+
+
+void BGFX_SetPalette(const void *Palette, BGFX_PaletteFormat_t Format,
+    BGFX_Parameters_t *Display)
+{
+  Display->Palette = Palette;
+  Display->PaletteFormat = Format;
+}
+
+
+
+
+void BGFX_SetRasterOp(BGFX_RasterOp_t RasterOp, BGFX_Parameters_t *Display)
+{
+  Display->RasterOp = RasterOp;
+}
+
+
+
+
+void BGFX_SetClip(BGFX_Rect_t Clip, BGFX_Parameters_t *Display)
+{
+  Display->Clip = Clip;
+}
+
+
+
+
+void BGFX_CircleCacheInit(BGFX_CircleCache_t *Cache, void *Arena,
+    uint32_t Size)
+{
+  uint8_t i;
+
+  Cache->Arena = (uint16_t *)Arena;
+  Cache->ArenaSize = (Arena != NULL) ? Size / sizeof(uint16_t) : 0;
+  Cache->Top = 0;
+  Cache->Clock = 0;
+  Cache->Hits = 0;
+  Cache->Misses = 0;
+  for (i = 0; i < BGFX_CIRCLE_CACHE_ENTRIES; i++) {
+    Cache->Tables[i].Radius = -1;
+    Cache->Tables[i].Size = 0;
+  }
+}
+
+
+
+
+void BGFX_SetCircleCache(BGFX_CircleCache_t *Cache,
+    BGFX_Parameters_t *Display)
+{
+  Display->CircleCache = Cache;
+}
+
+
+
+
+BGFX_Rect_t BGFX_GetClip(BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t r = {0, 0, 0, 0};
+  BGFX_Rect_t band;
+  int16_t b0, b1;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  r.W = Display.Width;
+  r.H = Display.Height;
+
+  if (Display.BandHeight > 0) {
+    /* Buffer rows of the band, which are screen columns when rotated by 90
+     * or 270 degrees and are counted from the other side when rotated by
+     * 180 or 270 degrees */
+    b0 = Display.BandY;
+    b1 = Display.BandY + Display.BandHeight;
+    if (Display.Rotation >= 2) {
+      b0 = Display.HEIGHT - b1;
+      b1 = Display.HEIGHT - Display.BandY;
+    }
+    band = r;
+    if (Display.Rotation & 1) {
+      band.X = b0;
+      band.W = b1 - b0;
+    } else {
+      band.Y = b0;
+      band.H = b1 - b0;
+    }
+    BGFX_RectIntersect(&r, band);
+  }
+
+  if ((Display.Clip.W > 0) && (Display.Clip.H > 0)) {
+    BGFX_RectIntersect(&r, Display.Clip);
+  }
+  return r;
+}
+
+
+
+
+void BGFX_ExpandRow565(const uint8_t *Src, uint16_t *Dst, uint32_t Count,
+    const uint16_t *Palette)
+{
+  uint32_t i;
+
+  /* Unrolled by 4: the four lookups are independent, which keeps the load
+   * pipeline busy on cores without gather instructions */
+  for (i = 0; i + 4 <= Count; i += 4) {
+    Dst[i + 0] = Palette[Src[i + 0]];
+    Dst[i + 1] = Palette[Src[i + 1]];
+    Dst[i + 2] = Palette[Src[i + 2]];
+    Dst[i + 3] = Palette[Src[i + 3]];
+  }
+  for (; i < Count; i++) {
+    Dst[i] = Palette[Src[i]];
+  }
+}
+
+
+
+
+void BGFX_ExpandRow888(const uint8_t *Src, uint8_t *Dst, uint32_t Count,
+    const uint32_t *Palette)
+{
+  uint32_t i, c0, c1, c2, c3;
+
+  for (i = 0; i + 4 <= Count; i += 4) {
+    c0 = Palette[Src[i + 0]];
+    c1 = Palette[Src[i + 1]];
+    c2 = Palette[Src[i + 2]];
+    c3 = Palette[Src[i + 3]];
+    Dst[0]  = c0 >> 16; Dst[1]  = c0 >> 8; Dst[2]  = c0;
+    Dst[3]  = c1 >> 16; Dst[4]  = c1 >> 8; Dst[5]  = c1;
+    Dst[6]  = c2 >> 16; Dst[7]  = c2 >> 8; Dst[8]  = c2;
+    Dst[9]  = c3 >> 16; Dst[10] = c3 >> 8; Dst[11] = c3;
+    Dst += 12;
+  }
+  for (; i < Count; i++) {
+    c0 = Palette[Src[i]];
+    Dst[0] = c0 >> 16; Dst[1] = c0 >> 8; Dst[2] = c0;
+    Dst += 3;
+  }
+}
+
+
+
+
+void BGFX_ExpandPalette(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+    void *Dst, BGFX_Parameters_t Display)
+{
+  const uint8_t *src;
+  uint16_t row;
+
+  if ((Display.Buffer == NULL) || (Display.Palette == NULL) ||
+      (x >= Display.WIDTH) || (y >= Display.HEIGHT))
+  {
+    return;
+  }
+  w = min(w, Display.WIDTH - x);
+  h = min(h, Display.HEIGHT - y);
+
+  src = (const uint8_t *)Display.Buffer + x + (uint32_t)y * Display.WIDTH;
+  for (row = 0; row < h; row++) {
+    if (Display.PaletteFormat == BGFX_PALETTE_RGB888) {
+      BGFX_ExpandRow888(src, (uint8_t *)Dst + (uint32_t)row * w * 3, w,
+          (const uint32_t *)Display.Palette);
+    } else {
+      BGFX_ExpandRow565(src, (uint16_t *)Dst + (uint32_t)row * w, w,
+          (const uint16_t *)Display.Palette);
+    }
+    src += Display.WIDTH;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Clip a run of pixels to the [Min, Max) range
+    @param  Start   First coordinate of the run, moved inside the range
+    @param  Length  Number of pixels in the run
+    @param  Min     First coordinate of the range
+    @param  Max     Coordinate following the range
+    @return Number of pixels left in the run, 0 or less if nothing is left
+ */
+/**************************************************************************/
+static int16_t BGFX_ClipRun(int16_t *Start, int16_t Length, int16_t Min,
+    int16_t Max)
+{
+  int32_t start = *Start;
+  int32_t end = start + Length;
+
+  if (start < Min) {
+    start = Min;
+  }
+  if (end > Max) {
+    end = Max;
+  }
+  *Start = start;
+  return (int16_t)(end - start);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Tell if a bounding box misses the area drawings can reach, so a
+            primitive can be rejected as a whole
+    @param  x0  Left-most x coordinate
+    @param  y0  Top-most y coordinate
+    @param  x1  Right-most x coordinate, included
+    @param  y1  Bottom-most y coordinate, included
+    @param  Display Structure to display parameters and functions
+    @return 1 if nothing of the box can be drawn
+ */
+/**************************************************************************/
+static uint8_t BGFX_Outside(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip = BGFX_GetClip(Display);
+
+  return (x1 < clip.X) || (y1 < clip.Y) || (x0 >= clip.X + clip.W) ||
+      (y0 >= clip.Y + clip.H);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Find where a point lands in the buffer once rotation is applied
+    @param  x   x coordinate, must be inside the display
+    @param  y   y coordinate, must be inside the display
+    @param  StepX   Index increment to move one pixel right on the screen
+    @param  StepY   Index increment to move one pixel down on the screen
+    @param  Display Structure to display parameters and functions
+    @return Index of the pixel in an 8 or 16 bits buffer, which is also
+            x + y * WIDTH in unrotated coordinates, y counted from the first
+            row of the band when rendering in bands
+ */
+/**************************************************************************/
+static int32_t BGFX_Locate(int16_t x, int16_t y, int32_t *StepX,
+    int32_t *StepY, BGFX_Parameters_t Display)
+{
+  int32_t px, py;
+
+  switch (Display.Rotation) {
+  case 1:
+    px = Display.WIDTH - 1 - y;
+    py = x;
+    *StepX = Display.WIDTH;
+    *StepY = -1;
+    break;
+  case 2:
+    px = Display.WIDTH - 1 - x;
+    py = Display.HEIGHT - 1 - y;
+    *StepX = -1;
+    *StepY = -(int32_t)Display.WIDTH;
+    break;
+  case 3:
+    px = y;
+    py = Display.HEIGHT - 1 - x;
+    *StepX = -(int32_t)Display.WIDTH;
+    *StepY = 1;
+    break;
+  default:
+    px = x;
+    py = y;
+    *StepX = 1;
+    *StepY = Display.WIDTH;
+    break;
+  }
+  return px + (py - Display.BandY) * (int32_t)Display.WIDTH;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a pixel if it is inside an area, rotation resolved by the
+            caller
+    @param  x   x coordinate
+    @param  y   y coordinate
+    @param  color 16-bit 5-6-5 Color to draw with
+    @param  Clip    Area pixels are drawn in, see BGFX_GetClip
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+ */
+/**************************************************************************/
+static void BGFX_PointClipped(int16_t x, int16_t y, uint16_t color,
+    BGFX_Rect_t Clip, BGFX_Parameters_t Display)
+{
+  int32_t index, step_x, step_y;
+
+  if ((x < Clip.X) || (y < Clip.Y) || (x >= Clip.X + Clip.W) ||
+      (y >= Clip.Y + Clip.H))
+  {
+    return;
+  }
+
+  if (BGFX_IsDirect(Display)) {
+    index = BGFX_Locate(x, y, &step_x, &step_y, Display);
+    if (Display.ColorScheme == BGFX_16BITS) {
+      uint16_t *p = (uint16_t *)Display.Buffer + index;
+      *p = BGFX_Rop(*p, color, Display.RasterOp);
+    } else {
+      uint8_t *p = (uint8_t *)Display.Buffer + index;
+      *p = BGFX_Rop(*p, color, Display.RasterOp) & 0xFF;
+    }
+  } else if (BGFX_IsDirect01(Display)) {
+    index = BGFX_Locate(x, y, &step_x, &step_y, Display);
+    BGFX_DrawPixel_01(index % Display.WIDTH, index / Display.WIDTH, color,
+        Display);
+  } else {
+    BGFX_DrawPixel(x, y, color, Display);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill the part of a rectangle inside an area, one run per buffer
+            row so every run is contiguous in memory
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  color 16-bit 5-6-5 Color to fill with
+    @param  Clip    Area pixels are drawn in, see BGFX_GetClip
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+ */
+/**************************************************************************/
+static void BGFX_FillClipped(int16_t x, int16_t y, int16_t w, int16_t h,
+    uint16_t color, BGFX_Rect_t Clip, BGFX_Parameters_t Display)
+{
+  int32_t index, step_x, step_y;
+  int16_t i, j;
+
+  w = BGFX_ClipRun(&x, w, Clip.X, Clip.X + Clip.W);
+  h = BGFX_ClipRun(&y, h, Clip.Y, Clip.Y + Clip.H);
+  if ((w <= 0) || (h <= 0)) {
+    return;
+  }
+
+  if (BGFX_IsDirect01(Display)) {
+    BGFX_FillRect01(x, y, w, h, color, Display);
+    return;
+  }
+
+  if (BGFX_IsDirect(Display)) {
+    index = BGFX_Locate(x, y, &step_x, &step_y, Display);
+    if (Display.Rotation & 1) {
+      BGFX_FillBlock(index, step_y, h, step_x, w, color, Display);
+    } else {
+      BGFX_FillBlock(index, step_x, w, step_y, h, color, Display);
+    }
+    return;
+  }
+
+  if (Display.Rotation & 1) {
+    for (i = 0; i < w; i++) {
+      for (j = 0; j < h; j++) {
+        BGFX_DrawPixel(x + i, y + j, color, Display);
+      }
+    }
+  } else {
+    for (j = 0; j < h; j++) {
+      for (i = 0; i < w; i++) {
+        BGFX_DrawPixel(x + i, y + j, color, Display);
+      }
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw the part of a rectangle outline inside an area
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  color 16-bit 5-6-5 Color to draw with
+    @param  Clip    Area pixels are drawn in, see BGFX_GetClip
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+ */
+/**************************************************************************/
+static void BGFX_RectClipped(int16_t x, int16_t y, uint16_t w,
+    uint16_t h, uint16_t color, BGFX_Rect_t Clip, BGFX_Parameters_t Display)
+{
+  if ((w == 0) || (h == 0)) {
+    return;
+  }
+
+  /* Each pixel drawn once, so XOR raster operations work on the corners */
+  BGFX_FillClipped(x, y, w, 1, color, Clip, Display);
+  if (h > 1) {
+    BGFX_FillClipped(x, y + h - 1, w, 1, color, Clip, Display);
+  }
+  BGFX_FillClipped(x, y + 1, 1, h - 2, color, Clip, Display);
+  if (w > 1) {
+    BGFX_FillClipped(x + w - 1, y + 1, 1, h - 2, color, Clip, Display);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw the part of a line inside an area. Bresenham's algorithm,
+            straight lines and runs of 2 pixels or more written as spans.
+    @param  x0  Start point x coordinate
+    @param  y0  Start point y coordinate
+    @param  x1  End point x coordinate
+    @param  y1  End point y coordinate
+    @param  color 16-bit 5-6-5 Color to draw with
+    @param  Clip    Area pixels are drawn in, see BGFX_GetClip
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+ */
+/**************************************************************************/
+static void BGFX_LineClipped(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    uint16_t color, BGFX_Rect_t Clip, BGFX_Parameters_t Display)
+{
+  int16_t steep;
+  int16_t dx, dy, err, ystep;
+
+  /* Whole line outside the area, rejected at once */
+  if ((max(x0, x1) < Clip.X) || (max(y0, y1) < Clip.Y) ||
+      (min(x0, x1) >= Clip.X + Clip.W) || (min(y0, y1) >= Clip.Y + Clip.H))
+  {
+    return;
+  }
+
+  /* Straight lines go to the span fills */
+  if (y0 == y1) {
+    BGFX_FillClipped(min(x0, x1), y0, abs(x1 - x0) + 1, 1, color, Clip,
+        Display);
+    return;
+  }
+  if (x0 == x1) {
+    BGFX_FillClipped(x0, min(y0, y1), 1, abs(y1 - y0) + 1, color, Clip,
+        Display);
+    return;
+  }
+
+  steep = abs(y1 - y0) > abs(x1 - x0);
+
+  if (steep) {
+    _swap_int16_t(x0, y0);
+    _swap_int16_t(x1, y1);
+  }
+
+  if (x0 > x1) {
+    _swap_int16_t(x0, x1);
+    _swap_int16_t(y0, y1);
+  }
+
+  dx = x1 - x0;
+  dy = abs(y1 - y0);
+
+  err = dx / 2;
+
+  if (y0 < y1) {
+    ystep = 1;
+  } else {
+    ystep = -1;
+  }
+
+  if ((dy > 0) && ((int32_t)dx >= 2 * (int32_t)dy)) {
+    BGFX_LineRuns(x0, y0, x1, dx, dy, ystep, steep, color, Clip, Display);
+    return;
+  }
+
+  /* Close to 45 degrees runs are 1 or 2 pixels long, stepped one pixel at
+   * a time */
+  for (; x0 <= x1; x0++) {
+    if (steep) {
+      BGFX_PointClipped(y0, x0, color, Clip, Display);
+    } else {
+      BGFX_PointClipped(x0, y0, color, Clip, Display);
+    }
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a line made of runs of 2 pixels or more along its major
+            axis (run-slice). Every run but the first and the last is q or
+            q + 1 pixels long, with dx = q * dy + r, so the lengths come
+            from the Bresenham error without a division per run. Pixels are
+            the ones BGFX_DrawLine would step through, each drawn once.
+    @param  x0  Major axis start, x0 <= x1
+    @param  y0  Minor axis start
+    @param  x1  Major axis end, included
+    @param  dx  x1 - x0
+    @param  dy  Minor axis length, 0 < 2 * dy <= dx
+    @param  ystep   Minor axis step, 1 or -1
+    @param  steep   If set the major axis is y: runs are vertical
+    @param  color   16-bit 5-6-5 Color to draw with
+    @param  Clip    Area the runs are clipped to, see BGFX_GetClip
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_LineRuns(int16_t x0, int16_t y0, int16_t x1, int16_t dx,
+    int16_t dy, int16_t ystep, int16_t steep, uint16_t color,
+    BGFX_Rect_t Clip, BGFX_Parameters_t Display)
+{
+  int32_t q = dx / dy;
+  int32_t err = dx / 2;
+  int32_t run = err / dy + 1;
+
+  while (x0 <= x1) {
+    if (run > x1 - x0 + 1) {
+      run = x1 - x0 + 1;
+    }
+    if (steep) {
+      BGFX_FillClipped(y0, x0, 1, run, color, Clip, Display);
+    } else {
+      BGFX_FillClipped(x0, y0, run, 1, color, Clip, Display);
+    }
+    x0 += run;
+    y0 += ystep;
+
+    /* Error at the start of the next run, between dx - dy and dx - 1 */
+    err += dx - run * dy;
+    run = q + (err >= q * dy);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Find the pixels of a line on a row, the ones BGFX_DrawLine
+            would draw there. Pixel i along the major axis is
+            ceil((i * dy - dx / 2) / dx) steps away on the minor axis, as
+            given by the Bresenham error, so a row is found without
+            stepping the line.
+    @param  x0  Start point x coordinate
+    @param  y0  Start point y coordinate
+    @param  x1  End point x coordinate
+    @param  y1  End point y coordinate
+    @param  y   Row
+    @param  Start   First pixel of the line on the row
+    @param  End     Last pixel of the line on the row
+    @return 1 if the line crosses the row, 0 otherwise
+ */
+/**************************************************************************/
+static uint8_t BGFX_LineRow(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t y, int16_t *Start, int16_t *End)
+{
+  int16_t steep = abs(y1 - y0) > abs(x1 - x0);
+  int32_t dx, dy, err, k, first, last;
+
+  if ((y < min(y0, y1)) || (y > max(y0, y1))) {
+    return 0;
+  }
+  if (steep) {
+    _swap_int16_t(x0, y0);
+    _swap_int16_t(x1, y1);
+  }
+  if (x0 > x1) {
+    _swap_int16_t(x0, x1);
+    _swap_int16_t(y0, y1);
+  }
+  dx = x1 - x0;
+  dy = abs(y1 - y0);
+  err = dx / 2;
+
+  if (steep) {
+    /* One pixel per row, the row is on the major axis */
+    k = (int32_t)(y - x0) * dy - err;
+    k = (k <= 0) ? 0 : (k + dx - 1) / dx;
+    *Start = (y1 > y0) ? y0 + k : y0 - k;
+    *End = *Start;
+    return 1;
+  }
+  if (dy == 0) {
+    *Start = x0;
+    *End = x1;
+    return 1;
+  }
+  k = abs(y - y0);
+  first = (k == 0) ? 0 : ((k - 1) * dx + err) / dy + 1;
+  last = (k * dx + err) / dy;
+  *Start = x0 + first;
+  *End = x0 + min(last, dx);
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Find the span tables of a radius in the circle cache, computing
+            them if needed. Room is made by evicting the least recently used
+            radii and packing the remaining tables at the start of the
+            arena.
+    @param  r   Radius
+    @param  Steps   Returns the number of outline steps
+    @param  Display Structure to display parameters and functions
+    @return Tables, see BGFX_CircleBuild, NULL if there is no cache or the
+            radius does not fit
+ */
+/**************************************************************************/
+static const uint16_t *BGFX_CircleLookup(int16_t r, uint16_t *Steps,
+    BGFX_Parameters_t Display)
+{
+  BGFX_CircleCache_t *cache = Display.CircleCache;
+  BGFX_CircleTables_t *t, *slot;
+  uint32_t size = 2 * (uint32_t)r + 1;
+  uint8_t i;
+
+  if ((cache == NULL) || (r <= 0) || (size > cache->ArenaSize)) {
+    return NULL;
+  }
+  cache->Clock++;
+  for (i = 0; i < BGFX_CIRCLE_CACHE_ENTRIES; i++) {
+    t = &cache->Tables[i];
+    if (t->Radius == r) {
+      t->LastUse = cache->Clock;
+      cache->Hits++;
+      *Steps = t->Steps;
+      return cache->Arena + t->Offset;
+    }
+  }
+  cache->Misses++;
+
+  for (;;) {
+    slot = NULL;
+    t = NULL;
+    for (i = 0; i < BGFX_CIRCLE_CACHE_ENTRIES; i++) {
+      if (cache->Tables[i].Radius < 0) {
+        slot = &cache->Tables[i];
+      } else if ((t == NULL) ||
+          (cache->Tables[i].LastUse < t->LastUse)) {
+        t = &cache->Tables[i];
+      }
+    }
+    if ((slot != NULL) && (cache->Top + size <= cache->ArenaSize)) {
+      break;
+    }
+
+    /* Evicting t, the tables above it move down */
+    memmove(cache->Arena + t->Offset, cache->Arena + t->Offset + t->Size,
+        (cache->Top - t->Offset - t->Size) * sizeof(uint16_t));
+    for (i = 0; i < BGFX_CIRCLE_CACHE_ENTRIES; i++) {
+      if ((cache->Tables[i].Radius >= 0) &&
+          (cache->Tables[i].Offset > t->Offset)) {
+        cache->Tables[i].Offset -= t->Size;
+      }
+    }
+    cache->Top -= t->Size;
+    t->Radius = -1;
+  }
+
+  slot->Radius = r;
+  slot->Offset = cache->Top;
+  slot->Size = size;
+  slot->LastUse = cache->Clock;
+  cache->Top += size;
+  BGFX_CircleBuild(cache->Arena + slot->Offset, r, &slot->Steps);
+  *Steps = slot->Steps;
+  return cache->Arena + slot->Offset;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the span tables of a radius, with the midpoint steps of
+            BGFX_DrawCircleHelper and BGFX_DrawCircleFillHelper
+    @param  Table   2 * r + 1 values. Values 0 to r: for each distance from
+            the center row, the number of columns on each side of the
+            center column that reach it (filled shapes). Values r + 1 and
+            up: y of each outline step, x being the step number plus one.
+    @param  r   Radius, 1 or more
+    @param  Steps   Returns the number of outline steps, r at most
+ */
+/**************************************************************************/
+static void BGFX_CircleBuild(uint16_t *Table, int16_t r, uint16_t *Steps)
+{
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0, y = r, px = 0, py = r, d;
+  uint16_t *widths = Table, *ys = Table + r + 1;
+  uint16_t n = 0;
+
+  memset(widths, 0, (r + 1) * sizeof(uint16_t));
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    ys[n++] = y;
+
+    /* Columns of the fill helper: column x reaches y rows from the center,
+     * column py reaches px */
+    if ((x < (y + 1)) && (widths[y] < x)) {
+      widths[y] = x;
+    }
+    if (y != py) {
+      if (widths[px] < py) {
+        widths[px] = py;
+      }
+      py = y;
+    }
+    px = x;
+  }
+
+  /* Widest column reaching each distance */
+  for (d = r - 1; d >= 0; d--) {
+    if (widths[d] < widths[d + 1]) {
+      widths[d] = widths[d + 1];
+    }
+  }
+  *Steps = n;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw the corners of a circle stretched to a rounded rectangle
+            from the outline table. On a direct buffer, with the shape
+            inside the clip, the steps sharing a y are one horizontal run,
+            and mirrored along the diagonal one vertical run, written at
+            offsets from the top left center. Otherwise the pixels are drawn
+            one by one. Pixels are the ones BGFX_DrawCircle and
+            BGFX_DrawRoundRect would draw for the corners, each once.
+    @param  x0  Left corner center x coordinate
+    @param  y0  Top corner center y coordinate
+    @param  x1  Right corner center x coordinate
+    @param  y1  Bottom corner center y coordinate
+    @param  r   Radius of the corners
+    @param  Ys  y of each outline step
+    @param  Steps   Number of steps
+    @param  color   16-bit 5-6-5 Color to draw with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_CircleRuns(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t r, const uint16_t *Ys, uint16_t Steps, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip;
+  int32_t tl, tr, bl, br, sx, sy;
+  uint16_t a, b, diagonal;
+  int16_t y, n, m;
+
+  /* As BGFX_CirclePoints: the steps past the diagonal are left out, and
+   * the mirrored runs stop before a step on it */
+  while ((Steps > 0) && (Steps > Ys[Steps - 1])) {
+    Steps--;
+  }
+  diagonal = ((Steps > 0) && (Steps == Ys[Steps - 1])) ? Steps - 1 : Steps;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+  if ((x0 - r < clip.X) || (x1 + r >= clip.X + clip.W) ||
+      (y0 - r < clip.Y) || (y1 + r >= clip.Y + clip.H)) {
+    for (a = 0; a < Steps; a++) {
+      BGFX_CirclePoints(x0, y0, a + 1, Ys[a], 0x1, color, Display);
+      BGFX_CirclePoints(x1, y0, a + 1, Ys[a], 0x2, color, Display);
+      BGFX_CirclePoints(x1, y1, a + 1, Ys[a], 0x4, color, Display);
+      BGFX_CirclePoints(x0, y1, a + 1, Ys[a], 0x8, color, Display);
+    }
+    return;
+  }
+
+  /* Whole shape inside the clip: every run is an offset from a center */
+  tl = BGFX_Locate(x0, y0, &sx, &sy, Display);
+  tr = tl + (x1 - x0) * sx;
+  bl = tl + (y1 - y0) * sy;
+  br = tr + (y1 - y0) * sy;
+  for (a = 0; a < Steps; a = b) {
+    y = Ys[a];
+    for (b = a + 1; (b < Steps) && (Ys[b] == y); b++) {
+    }
+    /* Steps a to b - 1: x from a + 1 to b, on row y, mirrored from
+     * a + 1 to a + m */
+    n = b - a;
+    m = ((b < diagonal) ? b : diagonal) - a;
+    BGFX_FillRun(br + (a + 1) * sx + y * sy, sx, n, color, Display);
+    BGFX_FillRun(tr + (a + 1) * sx - y * sy, sx, n, color, Display);
+    BGFX_FillRun(bl - b * sx + y * sy, sx, n, color, Display);
+    BGFX_FillRun(tl - b * sx - y * sy, sx, n, color, Display);
+    if (m > 0) {
+      BGFX_FillRun(br + y * sx + (a + 1) * sy, sy, m, color, Display);
+      BGFX_FillRun(tr + y * sx - (a + m) * sy, sy, m, color, Display);
+      BGFX_FillRun(bl - y * sx + (a + 1) * sy, sy, m, color, Display);
+      BGFX_FillRun(tl - y * sx - (a + m) * sy, sy, m, color, Display);
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw the two pixels of one outline step in each quadrant
+    @param  x0  Center-point x coordinate
+    @param  y0  Center-point y coordinate
+    @param  x   Step x offset
+    @param  y   Step y offset
+    @param  Corners Quadrants, as the cornername of BGFX_DrawCircleHelper
+    @param  color   16-bit 5-6-5 Color to draw with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_CirclePoints(int16_t x0, int16_t y0, int16_t x, int16_t y,
+    uint8_t Corners, uint16_t color, BGFX_Parameters_t Display)
+{
+  /* Past the diagonal the step is the previous one mirrored, on it both
+   * pixels are the same: each pixel drawn once for raster operations */
+  if (x > y) {
+    return;
+  }
+  if (Corners & 0x4) {
+    BGFX_DrawPixel(x0 + x, y0 + y, color, Display);
+    if (x != y) {
+      BGFX_DrawPixel(x0 + y, y0 + x, color, Display);
+    }
+  }
+  if (Corners & 0x2) {
+    BGFX_DrawPixel(x0 + x, y0 - y, color, Display);
+    if (x != y) {
+      BGFX_DrawPixel(x0 + y, y0 - x, color, Display);
+    }
+  }
+  if (Corners & 0x8) {
+    if (x != y) {
+      BGFX_DrawPixel(x0 - y, y0 + x, color, Display);
+    }
+    BGFX_DrawPixel(x0 - x, y0 + y, color, Display);
+  }
+  if (Corners & 0x1) {
+    if (x != y) {
+      BGFX_DrawPixel(x0 - y, y0 - x, color, Display);
+    }
+    BGFX_DrawPixel(x0 - x, y0 - y, color, Display);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a circle stretched to a rounded rectangle from the fill
+            table. Direct buffers get one run per row, rotation and clip
+            resolved once; others one rectangle per group of rows of the
+            same width. Pixels are the ones BGFX_DrawCircleFill and
+            BGFX_DrawRoundRectFill would draw.
+    @param  x0  Left corner center x coordinate
+    @param  y0  Top corner center y coordinate
+    @param  x1  Right corner center x coordinate, x0 - 1 at least
+    @param  y1  Bottom corner center y coordinate, y0 - 1 at least
+    @param  r   Radius of the corners
+    @param  Widths  Columns reaching each distance from the center rows
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_CircleRows(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t r, const uint16_t *Widths, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip;
+  int32_t index, step_x, step_y;
+  int16_t y, last, next, x, w;
+  uint16_t width;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+  y = max(y0 - r, clip.Y);
+  last = min(y1 + r, clip.Y + clip.H - 1);
+
+  /* Direct buffers: rotation and clip resolved once, one run per row */
+  if (BGFX_IsDirect(Display)) {
+    for (; y <= last; y++) {
+      width = Widths[(y < y0) ? y0 - y : ((y > y1) ? y - y1 : 0)];
+      x = x0 - width;
+      w = BGFX_ClipRun(&x, x1 - x0 + 1 + 2 * width, clip.X,
+          clip.X + clip.W);
+      if (w > 0) {
+        index = BGFX_Locate(x, y, &step_x, &step_y, Display);
+        BGFX_FillRun(index, step_x, w, color, Display);
+      }
+    }
+    return;
+  }
+
+  for (; y <= last; y = next) {
+    width = Widths[(y < y0) ? y0 - y : ((y > y1) ? y - y1 : 0)];
+    /* Rows of the same width make one rectangle */
+    for (next = y + 1; next <= last; next++) {
+      if (Widths[(next < y0) ? y0 - next : ((next > y1) ? next - y1 : 0)] !=
+          width) {
+        break;
+      }
+    }
+    BGFX_DrawRectFill(x0 - width, y, x1 - x0 + 1 + 2 * width, next - y,
+        color, Display);
+  }
+}
+
 
-    if (!Display.Cp437 && (c >= 176)){
-      c++; /* Handle 'classic' charset behavior */
+/**************************************************************************/
+/*!
+    @brief  Tell if the buffer can be written directly, without going through
+            BGFX_DrawPixel for every pixel
+    @param  Display Structure to display parameters and functions
+    @return 1 if the span writers can address the buffer themselves
+ */
+/**************************************************************************/
+static uint8_t BGFX_IsDirect(BGFX_Parameters_t Display)
+{
+  if ((Display.DrawPixel != NULL) || (Display.Buffer == NULL)) {
+    return 0;
+  }
+  return (Display.ColorScheme == BGFX_8BITS) ||
+      (Display.ColorScheme == BGFX_16BITS) ||
+      (Display.ColorScheme == BGFX_INDEXED8);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Write one color to a run of pixels in an 8 or 16 bits buffer
+    @param  Index   Index of the first pixel, see BGFX_Locate
+    @param  Step    Index increment between two pixels of the run
+    @param  Count   Number of pixels
+    @param  color   Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_FillRun(int32_t Index, int32_t Step, int16_t Count,
+    uint16_t color, BGFX_Parameters_t Display)
+{
+  int16_t i;
+
+  /* Order does not matter for a single color, always walk forward */
+  if (Step < 0) {
+    Index += Step * (Count - 1);
+    Step = -Step;
+  }
+
+  if (Display.RasterOp != BGFX_ROP_COPY) {
+    BGFX_RopRun(Index, Step, Count, color, Display);
+    return;
+  }
+
+  if (Display.ColorScheme == BGFX_16BITS) {
+    uint16_t *p = (uint16_t *)Display.Buffer + Index;
+    if (Step == 1) {
+      for (i = 0; i < Count; i++) {
+        p[i] = color;
+      }
+    } else {
+      for (i = 0; i < Count; i++, p += Step) {
+        *p = color;
+      }
+    }
+  } else {
+    uint8_t *p = (uint8_t *)Display.Buffer + Index;
+    if (Step == 1) {
+      memset(p, color & 0xFF, Count);
+    } else {
+      for (i = 0; i < Count; i++, p += Step) {
+        *p = color & 0xFF;
+      }
     }
+  }
+}
 
 
-    for (int8_t i = 0; i < 5; i++) { /* Char bitmap = 5 columns */
-      uint8_t line = glcdfont[c * 5 + i];
-      for (int8_t j = 0; j < 8; j++, line >>= 1) {
-        if (line & 1) {
-          if (size_x == 1 && size_y == 1){
-            BGFX_DrawPixel(x + i, y + j, color, Display);
-          }else{
-            BGFX_DrawRectFill(x + i * size_x, y + j * size_y, size_x, size_y,
-                color, Display);
-          }
-        } else if (bg != color) {
-          if (size_x == 1 && size_y == 1){
-            BGFX_DrawPixel(x + i, y + j, bg, Display);
-          }else{
-            BGFX_DrawRectFill(x + i * size_x, y + j * size_y, size_x, size_y,
-                bg, Display);
-          }
+/**************************************************************************/
+/*!
+    @brief  Write one color to several runs of pixels in an 8 or 16 bits
+            buffer, the rows (or columns) of a rectangle, in one call
+    @param  Index   Index of the first pixel of the first run, see
+            BGFX_Locate
+    @param  Step    Index increment between two pixels of a run
+    @param  Count   Number of pixels per run
+    @param  Next    Index increment from one run to the next
+    @param  Runs    Number of runs
+    @param  color   Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_FillBlock(int32_t Index, int32_t Step, int16_t Count,
+    int32_t Next, int16_t Runs, uint16_t color, BGFX_Parameters_t Display)
+{
+  int16_t i, j;
+
+  if (Display.RasterOp != BGFX_ROP_COPY) {
+    for (j = 0; j < Runs; j++, Index += Next) {
+      BGFX_FillRun(Index, Step, Count, color, Display);
+    }
+    return;
+  }
+
+  /* Order does not matter for a single color, always walk forward */
+  if (Step < 0) {
+    Index += Step * (Count - 1);
+    Step = -Step;
+  }
+
+  if (Display.ColorScheme == BGFX_16BITS) {
+    uint16_t *p = (uint16_t *)Display.Buffer + Index;
+    for (j = 0; j < Runs; j++, p += Next) {
+      if (Step == 1) {
+        for (i = 0; i < Count; i++) {
+          p[i] = color;
+        }
+      } else {
+        for (i = 0; i < Count; i++) {
+          p[i * Step] = color;
         }
       }
     }
-    if (bg != color) { /* If opaque, draw vertical line for last column */
-      if (size_x == 1 && size_y == 1){
-        BGFX_DrawLine(x + 5, y, x + 5, y + 8, bg, Display);
-      }else{
-        BGFX_DrawRectFill(x + 5 * size_x, y, size_x, 8 * size_y, bg, Display);
+  } else {
+    uint8_t *p = (uint8_t *)Display.Buffer + Index;
+    for (j = 0; j < Runs; j++, p += Next) {
+      if (Step == 1) {
+        memset(p, color & 0xFF, Count);
+      } else {
+        for (i = 0; i < Count; i++) {
+          p[i * Step] = color & 0xFF;
+        }
       }
     }
+  }
+}
+
 
+/**************************************************************************/
+/*!
+    @brief  Combine one color with a run of pixels in an 8 or 16 bits
+            buffer. Contiguous runs are processed 64 bits at a time.
+    @param  Index   Index of the first pixel, step already positive
+    @param  Step    Index increment between two pixels of the run
+    @param  Count   Number of pixels
+    @param  color   Color to combine with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_RopRun(int32_t Index, int32_t Step, int16_t Count,
+    uint16_t color, BGFX_Parameters_t Display)
+{
+  uint64_t word, wide;
+  int16_t i = 0;
+
+  if (Display.ColorScheme == BGFX_16BITS) {
+    uint16_t *p = (uint16_t *)Display.Buffer + Index;
+    if (Step == 1) {
+      wide = 0x0001000100010001ULL * color;
+      for (; i + 4 <= Count; i += 4) {
+        memcpy(&word, &p[i], sizeof(word));
+        word = BGFX_RopWord(word, wide, Display.RasterOp);
+        memcpy(&p[i], &word, sizeof(word));
+      }
+    }
+    for (; i < Count; i++) {
+      p[i * Step] = BGFX_Rop(p[i * Step], color, Display.RasterOp);
+    }
+  } else {
+    uint8_t *p = (uint8_t *)Display.Buffer + Index;
+    if (Step == 1) {
+      wide = 0x0101010101010101ULL * (color & 0xFF);
+      for (; i + 8 <= Count; i += 8) {
+        memcpy(&word, &p[i], sizeof(word));
+        word = BGFX_RopWord(word, wide, Display.RasterOp);
+        memcpy(&p[i], &word, sizeof(word));
+      }
+    }
+    for (; i < Count; i++) {
+      p[i * Step] = BGFX_Rop(p[i * Step], color, Display.RasterOp) & 0xFF;
+    }
   }
 }
 
 
+/**************************************************************************/
+/*!
+    @brief  Write a run of pixels with a repeating on/off mask. The mask is
+            repeated over 64 bits once, so the bits of 32 pixels are one
+            shift of it, without a modulo per pixel.
+    @param  Index   Index of the first pixel, see BGFX_Locate
+    @param  Step    Index increment between two pixels of the run
+    @param  Count   Number of pixels
+    @param  Bits    Mask, bit 0 for the first pixel
+    @param  Length  Number of bits in the mask, 1 to 32
+    @param  color   Color of the set bits
+    @param  bg      Color of the clear bits, same as color to keep the
+            pixels of the clear bits
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_BitsRun(int32_t Index, int32_t Step, int16_t Count,
+    uint32_t Bits, uint8_t Length, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display)
+{
+  uint64_t wide;
+  uint32_t reversed = 0, word;
+  uint16_t c;
+  int16_t i, j, n;
+  uint8_t k;
+
+  Bits &= 0xFFFFFFFFUL >> (32 - Length);
+
+  /* Walk forward in memory, the mask read from the other end */
+  if (Step < 0) {
+    for (k = 0; k < Length; k++) {
+      reversed |= ((Bits >> k) & 1UL) << (Length - 1 - k);
+    }
+    k = Length - 1 - (Count - 1) % Length;
+    Bits = (uint32_t)((((uint64_t)reversed << Length) | reversed) >> k);
+    Bits &= 0xFFFFFFFFUL >> (32 - Length);
+    Index += Step * (Count - 1);
+    Step = -Step;
+  }
+  wide = Bits;
+  for (k = Length; k < 64; k *= 2) {
+    wide |= wide << k;
+  }
+
+  if (Display.ColorScheme == BGFX_MONOCHROMATIC) {
+    BGFX_BitsRun01(Index, Step, Count, wide, Length, color, bg, Display);
+    return;
+  }
+
+  for (i = 0; i < Count; i += 32) {
+    word = (uint32_t)(wide >> (i % Length));
+    n = (Count - i < 32) ? Count - i : 32;
+    for (j = 0; j < n; j++, word >>= 1, Index += Step) {
+      if (word & 1) {
+        c = color;
+      } else if (bg != color) {
+        c = bg;
+      } else {
+        continue;
+      }
+      if (Display.ColorScheme == BGFX_16BITS) {
+        uint16_t *p = (uint16_t *)Display.Buffer + Index;
+        *p = (Display.RasterOp == BGFX_ROP_COPY) ? c :
+            BGFX_Rop(*p, c, Display.RasterOp);
+      } else {
+        uint8_t *p = (uint8_t *)Display.Buffer + Index;
+        *p = BGFX_Rop(*p, c, Display.RasterOp) & 0xFF;
+      }
+    }
+  }
+}
 
 
-void BGFX_SendString(uint16_t X, uint16_t Y, uint8_t *Buffer, uint32_t Length,
-    uint16_t Color, uint16_t Bgc, uint8_t SizeX, uint8_t SizeY,
+/**************************************************************************/
+/*!
+    @brief  Write a run of pixels with a repeating on/off mask to a
+            monochromatic buffer. Along the axis packed in bytes, the bits of
+            up to 8 pixels are set and cleared with one write; along the
+            other one every pixel is its own byte.
+    @param  Index   Index of the first pixel, see BGFX_Locate
+    @param  Step    Index increment between two pixels of the run, positive
+    @param  Count   Number of pixels
+    @param  Wide    Mask repeated over 64 bits, bit 0 for the first pixel
+    @param  Length  Number of bits in the mask, 1 to 32
+    @param  color   Binary (on or off) color of the set bits
+    @param  bg      Binary (on or off) color of the clear bits, same as color
+            to keep the pixels of the clear bits
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_BitsRun01(int32_t Index, int32_t Step, int16_t Count,
+    uint64_t Wide, uint8_t Length, uint16_t color, uint16_t bg,
     BGFX_Parameters_t Display)
 {
-  uint32_t i;
+  uint8_t on = BGFX_Rop01(color, Display.RasterOp);
+  uint8_t off = (bg != color) ? BGFX_Rop01(bg, Display.RasterOp) :
+      BGFX_BITS_KEEP;
+  int32_t a, b, i, j, n;
+  uint32_t word;
+  uint8_t *ptr, bits, mask;
+  uint8_t packed;
+
+  /* Bits along A, bytes along B, see BGFX_FillRect01 */
+  if (Display.HeightPixelsOnWrite > 1 && Display.WidthPixelsOnWrite == 1) {
+    a = Index / Display.WIDTH;
+    b = Index % Display.WIDTH;
+    packed = (Step != 1);
+  } else {
+    a = Index % Display.WIDTH;
+    b = Index / Display.WIDTH;
+    packed = (Step == 1);
+  }
+  ptr = (uint8_t *)Display.Buffer + (a >> 3) * Display.WIDTH + b;
+
+  /* Along B: one bit in consecutive bytes */
+  if (!packed) {
+    mask = (uint8_t)(1U << (a & 7));
+    for (i = 0; i < Count; i += 32) {
+      word = (uint32_t)(Wide >> (i % Length));
+      n = (Count - i < 32) ? Count - i : 32;
+      for (j = 0; j < n; j++, word >>= 1, ptr++) {
+        if ((word & 1) ? (on != BGFX_BITS_KEEP) : (off != BGFX_BITS_KEEP)) {
+          BGFX_MaskRun01(ptr, 1, mask, (word & 1) ? on : off);
+        }
+      }
+    }
+    return;
+  }
 
-  if (Display.GfxFont == NULL) {
-    for(i = 0; i< Length; i++){
-      BGFX_DrawChar(X, Y, *(Buffer + i), Color, Bgc, SizeX,
-          SizeY, Display);
-      X += SizeX * 6; /* Advance x one char */
+  /* Along A: the pixels of a byte at once */
+  for (i = 0; i < Count; i += n, a += n, ptr += Display.WIDTH) {
+    n = 8 - (a & 7);
+    n = (Count - i < n) ? Count - i : n;
+    mask = (uint8_t)(((1U << n) - 1) << (a & 7));
+    bits = (uint8_t)((Wide >> (i % Length)) << (a & 7));
+    if (on != BGFX_BITS_KEEP) {
+      BGFX_MaskRun01(ptr, 1, bits & mask, on);
+    }
+    if (off != BGFX_BITS_KEEP) {
+      BGFX_MaskRun01(ptr, 1, ~bits & mask, off);
     }
   }
 }
 
 
+/**************************************************************************/
+/*!
+    @brief  Tell if a monochromatic buffer can be written directly, a byte
+            at a time, by the span writers
+    @param  Display Structure to display parameters and functions
+    @return 1 if the mono kernels can address the buffer themselves
+ */
+/**************************************************************************/
+static uint8_t BGFX_IsDirect01(BGFX_Parameters_t Display)
+{
+  return (Display.DrawPixel == NULL) && (Display.Buffer != NULL) &&
+      (Display.ColorScheme == BGFX_MONOCHROMATIC);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle of a monochromatic buffer. Both layouts store
+            8 pixels of one axis in a byte, and consecutive bytes go along
+            the other axis. Each group of 8 rows (or columns) is filled with
+            one mask over all its bytes, so every byte is written once.
+    @param  x   Top left corner x coordinate, inside the display
+    @param  y   Top left corner y coordinate, inside the display
+    @param  w   Width in pixels, already clipped
+    @param  h   Height in pixels, already clipped
+    @param  color Binary (on or off) color to fill with
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+ */
+/**************************************************************************/
+static void BGFX_FillRect01(int16_t x, int16_t y, int16_t w, int16_t h,
+    uint16_t color, BGFX_Parameters_t Display)
+{
+  int32_t step_x, step_y, i0, i1, t;
+  int32_t a0, a1, b0, b1, g;
+  uint8_t lo, hi;
+  uint8_t action = BGFX_Rop01(color, Display.RasterOp);
 
+  if (action == BGFX_BITS_KEEP) {
+    return;
+  }
 
+  /* Opposite corners on the buffer, in unrotated coordinates */
+  i0 = BGFX_Locate(x, y, &step_x, &step_y, Display);
+  i1 = BGFX_Locate(x + w - 1, y + h - 1, &step_x, &step_y, Display);
 
+  if (Display.HeightPixelsOnWrite > 1 && Display.WidthPixelsOnWrite == 1) {
+    /* Bits along y (pages), bytes along x */
+    a0 = i0 / Display.WIDTH;
+    a1 = i1 / Display.WIDTH;
+    b0 = i0 % Display.WIDTH;
+    b1 = i1 % Display.WIDTH;
+  } else {
+    /* Bits along x, bytes along y, see BGFX_DrawPixel_01 */
+    a0 = i0 % Display.WIDTH;
+    a1 = i1 % Display.WIDTH;
+    b0 = i0 / Display.WIDTH;
+    b1 = i1 / Display.WIDTH;
+  }
+  if (a0 > a1) {
+    t = a0; a0 = a1; a1 = t;
+  }
+  if (b0 > b1) {
+    t = b0; b0 = b1; b1 = t;
+  }
 
-void BGFX_SetRotation(uint8_t Rotation, BGFX_Parameters_t *Display)
+  for (g = a0 >> 3; g <= (a1 >> 3); g++) {
+    lo = (g == (a0 >> 3)) ? (a0 & 7) : 0;
+    hi = (g == (a1 >> 3)) ? (a1 & 7) : 7;
+    BGFX_MaskRun01((uint8_t *)Display.Buffer + g * Display.WIDTH + b0,
+        b1 - b0 + 1, (uint8_t)((0xFF << lo) & (0xFF >> (7 - hi))), action);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Move a block of pixels inside a monochromatic buffer. Pixels are
+            addressed as in BGFX_FillRect01: along A there are 8 pixels per
+            byte, least significant bit first, along B one byte per pixel,
+            Stride bytes from one group of 8 to the next. A destination byte
+            is built from at most two source bytes shifted by the move along
+            A, groups and bytes are visited in the order that reads every
+            byte before it is overwritten.
+    @param  Buffer  Monochromatic buffer
+    @param  Stride  Bytes from one group of 8 pixels to the next
+    @param  SrcA    First source pixel along A
+    @param  DstA    First destination pixel along A
+    @param  CountA  Number of pixels along A
+    @param  SrcB    First source pixel along B
+    @param  DstB    First destination pixel along B
+    @param  CountB  Number of pixels along B
+ */
+/**************************************************************************/
+static void BGFX_CopyBits01(uint8_t *Buffer, uint16_t Stride, int32_t SrcA,
+    int32_t DstA, int32_t CountA, int32_t SrcB, int32_t DstB, int32_t CountB)
 {
-  Display->Rotation = (Rotation & 3);
-  switch (Display->Rotation) {
-  case 0:
-  case 2:
-    Display->Width = Display->WIDTH;
-    Display->Height = Display->HEIGHT;
-    break;
-  case 1:
-  case 3:
-    Display->Width = Display->HEIGHT;
-    Display->Height = Display->WIDTH;
-    break;
+  int32_t move = DstA - SrcA;
+  int32_t g0 = DstA >> 3, g1 = (DstA + CountA - 1) >> 3;
+  int32_t q0 = SrcA >> 3, q1 = (SrcA + CountA - 1) >> 3;
+  int32_t g, q, i, j, first, last, step, base;
+  const uint8_t *lo, *hi;
+  uint8_t *dst, mask, v;
+  uint8_t shift;
+
+  step = (move > 0) ? -1 : 1;
+  first = (move > 0) ? g1 : g0;
+  last = (move > 0) ? g0 : g1;
+  for (g = first; g != last + step; g += step) {
+    mask = 0xFF;
+    if (g == g0) {
+      mask &= 0xFF << (DstA & 7);
+    }
+    if (g == g1) {
+      mask &= 0xFF >> (7 - ((DstA + CountA - 1) & 7));
+    }
+
+    /* Source of bit 0 of the group, rounded down to a whole byte */
+    base = g * 8 - move;
+    q = (base >= 0) ? base / 8 : -((7 - base) / 8);
+    shift = (uint8_t)(base - q * 8);
+    lo = ((q >= q0) && (q <= q1)) ? Buffer + q * Stride + SrcB : NULL;
+    hi = ((shift != 0) && (q + 1 >= q0) && (q + 1 <= q1)) ?
+        Buffer + (q + 1) * Stride + SrcB : NULL;
+    dst = Buffer + g * Stride + DstB;
+
+    if ((mask == 0xFF) && (shift == 0) && (lo != NULL)) {
+      memmove(dst, lo, CountB);
+      continue;
+    }
+    for (j = 0; j < CountB; j++) {
+      i = (DstB > SrcB) ? CountB - 1 - j : j;
+      v = 0;
+      if (lo != NULL) {
+        v = lo[i] >> shift;
+      }
+      if (hi != NULL) {
+        v |= hi[i] << (8 - shift);
+      }
+      dst[i] = (dst[i] & ~mask) | (v & mask);
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Set or clear the same bits in consecutive bytes, a 64-bit word
+            at a time
+    @param  Ptr     First byte
+    @param  Count   Number of bytes
+    @param  Mask    Bits to change in every byte
+    @param  Action  BGFX_BITS_SET, BGFX_BITS_CLEAR or BGFX_BITS_TOGGLE
+ */
+/**************************************************************************/
+static void BGFX_MaskRun01(uint8_t *Ptr, int32_t Count, uint8_t Mask,
+    uint8_t Action)
+{
+  uint64_t wide = 0x0101010101010101ULL * Mask;
+  uint64_t word;
+
+  if ((Mask == 0xFF) && (Action != BGFX_BITS_TOGGLE)) {
+    memset(Ptr, (Action == BGFX_BITS_SET) ? 0xFF : 0x00, Count);
+    return;
+  }
+
+  for (; Count >= 8; Count -= 8, Ptr += 8) {
+    memcpy(&word, Ptr, sizeof(word));
+    if (Action == BGFX_BITS_SET) {
+      word |= wide;
+    } else if (Action == BGFX_BITS_CLEAR) {
+      word &= ~wide;
+    } else {
+      word ^= wide;
+    }
+    memcpy(Ptr, &word, sizeof(word));
+  }
+  for (; Count > 0; Count--, Ptr++) {
+    if (Action == BGFX_BITS_SET) {
+      *Ptr |= Mask;
+    } else if (Action == BGFX_BITS_CLEAR) {
+      *Ptr &= ~Mask;
+    } else {
+      *Ptr ^= Mask;
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Tell what a raster operation does to monochromatic pixels
+    @param  color   Binary (on or off) color drawn
+    @param  RasterOp  Raster operation
+    @return One of the BGFX_BITS_ values
+ */
+/**************************************************************************/
+static uint8_t BGFX_Rop01(uint16_t color, BGFX_RasterOp_t RasterOp)
+{
+  switch (RasterOp) {
+  case BGFX_ROP_XOR:
+    return color ? BGFX_BITS_TOGGLE : BGFX_BITS_KEEP;
+  case BGFX_ROP_OR:
+    return color ? BGFX_BITS_SET : BGFX_BITS_KEEP;
+  case BGFX_ROP_AND:
+    return color ? BGFX_BITS_KEEP : BGFX_BITS_CLEAR;
+  case BGFX_ROP_INVERT:
+    return BGFX_BITS_TOGGLE;
+  default:
+    return color ? BGFX_BITS_SET : BGFX_BITS_CLEAR;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Combine a color with a pixel of an 8 or 16 bits buffer
+    @param  Dst     Pixel in the buffer
+    @param  color   Color drawn
+    @param  RasterOp  Raster operation
+    @return New pixel value
+ */
+/**************************************************************************/
+static uint16_t BGFX_Rop(uint16_t Dst, uint16_t color,
+    BGFX_RasterOp_t RasterOp)
+{
+  switch (RasterOp) {
+  case BGFX_ROP_XOR:
+    return Dst ^ color;
+  case BGFX_ROP_OR:
+    return Dst | color;
+  case BGFX_ROP_AND:
+    return Dst & color;
+  case BGFX_ROP_INVERT:
+    return ~Dst;
+  default:
+    return color;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Combine a color with 64 bits of pixels, see BGFX_Rop
+    @param  Dst     Pixels in the buffer
+    @param  Wide    Color repeated over the 64 bits
+    @param  RasterOp  Raster operation
+    @return New pixels value
+ */
+/**************************************************************************/
+static uint64_t BGFX_RopWord(uint64_t Dst, uint64_t Wide,
+    BGFX_RasterOp_t RasterOp)
+{
+  switch (RasterOp) {
+  case BGFX_ROP_XOR:
+    return Dst ^ Wide;
+  case BGFX_ROP_OR:
+    return Dst | Wide;
+  case BGFX_ROP_AND:
+    return Dst & Wide;
+  case BGFX_ROP_INVERT:
+    return ~Dst;
+  default:
+    return Wide;
   }
 }
 
@@ -509,11 +2674,44 @@ void BGFX_DrawPixel_01(uint16_t x, uint16_t y, uint16_t color,
   ptr = (uint8_t *)Display.Buffer;
   ptr += (x / 8) * Display.WIDTH + y;
 
-  if (color){
+  switch (BGFX_Rop01(color, Display.RasterOp)) {
+  case BGFX_BITS_SET:
     *ptr |= 1 << (x & 7);
-  }else{
+    break;
+  case BGFX_BITS_CLEAR:
     *ptr &= ~(1 << (x & 7));
+    break;
+  case BGFX_BITS_TOGGLE:
+    *ptr ^= 1 << (x & 7);
+    break;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Read a pixel from a monochromatic framebuffer
+    @param  x   x coordinate, rotation already applied
+    @param  y   y coordinate, rotation already applied
+    @param  Display Structure to display parameters and functions
+    @return 1 if the pixel is on, 0 otherwise
+ */
+/**************************************************************************/
+static uint16_t BGFX_GetPixel_01(uint16_t x, uint16_t y,
+    BGFX_Parameters_t Display)
+{
+  uint8_t *ptr;
+
+  if(Display.HeightPixelsOnWrite > 1 && Display.WidthPixelsOnWrite == 1)
+  {
+    /* There are 8 vertical pixels in one byte */
+    _swap_int16_t(x, y);
   }
+
+  ptr = (uint8_t *)Display.Buffer;
+  ptr += (x / 8) * Display.WIDTH + y;
+
+  return (*ptr >> (x & 7)) & 1;
 }
 
 
@@ -529,8 +2727,8 @@ void BGFX_DrawPixel_01(uint16_t x, uint16_t y, uint16_t color,
 void BGFX_DrawPixel_8(uint16_t x, uint16_t y, uint16_t color,
     BGFX_Parameters_t Display)
 {
-  uint8_t *p = (uint8_t *)Display.Buffer;
-  p[x + y * Display.WIDTH] = color & 0xFF;
+  uint8_t *p = (uint8_t *)Display.Buffer + x + y * Display.WIDTH;
+  *p = BGFX_Rop(*p, color, Display.RasterOp) & 0xFF;
 }
 
 
@@ -546,8 +2744,8 @@ void BGFX_DrawPixel_8(uint16_t x, uint16_t y, uint16_t color,
 void BGFX_DrawPixel_16(uint16_t x, uint16_t y, uint16_t color,
     BGFX_Parameters_t Display)
 {
-  uint16_t *p = (uint16_t *)Display.Buffer;
-  p[x + y * Display.WIDTH] = color;
+  uint16_t *p = (uint16_t *)Display.Buffer + x + y * Display.WIDTH;
+  *p = BGFX_Rop(*p, color, Display.RasterOp);
 }
 
 
@@ -581,21 +2779,12 @@ void BGFX_DrawCircleHelper(uint16_t x0, uint16_t y0, uint16_t r,
     x++;
     ddF_x += 2;
     f += ddF_x;
-    if (cornername & 0x4) {
-      BGFX_DrawPixel(x0 + x, y0 + y, color, Display);
-      BGFX_DrawPixel(x0 + y, y0 + x, color, Display);
-    }
-    if (cornername & 0x2) {
-      BGFX_DrawPixel(x0 + x, y0 - y, color, Display);
-      BGFX_DrawPixel(x0 + y, y0 - x, color, Display);
-    }
-    if (cornername & 0x8) {
-      BGFX_DrawPixel(x0 - y, y0 + x, color, Display);
-      BGFX_DrawPixel(x0 - x, y0 + y, color, Display);
-    }
-    if (cornername & 0x1) {
-      BGFX_DrawPixel(x0 - y, y0 - x, color, Display);
-      BGFX_DrawPixel(x0 - x, y0 - y, color, Display);
+    if ((x == 1) && (y == 0)) {
+      /* Radius 1: the only step is past the diagonal, drawn swapped as the
+       * pixels on the axes are not drawn here */
+      BGFX_CirclePoints(x0, y0, y, x, cornername, color, Display);
+    } else {
+      BGFX_CirclePoints(x0, y0, x, y, cornername, color, Display);
     }
   }
 }
@@ -637,22 +2826,22 @@ void BGFX_DrawCircleFillHelper(uint16_t x0, uint16_t y0, uint16_t r,
     ddF_x += 2;
     f += ddF_x;
     /* These checks avoid double-drawing certain lines, important
-     * for the SSD1306 library which has an INVERT drawing mode.
+     * for the XOR and INVERT raster operations (BGFX_SetRasterOp).
      */
     if (x < (y + 1)) {
       if (corners & 1){
-        BGFX_DrawLine(x0 + x, y0 - y, x0 + x, y0 + y + delta, color, Display);
+        BGFX_DrawVLine(x0 + x, y0 - y, 2 * y + delta, color, Display);
       }
       if (corners & 2){
-        BGFX_DrawLine(x0 - x, y0 - y, x0 - x, y0 + y + delta, color, Display);
+        BGFX_DrawVLine(x0 - x, y0 - y, 2 * y + delta, color, Display);
       }
     }
     if (y != py) {
       if (corners & 1){
-        BGFX_DrawLine(x0 + py, y0 - px, x0 + py, y0 + px + delta, color, Display);
+        BGFX_DrawVLine(x0 + py, y0 - px, 2 * px + delta, color, Display);
       }
       if (corners & 2){
-        BGFX_DrawLine(x0 - py, y0 - px, x0 - py, y0 + px + delta, color, Display);
+        BGFX_DrawVLine(x0 - py, y0 - px, 2 * px + delta, color, Display);
       }
       py = y;
     }
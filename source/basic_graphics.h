@@ -50,6 +50,11 @@
 #include "gfxfont.h"
 
 
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
 /**
  * @brief Types of display colors.
  */
@@ -60,9 +65,81 @@ typedef enum
   BGFX_16BITS,            /*!< 16-bits color display */
   BGFX_24BITS,            /*!< 24-bits color display */
   BGFX_RGB,               /*!< RGB color display */
+  BGFX_INDEXED8,          /*!< 8-bits palette indices, expanded at flush */
 }BGFX_ColorScheme_t;
 
 
+/**
+ * @brief Formats of the palette used by BGFX_INDEXED8.
+ */
+typedef enum
+{
+  BGFX_PALETTE_565 = 0,   /*!< 256 uint16_t entries, 5-6-5 */
+  BGFX_PALETTE_RGB888,    /*!< 256 uint32_t entries, 0x00RRGGBB */
+}BGFX_PaletteFormat_t;
+
+
+/**
+ * @brief How drawn pixels combine with the pixels already in the buffer.
+ *        Only applies to pixels written by the library to Buffer, a user
+ *        DrawPixel function always receives the color as given.
+ */
+typedef enum
+{
+  BGFX_ROP_COPY = 0,      /*!< Overwrite with the color (default) */
+  BGFX_ROP_XOR,           /*!< Exclusive or with the color, drawing twice erases */
+  BGFX_ROP_OR,            /*!< Or with the color */
+  BGFX_ROP_AND,           /*!< And with the color */
+  BGFX_ROP_INVERT,        /*!< Invert the pixels, the color is ignored */
+}BGFX_RasterOp_t;
+
+
+/**
+ * @brief Rectangular area, empty when W or H is 0 or less
+ */
+typedef struct
+{
+  int16_t X;            /*!< Top left corner x coordinate */
+  int16_t Y;            /*!< Top left corner y coordinate */
+  int16_t W;            /*!< Width in pixels */
+  int16_t H;            /*!< Height in pixels */
+}BGFX_Rect_t;
+
+
+#ifndef BGFX_CIRCLE_CACHE_ENTRIES
+#define BGFX_CIRCLE_CACHE_ENTRIES 8 /*!< Radii held by a circle cache */
+#endif
+
+
+/**
+ * @brief Span tables of one radius in a circle cache
+ */
+typedef struct
+{
+  int16_t Radius;       /*!< Radius of the tables, -1 if the entry is free */
+  uint16_t Steps;       /*!< Midpoint steps of the outline */
+  uint32_t Offset;      /*!< First table value in the arena */
+  uint32_t Size;        /*!< Number of table values, 2 * Radius + 1 */
+  uint32_t LastUse;     /*!< Cache clock at the last use */
+}BGFX_CircleTables_t;
+
+
+/**
+ * @brief Circle span tables kept by radius, least recently used radius
+ *        evicted first. Set up with BGFX_CircleCacheInit.
+ */
+typedef struct
+{
+  uint16_t *Arena;      /*!< Memory holding the tables */
+  uint32_t ArenaSize;   /*!< Size of the arena in uint16_t values */
+  uint32_t Top;         /*!< Values of the arena in use */
+  uint32_t Clock;       /*!< Incremented on every lookup */
+  uint32_t Hits;        /*!< Lookups that found their radius */
+  uint32_t Misses;      /*!< Lookups that had to compute their tables */
+  BGFX_CircleTables_t Tables[BGFX_CIRCLE_CACHE_ENTRIES]; /*!< Radii held */
+}BGFX_CircleCache_t;
+
+
 /**
  * @brief Structure with data related to the display
  */
@@ -84,6 +161,19 @@ typedef struct
 
   void (*DrawPixel)(uint16_t x, uint16_t y, uint16_t color); /*!< Writes pixel
                                                                  to a buffer */
+
+  const void *Palette;  /*!< 256 colors for BGFX_INDEXED8, use BGFX_SetPalette */
+  BGFX_PaletteFormat_t PaletteFormat; /*!< Format of the Palette entries */
+  BGFX_RasterOp_t RasterOp; /*!< Raster operation, use BGFX_SetRasterOp */
+  BGFX_Rect_t Clip;     /*!< Drawing is limited to this area, in screen
+                             coordinates, unless empty. Use BGFX_SetClip */
+  int16_t BandY;        /*!< First buffer row held by Buffer, see
+                             bgfx_band.h */
+  int16_t BandHeight;   /*!< Number of buffer rows held by Buffer, 0 when it
+                             holds the whole display */
+  BGFX_CircleCache_t *CircleCache; /*!< Span tables of circles and rounded
+                             rectangles, NULL if none. Use
+                             BGFX_SetCircleCache */
 }BGFX_Parameters_t;
 
 
@@ -114,6 +204,109 @@ void BGFX_DrawLine(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1,
     uint16_t color, BGFX_Parameters_t Display);
 
 
+/**************************************************************************/
+/*!
+    @brief  Draw a horizontal line. Rotation and borders are resolved once,
+            then the pixels are written straight into the buffer.
+    @param  x   Left-most point x coordinate
+    @param  y   Left-most point y coordinate
+    @param  w   Width in pixels
+    @param  color 16-bit 5-6-5 Color to draw with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawHLine(int16_t x, int16_t y, int16_t w, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a vertical line. Rotation and borders are resolved once,
+            then the pixels are written straight into the buffer.
+    @param  x   Top-most point x coordinate
+    @param  y   Top-most point y coordinate
+    @param  h   Height in pixels
+    @param  color 16-bit 5-6-5 Color to draw with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawVLine(int16_t x, int16_t y, int16_t h, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Write a horizontal run of pixels, each with its own color
+    @param  x   Left-most point x coordinate
+    @param  y   Left-most point y coordinate
+    @param  w   Width in pixels, number of entries in Colors
+    @param  Colors  Colors of the pixels, from left to right
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_WriteSpan(int16_t x, int16_t y, int16_t w, const uint16_t *Colors,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a horizontal line with a repeating on/off mask, for dashed
+            lines and pattern fills. Pixel x + i takes color when bit
+            (i % Length) of Bits is set, bg otherwise. The mask is applied a
+            32 pixels word at a time, a byte at a time on monochromatic
+            buffers.
+    @param  x   Left-most point x coordinate
+    @param  y   Left-most point y coordinate
+    @param  w   Width in pixels
+    @param  Bits    Mask, bit 0 for the left-most pixel
+    @param  Length  Number of bits in the mask, 1 to 32
+    @param  color   16-bit 5-6-5 Color of the set bits
+    @param  bg      16-bit 5-6-5 Color of the clear bits, if same as color,
+            the pixels of the clear bits are left unchanged
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawHLineBits(int16_t x, int16_t y, int16_t w, uint32_t Bits,
+    uint8_t Length, uint16_t color, uint16_t bg, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a vertical line with a repeating on/off mask, see
+            BGFX_DrawHLineBits
+    @param  x   Top-most point x coordinate
+    @param  y   Top-most point y coordinate
+    @param  h   Height in pixels
+    @param  Bits    Mask, bit 0 for the top-most pixel
+    @param  Length  Number of bits in the mask, 1 to 32
+    @param  color   16-bit 5-6-5 Color of the set bits
+    @param  bg      16-bit 5-6-5 Color of the clear bits, if same as color,
+            the pixels of the clear bits are left unchanged
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawVLineBits(int16_t x, int16_t y, int16_t h, uint32_t Bits,
+    uint8_t Length, uint16_t color, uint16_t bg, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Copy a rectangle of pixels to another position of the buffer,
+            the two may overlap (scrolling). Destination pixels outside the
+            clip rectangle are not written, those whose source is outside
+            the display or the band are left as they are. The raster
+            operation is not applied. Does nothing without a buffer or with
+            a user DrawPixel function, since pixels cannot be read back.
+    @param  Src     Rectangle to copy, screen coordinates
+    @param  x       Destination top left corner x coordinate
+    @param  y       Destination top left corner y coordinate
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_CopyArea(BGFX_Rect_t Src, int16_t x, int16_t y,
+    BGFX_Parameters_t Display);
+
+
 /**************************************************************************/
 /*!
     @brief    Draw a rectangle with no fill color
@@ -145,6 +338,67 @@ void BGFX_DrawRectFill(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
     uint16_t color, BGFX_Parameters_t Display);
 
 
+/**************************************************************************/
+/*!
+    @brief  Draw many pixels with one color, same result as BGFX_DrawPixel
+            on each in turn. Rotation and clipping are resolved once for the
+            batch, then each point is one buffer index computation.
+    @param  Points  Points as x, y pairs, 2 * Count values
+    @param  Count   Number of points
+    @param  color   16-bit 5-6-5 Color to draw with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawPoints(const int16_t *Points, uint16_t Count, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw many lines with one color, same pixels as BGFX_DrawLine on
+            each in turn. Rotation and clipping are resolved once for the
+            batch.
+    @param  Lines   Lines as x0, y0, x1, y1 quadruples, 4 * Count values
+    @param  Count   Number of lines
+    @param  color   16-bit 5-6-5 Color to draw with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawLines(const int16_t *Lines, uint16_t Count, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill many rectangles with one color, same result as
+            BGFX_DrawRectFill on each in turn. Rotation and clipping are
+            resolved once for the batch, each rectangle is written along the
+            buffer rows.
+    @param  Rects   Rectangles
+    @param  Count   Number of rectangles
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_FillRects(const BGFX_Rect_t *Rects, uint16_t Count, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw many rectangle outlines with one color, same result as
+            BGFX_DrawRect on each in turn. Rotation and clipping are
+            resolved once for the batch.
+    @param  Rects   Rectangles
+    @param  Count   Number of rectangles
+    @param  color   16-bit 5-6-5 Color to draw with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawRects(const BGFX_Rect_t *Rects, uint16_t Count, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
 /**************************************************************************/
 /*!
     @brief  Draw a rounded rectangle with no fill color
@@ -287,4 +541,184 @@ void BGFX_SendString(uint16_t X, uint16_t Y, uint8_t *Buffer, uint32_t Length,
 /**************************************************************************/
 void BGFX_SetRotation(uint8_t Rotation, BGFX_Parameters_t *Display);
 
+
+/**************************************************************************/
+/*!
+    @brief  Read a pixel back from the canvas framebuffer
+    @param  x   x coordinate
+    @param  y   y coordinate
+    @param  Display Structure to display parameters and functions
+    @return Color stored at (x, y), or 0 if out of border or unbuffered
+ */
+/**************************************************************************/
+uint16_t BGFX_GetPixel(uint16_t x, uint16_t y, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the size in bytes of the framebuffer the display needs
+    @param  Display Structure to display parameters and functions
+    @return Buffer size in bytes, or 0 if the color scheme is not implemented
+ */
+/**************************************************************************/
+uint32_t BGFX_GetBufferSize(BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Grow a rectangle to also cover another one
+    @param  Dst Rectangle to grow, may be empty
+    @param  Src Rectangle to add, ignored if empty
+ */
+/**************************************************************************/
+void BGFX_RectUnion(BGFX_Rect_t *Dst, BGFX_Rect_t Src);
+
+
+/**************************************************************************/
+/*!
+    @brief  Shrink a rectangle to the part it shares with another one
+    @param  Dst Rectangle to shrink, left empty if they do not overlap
+    @param  Src Rectangle to intersect with
+ */
+/**************************************************************************/
+void BGFX_RectIntersect(BGFX_Rect_t *Dst, BGFX_Rect_t Src);
+
+
+/**************************************************************************/
+/*!
+    @brief  Convert a rectangle from screen coordinates to buffer
+            (unrotated) coordinates, clipped to the display. Flush and
+            composition functions work in buffer coordinates.
+    @param  Rect    Rectangle in screen coordinates
+    @param  Display Structure to display parameters and functions
+    @return Rectangle in buffer coordinates, empty if outside the display
+ */
+/**************************************************************************/
+BGFX_Rect_t BGFX_RectToBuffer(BGFX_Rect_t Rect, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Limit the next drawings to a rectangle. Primitives entirely
+            outside are rejected before any pixel is computed.
+    @param  Clip    Area in screen coordinates, an empty rectangle removes
+            the limit
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SetClip(BGFX_Rect_t Clip, BGFX_Parameters_t *Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Get the area drawings can reach: the display, the clip
+            rectangle and, when rendering in bands, the current band
+    @param  Display Structure to display parameters and functions
+    @return Area in screen coordinates, empty if nothing can be drawn
+ */
+/**************************************************************************/
+BGFX_Rect_t BGFX_GetClip(BGFX_Parameters_t Display);
+
+
+
+/**************************************************************************/
+/*!
+    @brief  Set up a circle cache. A radius r takes 2 * r + 1 values of the
+            arena, radii that do not fit are drawn without the cache.
+    @param  Cache   Cache to set up, empty
+    @param  Arena   Memory for the tables, 2 bytes aligned
+    @param  Size    Size of the arena in bytes
+ */
+/**************************************************************************/
+void BGFX_CircleCacheInit(BGFX_CircleCache_t *Cache, void *Arena,
+    uint32_t Size);
+
+
+/**************************************************************************/
+/*!
+    @brief  Have circles and rounded rectangles drawn from span tables kept
+            by radius: filled shapes as one horizontal span per row, and on
+            8 and 16 bits buffers outlines as horizontal and vertical runs.
+            The pixels are the same as without the cache.
+    @param  Cache   Cache, NULL to compute every shape again
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SetCircleCache(BGFX_CircleCache_t *Cache,
+    BGFX_Parameters_t *Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Attach a palette to a BGFX_INDEXED8 display. Changing it recolors
+            the next flush without redrawing anything.
+    @param  Palette 256 entries, uint16_t for BGFX_PALETTE_565 or uint32_t
+            for BGFX_PALETTE_RGB888. Stored by reference, not copied.
+    @param  Format  Format of the palette entries, and of the expanded pixels
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SetPalette(const void *Palette, BGFX_PaletteFormat_t Format,
+    BGFX_Parameters_t *Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Select how the next drawings combine with the buffer content.
+            On monochromatic displays any nonzero color is a set bit.
+            Rectangle, circle, rounded rectangle and triangle outlines
+            draw each of their pixels once, so XOR shows them whole.
+    @param  RasterOp  Raster operation
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SetRasterOp(BGFX_RasterOp_t RasterOp, BGFX_Parameters_t *Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Expand a run of palette indices to 5-6-5 colors
+    @param  Src     Palette indices
+    @param  Dst     Expanded colors, Count uint16_t
+    @param  Count   Number of pixels
+    @param  Palette 256 entries 5-6-5 palette
+ */
+/**************************************************************************/
+void BGFX_ExpandRow565(const uint8_t *Src, uint16_t *Dst, uint32_t Count,
+    const uint16_t *Palette);
+
+
+/**************************************************************************/
+/*!
+    @brief  Expand a run of palette indices to RGB888 colors
+    @param  Src     Palette indices
+    @param  Dst     Expanded colors, 3 bytes per pixel in R, G, B order
+    @param  Count   Number of pixels
+    @param  Palette 256 entries 0x00RRGGBB palette
+ */
+/**************************************************************************/
+void BGFX_ExpandRow888(const uint8_t *Src, uint8_t *Dst, uint32_t Count,
+    const uint32_t *Palette);
+
+
+/**************************************************************************/
+/*!
+    @brief  Expand an area of a BGFX_INDEXED8 buffer to the panel format,
+            ready to be sent to the display. Rows of Dst are packed.
+    @param  x   Top left corner x coordinate, in buffer (unrotated) space
+    @param  y   Top left corner y coordinate, in buffer (unrotated) space
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  Dst Destination, w * h uint16_t for BGFX_PALETTE_565 or
+            w * h * 3 bytes for BGFX_PALETTE_RGB888
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_ExpandPalette(uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+    void *Dst, BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* BASIC_GRAPHICS_H */
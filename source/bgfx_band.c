@@ -0,0 +1,106 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_band.h"
+
+
+static uint8_t BGFX_IsPaged(BGFX_Parameters_t Display);
+
+static void BGFX_BandClear(uint16_t Background, BGFX_Parameters_t Display);
+
+
+
+uint32_t BGFX_GetBandSize(uint16_t Rows, BGFX_Parameters_t Display)
+{
+  switch (Display.ColorScheme) {
+  case BGFX_MONOCHROMATIC:
+    return (uint32_t)((Rows + 7) / 8) * Display.WIDTH;
+  case BGFX_8BITS:
+  case BGFX_INDEXED8:
+    return (uint32_t)Display.WIDTH * Rows;
+  case BGFX_16BITS:
+    return (uint32_t)Display.WIDTH * Rows * sizeof(uint16_t);
+  default:
+    return 0;
+  }
+}
+
+
+
+
+int BGFX_RenderBands(void *Buffer, uint16_t Rows, uint16_t Background,
+    BGFX_BandDraw_t Draw, BGFX_BandFlush_t Flush, void *Context,
+    BGFX_Parameters_t Display)
+{
+  uint16_t y;
+
+  if ((Buffer == NULL) || (Rows == 0) || (Draw == NULL) || (Flush == NULL) ||
+      (Display.DrawPixel != NULL) ||
+      (BGFX_GetBandSize(Rows, Display) == 0))
+  {
+    return -1;
+  }
+  if ((Display.ColorScheme == BGFX_MONOCHROMATIC) &&
+      (!BGFX_IsPaged(Display) || ((Rows & 7) != 0)))
+  {
+    return -1;
+  }
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  Display.Buffer = Buffer;
+  for (y = 0; y < Display.HEIGHT; y += Rows) {
+    Display.BandY = y;
+    Display.BandHeight = (Display.HEIGHT - y < Rows) ?
+        Display.HEIGHT - y : Rows;
+    BGFX_BandClear(Background, Display);
+    Draw(Display, Context);
+    Flush(Buffer, y, Display.BandHeight, Context);
+  }
+
+  return 0;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Tell if a monochromatic display stores 8 vertical pixels per
+            byte, so that a band of rows is a run of whole pages
+    @param  Display Structure to display parameters and functions
+    @return 1 for the vertical pages layout
+ */
+/**************************************************************************/
+static uint8_t BGFX_IsPaged(BGFX_Parameters_t Display)
+{
+  return (Display.HeightPixelsOnWrite > 1) &&
+      (Display.WidthPixelsOnWrite == 1);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill the current band with one color, raster operation ignored
+    @param  Background  Color to fill with
+    @param  Display Structure to display parameters, band set
+ */
+/**************************************************************************/
+static void BGFX_BandClear(uint16_t Background, BGFX_Parameters_t Display)
+{
+  uint32_t size = BGFX_GetBandSize(Display.BandHeight, Display);
+  uint16_t *p;
+  uint32_t i;
+
+  switch (Display.ColorScheme) {
+  case BGFX_MONOCHROMATIC:
+    memset(Display.Buffer, Background ? 0xFF : 0x00, size);
+    break;
+  case BGFX_16BITS:
+    p = (uint16_t *)Display.Buffer;
+    for (i = 0; i < size / sizeof(uint16_t); i++) {
+      p[i] = Background;
+    }
+    break;
+  default:
+    memset(Display.Buffer, Background & 0xFF, size);
+    break;
+  }
+}
@@ -0,0 +1,96 @@
+/**
+ * @file  bgfx_band.h
+ * @date  19-October-2026
+ * @brief Band rendering: full screen drawing with a buffer of a few lines.
+ *
+ * @author
+ * @author
+ *
+ * The application draws its frame in a callback instead of into a full
+ * display buffer. BGFX_RenderBands calls it once per band of N buffer rows,
+ * with Display.Buffer pointing to the small band buffer and the band set as
+ * the drawable area (see BGFX_GetClip), then hands the band to a flush
+ * callback. Primitives entirely outside the band are rejected from their
+ * bounding box, the others are clipped to it, so a frame costs about one
+ * pass of drawing plus one rejection test per primitive and band.
+ *
+ * A 320x240 BGFX_16BITS frame drawn in bands of 16 rows needs 10 KB instead
+ * of 150 KB. Bands are made of buffer (unrotated) rows, ready to be sent to
+ * a display window of WIDTH x N pixels, whatever the rotation.
+ *
+ * The draw callback must only draw: it runs once per band, so anything else
+ * it does (moving an animation, pushing chart samples) would happen several
+ * times per frame. Functions that read back or move pixels already in the
+ * buffer only see the current band. Monochromatic displays need the
+ * vertical pages layout and a multiple of 8 rows per band.
+ */
+
+#ifndef BGFX_BAND_H
+#define BGFX_BAND_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Draws the frame, called once per band
+ * @param Display Display parameters with the band buffer and clip set,
+ *        to be passed to the drawing functions
+ * @param Context Pointer given to BGFX_RenderBands
+ */
+typedef void (*BGFX_BandDraw_t)(BGFX_Parameters_t Display, void *Context);
+
+/**
+ * @brief Sends a band to the display, called after it is drawn
+ * @param Buffer  Band buffer, Rows full buffer rows of WIDTH pixels
+ * @param y       First buffer row of the band
+ * @param Rows    Number of buffer rows in the band
+ * @param Context Pointer given to BGFX_RenderBands
+ */
+typedef void (*BGFX_BandFlush_t)(const void *Buffer, uint16_t y,
+    uint16_t Rows, void *Context);
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the size in bytes of a band buffer
+    @param  Rows    Number of buffer rows in a band
+    @param  Display Structure to display parameters and functions
+    @return Band buffer size in bytes, or 0 if the color scheme is not
+            implemented
+ */
+/**************************************************************************/
+uint32_t BGFX_GetBandSize(uint16_t Rows, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a whole frame band by band. Each band is cleared to the
+            background color, drawn by Draw and sent by Flush.
+    @param  Buffer  Band buffer, see BGFX_GetBandSize
+    @param  Rows    Number of buffer rows in a band, a multiple of 8 on
+            monochromatic displays. The last band may be shorter.
+    @param  Background  Color the bands are cleared with
+    @param  Draw    Draws the frame
+    @param  Flush   Sends a band to the display
+    @param  Context Passed to Draw and Flush
+    @param  Display Structure to display parameters and functions, Buffer
+            is ignored
+    @return 0 on success, -1 if the display cannot be rendered in bands
+ */
+/**************************************************************************/
+int BGFX_RenderBands(void *Buffer, uint16_t Rows, uint16_t Background,
+    BGFX_BandDraw_t Draw, BGFX_BandFlush_t Flush, void *Context,
+    BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_BAND_H */
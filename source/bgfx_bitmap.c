@@ -0,0 +1,480 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_bitmap.h"
+
+
+#define BGFX_BLIT_CHUNK 64 /*!< Pixels sampled and written at a time */
+
+
+/* sin(d) in 16.16 fixed point, d from 0 to 90 degrees */
+static const int32_t BGFX_Sine[91] = {
+  0, 1144, 2287, 3430, 4572, 5712, 6850, 7987,
+  9121, 10252, 11380, 12505, 13626, 14742, 15855, 16962,
+  18064, 19161, 20252, 21336, 22415, 23486, 24550, 25607,
+  26656, 27697, 28729, 29753, 30767, 31772, 32768, 33754,
+  34729, 35693, 36647, 37590, 38521, 39441, 40348, 41243,
+  42126, 42995, 43852, 44695, 45525, 46341, 47143, 47930,
+  48703, 49461, 50203, 50931, 51643, 52339, 53020, 53684,
+  54332, 54963, 55578, 56175, 56756, 57319, 57865, 58393,
+  58903, 59396, 59870, 60326, 60764, 61183, 61584, 61966,
+  62328, 62672, 62997, 63303, 63589, 63856, 64104, 64332,
+  64540, 64729, 64898, 65048, 65177, 65287, 65376, 65446,
+  65496, 65526, 65536,
+};
+
+
+static void BGFX_Blit(const BGFX_Image_t *Image, BGFX_Rect_t Box,
+    int64_t U0, int64_t V0, int32_t DuDx, int32_t DvDx, int32_t DuDy,
+    int32_t DvDy, BGFX_Sampling_t Sampling, BGFX_Parameters_t Display);
+
+static void BGFX_BlitRange(int64_t S, int32_t Step, int32_t Limit,
+    int32_t *T0, int32_t *T1);
+
+static void BGFX_BlitSample(const BGFX_Image_t *Image, uint32_t U,
+    uint32_t V, int32_t DuDx, int32_t DvDx, int32_t Count, uint8_t Bilinear,
+    uint16_t *Out);
+
+static void BGFX_BlitTaps(int32_t S, uint16_t Size, uint8_t Bits,
+    int32_t *I0, int32_t *I1, uint32_t *Weight);
+
+static void BGFX_BlitWrite(const BGFX_Image_t *Image, int16_t x, int16_t y,
+    int32_t Count, const uint16_t *Values, BGFX_Parameters_t Display);
+
+static uint8_t BGFX_Gray565(uint16_t c);
+
+static void BGFX_SinCos(int16_t Angle, int32_t *Sin, int32_t *Cos);
+
+
+
+void BGFX_DrawBitmapScaled(const BGFX_Image_t *Image, BGFX_Rect_t Dst,
+    BGFX_Sampling_t Sampling, BGFX_Parameters_t Display)
+{
+  int32_t du_dx, dv_dy;
+
+  /* Image positions are 16.16 in 32 bits */
+  if ((Dst.W <= 0) || (Dst.H <= 0) || (Image->Width > INT16_MAX) ||
+      (Image->Height > INT16_MAX)) {
+    return;
+  }
+
+  /* Image pixels per display pixel, first sample at half a step */
+  du_dx = ((int32_t)Image->Width << 16) / Dst.W;
+  dv_dy = ((int32_t)Image->Height << 16) / Dst.H;
+  BGFX_Blit(Image, Dst, du_dx / 2, dv_dy / 2, du_dx, 0, 0, dv_dy, Sampling,
+      Display);
+}
+
+
+
+
+void BGFX_DrawBitmapRotated(const BGFX_Image_t *Image, BGFX_Rect_t Dst,
+    int16_t Angle, BGFX_Sampling_t Sampling, BGFX_Parameters_t Display)
+{
+  int32_t s, c, kx, ky, hx, hy;
+  int32_t du_dx, du_dy, dv_dx, dv_dy;
+  int64_t cx, cy, ex, ey, x0, y0, x1, y1, u0, v0;
+  BGFX_Rect_t box, clip;
+
+  if ((Dst.W <= 0) || (Dst.H <= 0) || (Image->Width > INT16_MAX) ||
+      (Image->Height > INT16_MAX)) {
+    return;
+  }
+
+  /* Display to image mapping: rotated back by Angle around the center,
+   * then scaled to image pixels */
+  BGFX_SinCos(Angle, &s, &c);
+  kx = ((int32_t)Image->Width << 16) / Dst.W;
+  ky = ((int32_t)Image->Height << 16) / Dst.H;
+  du_dx = (int32_t)(((int64_t)kx * c) >> 16);
+  du_dy = (int32_t)(((int64_t)kx * s) >> 16);
+  dv_dx = (int32_t)(-((int64_t)ky * s) >> 16);
+  dv_dy = (int32_t)(((int64_t)ky * c) >> 16);
+
+  /* Bounding box of the rotated rectangle, 16.16, kept to the clip area
+   * so it fits a BGFX_Rect_t */
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+  cx = (int64_t)Dst.X * 65536 + ((int64_t)Dst.W << 15);
+  cy = (int64_t)Dst.Y * 65536 + ((int64_t)Dst.H << 15);
+  ex = ((int64_t)Dst.W * abs(c) + (int64_t)Dst.H * abs(s)) >> 1;
+  ey = ((int64_t)Dst.W * abs(s) + (int64_t)Dst.H * abs(c)) >> 1;
+  x0 = (cx - ex) >> 16;
+  y0 = (cy - ey) >> 16;
+  x1 = (cx + ex + 0xFFFF) >> 16;
+  y1 = (cy + ey + 0xFFFF) >> 16;
+  x0 = (x0 < clip.X) ? clip.X : x0;
+  y0 = (y0 < clip.Y) ? clip.Y : y0;
+  x1 = (x1 > clip.X + clip.W) ? clip.X + clip.W : x1;
+  y1 = (y1 > clip.Y + clip.H) ? clip.Y + clip.H : y1;
+  if ((x1 <= x0) || (y1 <= y0)) {
+    return;
+  }
+  box.X = (int16_t)x0;
+  box.Y = (int16_t)y0;
+  box.W = (int16_t)(x1 - x0);
+  box.H = (int16_t)(y1 - y0);
+
+  /* Image position under the center of the top left pixel of the box. The
+   * offsets from the center are whole half pixels, counted as such to keep
+   * the products small */
+  hx = 2 * ((int32_t)box.X - Dst.X) + 1 - Dst.W;
+  hy = 2 * ((int32_t)box.Y - Dst.Y) + 1 - Dst.H;
+  u0 = (((int64_t)du_dx * hx + (int64_t)du_dy * hy) >> 1) +
+      ((int64_t)Image->Width << 15);
+  v0 = (((int64_t)dv_dx * hx + (int64_t)dv_dy * hy) >> 1) +
+      ((int64_t)Image->Height << 15);
+
+  BGFX_Blit(Image, box, u0, v0, du_dx, dv_dx, du_dy, dv_dy, Sampling,
+      Display);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw the pixels of a box whose centers fall inside the image,
+            for an affine display to image mapping
+    @param  Image   Image to draw
+    @param  Box     Display area to scan, screen coordinates
+    @param  U0  Image x under the center of the top left pixel of Box, 16.16
+    @param  V0  Image y under the center of the top left pixel of Box, 16.16
+    @param  DuDx    Image x increment per display pixel to the right
+    @param  DvDx    Image y increment per display pixel to the right
+    @param  DuDy    Image x increment per display row down
+    @param  DvDy    Image y increment per display row down
+    @param  Sampling  Nearest or bilinear
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_Blit(const BGFX_Image_t *Image, BGFX_Rect_t Box,
+    int64_t U0, int64_t V0, int32_t DuDx, int32_t DvDx, int32_t DuDy,
+    int32_t DvDy, BGFX_Sampling_t Sampling, BGFX_Parameters_t Display)
+{
+  uint16_t values[BGFX_BLIT_CHUNK];
+  int32_t limit_u = (int32_t)Image->Width << 16;
+  int32_t limit_v = (int32_t)Image->Height << 16;
+  int16_t ox = Box.X, oy = Box.Y;
+  int64_t u, v;
+  int32_t row, t0, t1, t, n;
+  uint8_t bilinear;
+
+  if ((Image->Pixels == NULL) || (Image->Width == 0) ||
+      (Image->Height == 0))
+  {
+    return;
+  }
+  bilinear = (Sampling == BGFX_SAMPLE_BILINEAR) && !Image->Keyed &&
+      ((Image->Format == BGFX_16BITS) || (Image->Format == BGFX_8BITS));
+
+  /* Only the drawable part of the box is scanned */
+  BGFX_RectIntersect(&Box, BGFX_GetClip(Display));
+  if ((Box.W <= 0) || (Box.H <= 0)) {
+    return;
+  }
+
+  for (row = Box.Y; row < Box.Y + Box.H; row++) {
+    u = U0 + (int64_t)(row - oy) * DuDy + (int64_t)(Box.X - ox) * DuDx;
+    v = V0 + (int64_t)(row - oy) * DvDy + (int64_t)(Box.X - ox) * DvDx;
+
+    /* Pixels of the row whose centers land inside the image */
+    t0 = 0;
+    t1 = Box.W;
+    BGFX_BlitRange(u, DuDx, limit_u, &t0, &t1);
+    BGFX_BlitRange(v, DvDx, limit_v, &t0, &t1);
+
+    for (t = t0; t < t1; t += n) {
+      n = (t1 - t < BGFX_BLIT_CHUNK) ? t1 - t : BGFX_BLIT_CHUNK;
+      /* Inside the image from here: positions fit 32 bits */
+      BGFX_BlitSample(Image, (uint32_t)(u + (int64_t)t * DuDx),
+          (uint32_t)(v + (int64_t)t * DvDx), DuDx, DvDx, n, bilinear,
+          values);
+      BGFX_BlitWrite(Image, Box.X + t, row, n, values, Display);
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Narrow a range of steps to the ones that stay inside an image
+            axis: 0 <= S + t * Step < Limit
+    @param  S       Position at step 0, 16.16
+    @param  Step    Increment per step, 16.16
+    @param  Limit   Size of the axis, 16.16
+    @param  T0  First step of the range, moved forward if needed
+    @param  T1  Step after the range, moved back if needed
+ */
+/**************************************************************************/
+static void BGFX_BlitRange(int64_t S, int32_t Step, int32_t Limit,
+    int32_t *T0, int32_t *T1)
+{
+  int64_t lo, hi;
+
+  if (Step == 0) {
+    if ((S < 0) || (S >= Limit)) {
+      *T1 = *T0;
+    }
+    return;
+  }
+
+  if (Step > 0) {
+    /* t >= -S / Step and t < (Limit - S) / Step, rounded up */
+    lo = -S + Step - 1;
+    hi = (int64_t)Limit - S + Step - 1;
+    lo = (lo >= 0) ? lo / Step : -((-lo + Step - 1) / Step);
+    hi = (hi >= 0) ? hi / Step : -((-hi + Step - 1) / Step);
+  } else {
+    /* t <= S / -Step and t > (S - Limit) / -Step, rounded down */
+    Step = -Step;
+    lo = S - Limit;
+    hi = S;
+    lo = ((lo >= 0) ? lo / Step : -((-lo + Step - 1) / Step)) + 1;
+    hi = ((hi >= 0) ? hi / Step : -((-hi + Step - 1) / Step)) + 1;
+  }
+
+  if (lo > *T0) {
+    *T0 = (lo > *T1) ? *T1 : (int32_t)lo;
+  }
+  if (hi < *T1) {
+    *T1 = (hi < *T0) ? *T0 : (int32_t)hi;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Pick image values along a line, all inside the image
+    @param  Image   Image to sample
+    @param  U   Image x of the first sample, 16.16
+    @param  V   Image y of the first sample, 16.16
+    @param  DuDx    Image x increment per sample
+    @param  DvDx    Image y increment per sample
+    @param  Count   Number of samples
+    @param  Bilinear  If set, blend the 4 nearest pixels
+    @param  Out     Returns the values, in the image format
+ */
+/**************************************************************************/
+static void BGFX_BlitSample(const BGFX_Image_t *Image, uint32_t U,
+    uint32_t V, int32_t DuDx, int32_t DvDx, int32_t Count, uint8_t Bilinear,
+    uint16_t *Out)
+{
+  const uint8_t *base = (const uint8_t *)Image->Pixels;
+  uint32_t stride = Image->Stride;
+  int32_t i, x0, x1, y0, y1;
+  uint32_t fx, fy, a, b, c, d;
+  const uint8_t *r0, *r1;
+
+  switch (Image->Format) {
+  case BGFX_16BITS:
+    stride = stride ? stride : Image->Width * sizeof(uint16_t);
+    if (!Bilinear) {
+      for (i = 0; i < Count; i++, U += DuDx, V += DvDx) {
+        Out[i] = ((const uint16_t *)(base + (V >> 16) * stride))[U >> 16];
+      }
+      break;
+    }
+    for (i = 0; i < Count; i++, U += DuDx, V += DvDx) {
+      BGFX_BlitTaps(U, Image->Width, 5, &x0, &x1, &fx);
+      BGFX_BlitTaps(V, Image->Height, 5, &y0, &y1, &fy);
+      r0 = base + y0 * stride;
+      r1 = base + y1 * stride;
+      /* Green, red and blue spread apart, weights of 5 bits */
+      a = ((const uint16_t *)r0)[x0];
+      b = ((const uint16_t *)r0)[x1];
+      c = ((const uint16_t *)r1)[x0];
+      d = ((const uint16_t *)r1)[x1];
+      a = (a | (a << 16)) & 0x07E0F81F;
+      b = (b | (b << 16)) & 0x07E0F81F;
+      c = (c | (c << 16)) & 0x07E0F81F;
+      d = (d | (d << 16)) & 0x07E0F81F;
+      a = ((a * (32 - fx) + b * fx) >> 5) & 0x07E0F81F;
+      c = ((c * (32 - fx) + d * fx) >> 5) & 0x07E0F81F;
+      a = ((a * (32 - fy) + c * fy) >> 5) & 0x07E0F81F;
+      Out[i] = (uint16_t)(a | (a >> 16));
+    }
+    break;
+
+  case BGFX_8BITS:
+  case BGFX_INDEXED8:
+    stride = stride ? stride : Image->Width;
+    if (!Bilinear) {
+      for (i = 0; i < Count; i++, U += DuDx, V += DvDx) {
+        Out[i] = (base + (V >> 16) * stride)[U >> 16];
+      }
+      break;
+    }
+    for (i = 0; i < Count; i++, U += DuDx, V += DvDx) {
+      BGFX_BlitTaps(U, Image->Width, 8, &x0, &x1, &fx);
+      BGFX_BlitTaps(V, Image->Height, 8, &y0, &y1, &fy);
+      r0 = base + y0 * stride;
+      r1 = base + y1 * stride;
+      a = (r0[x0] * (256 - fx) + r0[x1] * fx) >> 8;
+      c = (r1[x0] * (256 - fx) + r1[x1] * fx) >> 8;
+      Out[i] = (uint16_t)((a * (256 - fy) + c * fy) >> 8);
+    }
+    break;
+
+  default:
+    stride = stride ? stride : (uint32_t)(Image->Width + 7) / 8;
+    for (i = 0; i < Count; i++, U += DuDx, V += DvDx) {
+      x0 = U >> 16;
+      Out[i] = ((base + (V >> 16) * stride)[x0 >> 3] >> (7 - (x0 & 7))) & 1;
+    }
+    break;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Find the two pixels and the weight of the second one for a
+            bilinear sample along an axis, clamped at the image edges
+    @param  S       Sample position, 16.16, inside the image
+    @param  Size    Size of the axis in pixels
+    @param  Bits    Precision of the weight
+    @param  I0      Returns the first pixel
+    @param  I1      Returns the second pixel
+    @param  Weight  Returns the weight of I1, 0 to 2 ^ Bits - 1
+ */
+/**************************************************************************/
+static void BGFX_BlitTaps(int32_t S, uint16_t Size, uint8_t Bits,
+    int32_t *I0, int32_t *I1, uint32_t *Weight)
+{
+  /* Pixel centers are at .5, the blend is between the two around S */
+  S -= 0x8000;
+  *I0 = S >> 16;
+  *Weight = (S >> (16 - Bits)) & ((1u << Bits) - 1);
+  if (*I0 < 0) {
+    *I0 = 0;
+    *Weight = 0;
+  }
+  *I1 = *I0 + (*I0 < Size - 1);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Convert sampled values to the display format and write them,
+            skipping the color key
+    @param  Image   Image the values come from
+    @param  x   Screen x coordinate of the first value
+    @param  y   Screen y coordinate
+    @param  Count   Number of values
+    @param  Values  Values in the image format
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_BlitWrite(const BGFX_Image_t *Image, int16_t x, int16_t y,
+    int32_t Count, const uint16_t *Values, BGFX_Parameters_t Display)
+{
+  uint16_t colors[BGFX_BLIT_CHUNK];
+  const uint16_t *palette = Image->Palette;
+  int32_t i, j;
+  uint16_t g;
+
+  if (Image->Format == BGFX_MONOCHROMATIC) {
+    for (i = 0; i < Count; i++) {
+      colors[i] = Values[i] ? Image->Foreground : Image->Background;
+    }
+  } else if ((Display.ColorScheme == BGFX_INDEXED8) ||
+      (Display.ColorScheme == Image->Format))
+  {
+    memcpy(colors, Values, Count * sizeof(uint16_t));
+  } else if (Display.ColorScheme == BGFX_16BITS) {
+    for (i = 0; i < Count; i++) {
+      if ((Image->Format == BGFX_INDEXED8) && (palette != NULL)) {
+        colors[i] = palette[Values[i] & 0xFF];
+      } else {
+        g = Values[i] & 0xFF;
+        colors[i] = ((g >> 3) << 11) | ((g >> 2) << 5) | (g >> 3);
+      }
+    }
+  } else {
+    /* Grayscale, thresholded for monochromatic displays */
+    for (i = 0; i < Count; i++) {
+      if (Image->Format == BGFX_16BITS) {
+        g = BGFX_Gray565(Values[i]);
+      } else if ((Image->Format == BGFX_INDEXED8) && (palette != NULL)) {
+        g = BGFX_Gray565(palette[Values[i] & 0xFF]);
+      } else {
+        g = Values[i] & 0xFF;
+      }
+      colors[i] = (Display.ColorScheme == BGFX_8BITS) ? g : (g >= 128);
+    }
+  }
+
+  if (!Image->Keyed) {
+    BGFX_WriteSpan(x, y, Count, colors, Display);
+    return;
+  }
+  for (i = 0; i < Count; i = j + 1) {
+    for (j = i; (j < Count) && (Values[j] != Image->Key); j++) {
+    }
+    if (j > i) {
+      BGFX_WriteSpan(x + i, y, j - i, &colors[i], Display);
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Brightness of a 5-6-5 color
+    @param  c   5-6-5 color
+    @return 8-bit gray level
+ */
+/**************************************************************************/
+static uint8_t BGFX_Gray565(uint16_t c)
+{
+  uint32_t r = ((c >> 11) & 0x1F) * 255 / 31;
+  uint32_t g = ((c >> 5) & 0x3F) * 255 / 63;
+  uint32_t b = (c & 0x1F) * 255 / 31;
+
+  return (uint8_t)((r * 77 + g * 150 + b * 29) >> 8);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Sine and cosine from a table of whole degrees, interpolated
+            between them
+    @param  Angle   Angle in tenths of a degree, any sign
+    @param  Sin     Returns the sine, 16.16
+    @param  Cos     Returns the cosine, 16.16
+ */
+/**************************************************************************/
+static void BGFX_SinCos(int16_t Angle, int32_t *Sin, int32_t *Cos)
+{
+  int32_t a = Angle % 3600;
+  int32_t q, d, f, s, c;
+
+  if (a < 0) {
+    a += 3600;
+  }
+  q = a / 900;
+  a %= 900;
+  d = a / 10;
+  f = a % 10;
+
+  /* First quadrant, then moved to the quadrant of the angle */
+  s = BGFX_Sine[d] + (BGFX_Sine[d + 1] - BGFX_Sine[d]) * f / 10;
+  c = BGFX_Sine[90 - d] - (BGFX_Sine[90 - d] - BGFX_Sine[89 - d]) * f / 10;
+  switch (q) {
+  case 1:
+    *Sin = c;
+    *Cos = -s;
+    break;
+  case 2:
+    *Sin = -s;
+    *Cos = -c;
+    break;
+  case 3:
+    *Sin = -c;
+    *Cos = s;
+    break;
+  default:
+    *Sin = s;
+    *Cos = c;
+    break;
+  }
+}
@@ -0,0 +1,105 @@
+/**
+ * @file  bgfx_bitmap.h
+ * @date  19-October-2026
+ * @brief Scaled and rotated images.
+ *
+ * @author
+ * @author
+ *
+ * Images are drawn by inverse mapping: every display pixel looks up the
+ * image position under its center, in 16.16 fixed point, stepped by a
+ * constant increment from one pixel to the next. For every display row the
+ * range of pixels that land inside the image is solved once, so the inner
+ * loops have no bounds tests, and the row is written with BGFX_WriteSpan.
+ *
+ * Images may be in any color scheme. Pixels are converted when the image
+ * and the display differ: 5-6-5 to 8-bit grayscale and back, palette
+ * lookups for BGFX_INDEXED8 images, Foreground and Background for
+ * BGFX_MONOCHROMATIC images, and grayscale above mid gray for
+ * monochromatic displays. BGFX_INDEXED8 displays take image values as
+ * palette indices.
+ *
+ * Bilinear sampling applies to BGFX_16BITS and BGFX_8BITS images without a
+ * color key, others are always sampled nearest. Images wider or higher than
+ * INT16_MAX pixels do not fit the 16.16 positions and are not drawn.
+ */
+
+#ifndef BGFX_BITMAP_H
+#define BGFX_BITMAP_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief How image pixels are picked
+ */
+typedef enum
+{
+  BGFX_SAMPLE_NEAREST = 0,  /*!< Image pixel under the display pixel center */
+  BGFX_SAMPLE_BILINEAR,     /*!< Weighted mean of the 4 nearest image pixels */
+}BGFX_Sampling_t;
+
+
+/**
+ * @brief Image in memory
+ */
+typedef struct
+{
+  const void *Pixels;   /*!< Rows of pixels, top row first */
+  uint16_t Width;       /*!< Width in pixels */
+  uint16_t Height;      /*!< Height in pixels */
+  uint16_t Stride;      /*!< Bytes from one row to the next, 0 for rows
+                             packed one after the other */
+  BGFX_ColorScheme_t Format; /*!< Pixel format. BGFX_MONOCHROMATIC rows
+                             hold 8 pixels per byte, left-most pixel in the
+                             high bit */
+  const uint16_t *Palette; /*!< 256 entries 5-6-5 palette of BGFX_INDEXED8
+                             images, used on other displays */
+  uint16_t Foreground;  /*!< Display color of set bits (monochromatic) */
+  uint16_t Background;  /*!< Display color of clear bits (monochromatic) */
+  uint8_t Keyed;        /*!< If set, pixels equal to Key are not drawn */
+  uint16_t Key;         /*!< Transparent value, in the image format */
+}BGFX_Image_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw an image scaled to fill a rectangle
+    @param  Image   Image to draw
+    @param  Dst     Destination rectangle, screen coordinates
+    @param  Sampling  Nearest or bilinear
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawBitmapScaled(const BGFX_Image_t *Image, BGFX_Rect_t Dst,
+    BGFX_Sampling_t Sampling, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw an image scaled to a rectangle and rotated around the
+            rectangle center. Corners of the rotated image may go out of
+            the rectangle.
+    @param  Image   Image to draw
+    @param  Dst     Destination rectangle before rotation, screen
+            coordinates
+    @param  Angle   Clockwise rotation, in tenths of a degree
+    @param  Sampling  Nearest or bilinear
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawBitmapRotated(const BGFX_Image_t *Image, BGFX_Rect_t Dst,
+    int16_t Angle, BGFX_Sampling_t Sampling, BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_BITMAP_H */
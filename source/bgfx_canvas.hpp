@@ -0,0 +1,688 @@
+/**
+ * @file  bgfx_canvas.hpp
+ * @date  19-October-2026
+ * @brief Header-only C++ canvas specialized at compile time.
+ *
+ * @author
+ * @author
+ *
+ * bgfx::Canvas<Format, Width, Height, Rotation> draws the same primitives as
+ * basic_graphics.h, with the pixel format, the buffer size and the rotation
+ * known at compile time. Buffer strides, border checks and the color scheme
+ * dispatch of BGFX_DrawPixel become constants, and the drawing loops are
+ * inlined down to plain stores.
+ *
+ * The algorithms live in bgfx::detail as templates over any target offering
+ * Plot, HLine and VLine, so they are written once for every canvas type. The
+ * C API is not affected and needs no template instantiation; a canvas can
+ * still be handed to the C functions through Parameters().
+ *
+ * bgfx::detail is a second implementation of the line, circle, triangle and
+ * character algorithms of basic_graphics.c, kept apart on purpose: the C
+ * functions resolve rotation, clipping, raster operations and banding at
+ * run time and take run based paths (run-slice lines, circle tables) that
+ * do not reduce to constant stores. Both must draw the same pixels in copy
+ * mode; example/example_canvas_benchmark.cpp draws every primitive both
+ * ways and compares the buffers, run it after changing either side.
+ *
+ * Example:
+ *   static bgfx::Canvas<bgfx::Rgb565, 320, 240, 1> lcd;
+ *   lcd.Clear(0xFFFF);
+ *   lcd.DrawCircleFill(120, 160, 40, 0xF800);
+ *   DISP_WritePixels(lcd.Data(), lcd.BufferSize);
+ */
+
+#ifndef BGFX_CANVAS_HPP
+#define BGFX_CANVAS_HPP
+
+
+#include <stdint.h>
+#include <string.h>
+#include "basic_graphics.h"
+#include "glcdfont.h"
+
+
+namespace bgfx {
+
+
+/**
+ * @brief 16-bit 5-6-5 pixels, one uint16_t each, as BGFX_16BITS
+ */
+struct Rgb565
+{
+  typedef uint16_t Storage;
+  static const BGFX_ColorScheme_t Scheme = BGFX_16BITS;
+  static const uint16_t WidthPixelsOnWrite = 1;
+  static const uint16_t HeightPixelsOnWrite = 1;
+
+  static constexpr uint32_t Length(uint32_t W, uint32_t H) { return W * H; }
+
+  static inline void Fill(Storage *b, uint32_t n, uint16_t c)
+  {
+    for (; n > 0; n--) { *b++ = c; }
+  }
+
+  static inline void Put(Storage *b, uint32_t W, uint32_t x, uint32_t y,
+      uint16_t c)
+  {
+    b[x + y * W] = c;
+  }
+
+  static inline uint16_t Get(const Storage *b, uint32_t W, uint32_t x,
+      uint32_t y)
+  {
+    return b[x + y * W];
+  }
+
+  /* Run of n pixels along x (Vertical == false) or y, starting at (x, y) */
+  static inline void Run(Storage *b, uint32_t W, uint32_t x, uint32_t y,
+      int32_t n, bool Vertical, uint16_t c)
+  {
+    Storage *p = b + x + y * W;
+    if (Vertical) {
+      for (; n > 0; n--, p += W) { *p = c; }
+    } else {
+      for (; n > 0; n--) { *p++ = c; }
+    }
+  }
+};
+
+
+/**
+ * @brief 8-bit pixels, one uint8_t each, as BGFX_8BITS
+ */
+struct Color8
+{
+  typedef uint8_t Storage;
+  static const BGFX_ColorScheme_t Scheme = BGFX_8BITS;
+  static const uint16_t WidthPixelsOnWrite = 1;
+  static const uint16_t HeightPixelsOnWrite = 1;
+
+  static constexpr uint32_t Length(uint32_t W, uint32_t H) { return W * H; }
+
+  static inline void Fill(Storage *b, uint32_t n, uint16_t c)
+  {
+    memset(b, c & 0xFF, n);
+  }
+
+  static inline void Put(Storage *b, uint32_t W, uint32_t x, uint32_t y,
+      uint16_t c)
+  {
+    b[x + y * W] = c & 0xFF;
+  }
+
+  static inline uint16_t Get(const Storage *b, uint32_t W, uint32_t x,
+      uint32_t y)
+  {
+    return b[x + y * W];
+  }
+
+  static inline void Run(Storage *b, uint32_t W, uint32_t x, uint32_t y,
+      int32_t n, bool Vertical, uint16_t c)
+  {
+    Storage *p = b + x + y * W;
+    if (Vertical) {
+      for (; n > 0; n--, p += W) { *p = c & 0xFF; }
+    } else if (n > 0) {
+      memset(p, c & 0xFF, n);
+    }
+  }
+};
+
+
+/**
+ * @brief Monochromatic pixels in pages of 8 vertical pixels per byte, the
+ *        SSD1306 layout (BGFX_MONOCHROMATIC with HeightPixelsOnWrite = 8)
+ */
+struct Mono
+{
+  typedef uint8_t Storage;
+  static const BGFX_ColorScheme_t Scheme = BGFX_MONOCHROMATIC;
+  static const uint16_t WidthPixelsOnWrite = 1;
+  static const uint16_t HeightPixelsOnWrite = 8;
+
+  static constexpr uint32_t Length(uint32_t W, uint32_t H)
+  {
+    return W * ((H + 7) / 8);
+  }
+
+  static inline void Fill(Storage *b, uint32_t n, uint16_t c)
+  {
+    memset(b, c ? 0xFF : 0x00, n);
+  }
+
+  static inline void Put(Storage *b, uint32_t W, uint32_t x, uint32_t y,
+      uint16_t c)
+  {
+    Storage *p = b + (y / 8) * W + x;
+    if (c) {
+      *p |= 1 << (y & 7);
+    } else {
+      *p &= ~(1 << (y & 7));
+    }
+  }
+
+  static inline uint16_t Get(const Storage *b, uint32_t W, uint32_t x,
+      uint32_t y)
+  {
+    return (b[(y / 8) * W + x] >> (y & 7)) & 1;
+  }
+
+  static inline void Run(Storage *b, uint32_t W, uint32_t x, uint32_t y,
+      int32_t n, bool Vertical, uint16_t c)
+  {
+    if (Vertical) {
+      /* Whole bytes for the pages fully covered, masks at both ends */
+      while (n > 0) {
+        uint32_t bit = y & 7;
+        uint32_t count = (n < (int32_t)(8 - bit)) ? n : 8 - bit;
+        uint8_t mask = (uint8_t)(((1u << count) - 1) << bit);
+        Storage *p = b + (y / 8) * W + x;
+        *p = c ? (*p | mask) : (*p & ~mask);
+        y += count;
+        n -= count;
+      }
+    } else {
+      Storage *p = b + (y / 8) * W + x;
+      uint8_t mask = 1 << (y & 7);
+      if (c) {
+        for (; n > 0; n--) { *p++ |= mask; }
+      } else {
+        for (; n > 0; n--) { *p++ &= ~mask; }
+      }
+    }
+  }
+};
+
+
+namespace detail {
+
+
+template <typename T>
+inline void Swap(T &a, T &b)
+{
+  T t = a;
+  a = b;
+  b = t;
+}
+
+
+template <typename T>
+inline T Abs(T a)
+{
+  return (a < 0) ? -a : a;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Bresenham's line, as BGFX_DrawLine. Horizontal and vertical
+            lines go to the target's run writers.
+ */
+/**************************************************************************/
+template <typename Target>
+inline void Line(Target &t, int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    uint16_t color)
+{
+  int16_t steep, dx, dy, err, ystep;
+
+  if (y0 == y1) {
+    if (x0 > x1) { Swap(x0, x1); }
+    t.HLine(x0, y0, x1 - x0 + 1, color);
+    return;
+  }
+  if (x0 == x1) {
+    if (y0 > y1) { Swap(y0, y1); }
+    t.VLine(x0, y0, y1 - y0 + 1, color);
+    return;
+  }
+
+  steep = Abs(y1 - y0) > Abs(x1 - x0);
+  if (steep) {
+    Swap(x0, y0);
+    Swap(x1, y1);
+  }
+  if (x0 > x1) {
+    Swap(x0, x1);
+    Swap(y0, y1);
+  }
+
+  dx = x1 - x0;
+  dy = Abs(y1 - y0);
+  err = dx / 2;
+  ystep = (y0 < y1) ? 1 : -1;
+
+  for (; x0 <= x1; x0++) {
+    if (steep) {
+      t.Plot(y0, x0, color);
+    } else {
+      t.Plot(x0, y0, color);
+    }
+    err -= dy;
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Quarter-circle outlines, as BGFX_DrawCircleHelper
+ */
+/**************************************************************************/
+template <typename Target>
+inline void CircleQuarters(Target &t, int16_t x0, int16_t y0, int16_t r,
+    uint8_t corners, uint16_t color)
+{
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (corners & 0x4) {
+      t.Plot(x0 + x, y0 + y, color);
+      t.Plot(x0 + y, y0 + x, color);
+    }
+    if (corners & 0x2) {
+      t.Plot(x0 + x, y0 - y, color);
+      t.Plot(x0 + y, y0 - x, color);
+    }
+    if (corners & 0x8) {
+      t.Plot(x0 - y, y0 + x, color);
+      t.Plot(x0 - x, y0 + y, color);
+    }
+    if (corners & 0x1) {
+      t.Plot(x0 - y, y0 - x, color);
+      t.Plot(x0 - x, y0 - y, color);
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Filled quarter-circles, as BGFX_DrawCircleFillHelper, with
+            vertical runs
+ */
+/**************************************************************************/
+template <typename Target>
+inline void CircleQuartersFill(Target &t, int16_t x0, int16_t y0, int16_t r,
+    uint8_t corners, int16_t delta, uint16_t color)
+{
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+
+  delta++; /* Avoid some +1's in the loop */
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (x < (y + 1)) {
+      if (corners & 1) { t.VLine(x0 + x, y0 - y, 2 * y + delta, color); }
+      if (corners & 2) { t.VLine(x0 - x, y0 - y, 2 * y + delta, color); }
+    }
+    if (y != py) {
+      if (corners & 1) { t.VLine(x0 + py, y0 - px, 2 * px + delta, color); }
+      if (corners & 2) { t.VLine(x0 - py, y0 - px, 2 * px + delta, color); }
+      py = y;
+    }
+    px = x;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Filled triangle, as BGFX_DrawTriangleFill, with horizontal runs
+ */
+/**************************************************************************/
+template <typename Target>
+inline void TriangleFill(Target &t, int16_t x0, int16_t y0, int16_t x1,
+    int16_t y1, int16_t x2, int16_t y2, uint16_t color)
+{
+  int16_t a, b, y, last;
+
+  if (y0 > y1) { Swap(y0, y1); Swap(x0, x1); }
+  if (y1 > y2) { Swap(y2, y1); Swap(x2, x1); }
+  if (y0 > y1) { Swap(y0, y1); Swap(x0, x1); }
+
+  if (y0 == y2) {
+    a = b = x0;
+    if (x1 < a) { a = x1; } else if (x1 > b) { b = x1; }
+    if (x2 < a) { a = x2; } else if (x2 > b) { b = x2; }
+    t.HLine(a, y0, b - a + 1, color);
+    return;
+  }
+
+  int16_t dx01 = x1 - x0, dy01 = y1 - y0, dx02 = x2 - x0, dy02 = y2 - y0,
+      dx12 = x2 - x1, dy12 = y2 - y1;
+  int32_t sa = 0, sb = 0;
+
+  last = (y1 == y2) ? y1 : y1 - 1;
+  for (y = y0; y <= last; y++) {
+    a = x0 + sa / dy01;
+    b = x0 + sb / dy02;
+    sa += dx01;
+    sb += dx02;
+    if (a > b) { Swap(a, b); }
+    t.HLine(a, y, b - a + 1, color);
+  }
+
+  sa = (int32_t)dx12 * (y - y1);
+  sb = (int32_t)dx02 * (y - y0);
+  for (; y <= y2; y++) {
+    a = x1 + sa / dy12;
+    b = x0 + sb / dy02;
+    sa += dx12;
+    sb += dx02;
+    if (a > b) { Swap(a, b); }
+    t.HLine(a, y, b - a + 1, color);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Classic 5x7 character, as BGFX_DrawChar
+ */
+/**************************************************************************/
+template <typename Target>
+inline void Char(Target &t, int16_t x, int16_t y, uint8_t c, uint16_t color,
+    uint16_t bg, uint8_t size_x, uint8_t size_y, bool cp437)
+{
+  if (!cp437 && (c >= 176)) {
+    c++; /* Handle 'classic' charset behavior */
+  }
+
+  for (int8_t i = 0; i < 5; i++) {
+    uint8_t line = glcdfont[c * 5 + i];
+    for (int8_t j = 0; j < 8; j++, line >>= 1) {
+      if (line & 1) {
+        t.FillRect(x + i * size_x, y + j * size_y, size_x, size_y, color);
+      } else if (bg != color) {
+        t.FillRect(x + i * size_x, y + j * size_y, size_x, size_y, bg);
+      }
+    }
+  }
+  if (bg != color) {
+    t.FillRect(x + 5 * size_x, y, size_x, 8 * size_y, bg);
+  }
+}
+
+} /* namespace detail */
+
+
+/**
+ * @brief Framebuffer and drawing functions fixed at compile time
+ * @tparam Format   Pixel format: bgfx::Rgb565, bgfx::Color8 or bgfx::Mono
+ * @tparam W        'Raw' display width, as WIDTH in BGFX_Parameters_t
+ * @tparam H        'Raw' display height, as HEIGHT in BGFX_Parameters_t
+ * @tparam R        Rotation, 0 thru 3, as BGFX_SetRotation
+ */
+template <typename Format, uint16_t W, uint16_t H, uint8_t R = 0>
+class Canvas
+{
+public:
+  typedef typename Format::Storage Storage;
+
+  static const uint8_t Rotation = R & 3;
+  static const uint16_t Width = (Rotation & 1) ? H : W;  /*!< Rotated width */
+  static const uint16_t Height = (Rotation & 1) ? W : H; /*!< Rotated height */
+  static const uint32_t Length = Format::Length(W, H);   /*!< Storage units */
+  static const uint32_t BufferSize = Length * sizeof(Storage); /*!< Bytes */
+
+  Storage *Data() { return buffer_; }
+  const Storage *Data() const { return buffer_; }
+
+  /* Display structure for the C functions, pointing to this buffer */
+  BGFX_Parameters_t Parameters()
+  {
+    BGFX_Parameters_t p;
+    memset(&p, 0, sizeof(p));
+    p.WIDTH = W;
+    p.HEIGHT = H;
+    p.WidthPixelsOnWrite = Format::WidthPixelsOnWrite;
+    p.HeightPixelsOnWrite = Format::HeightPixelsOnWrite;
+    p.ColorScheme = Format::Scheme;
+    p.Buffer = buffer_;
+    BGFX_SetRotation(Rotation, &p);
+    return p;
+  }
+
+  void Clear(uint16_t color)
+  {
+    Format::Fill(buffer_, Length, color);
+  }
+
+  void DrawPixel(int16_t x, int16_t y, uint16_t color)
+  {
+    Plot(x, y, color);
+  }
+
+  uint16_t GetPixel(int16_t x, int16_t y) const
+  {
+    if (((uint16_t)x >= Width) || ((uint16_t)y >= Height)) {
+      return 0;
+    }
+    return Format::Get(buffer_, W, PhysX(x, y), PhysY(x, y));
+  }
+
+  void DrawHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+  {
+    HLine(x, y, w, color);
+  }
+
+  void DrawVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+  {
+    VLine(x, y, h, color);
+  }
+
+  void DrawLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      uint16_t color)
+  {
+    detail::Line(*this, x0, y0, x1, y1, color);
+  }
+
+  void DrawRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+  {
+    HLine(x, y, w, color);
+    HLine(x, y + h - 1, w, color);
+    VLine(x, y, h, color);
+    VLine(x + w - 1, y, h, color);
+  }
+
+  void DrawRectFill(int16_t x, int16_t y, int16_t w, int16_t h,
+      uint16_t color)
+  {
+    FillRect(x, y, w, h, color);
+  }
+
+  void DrawRoundRect(int16_t x, int16_t y, int16_t w, int16_t h, int16_t r,
+      uint16_t color)
+  {
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+    if (r > max_radius) { r = max_radius; }
+    if (r < 0) { r = 0; }
+    HLine(x + r, y, w - 2 * r, color);
+    HLine(x + r, y + h - 1, w - 2 * r, color);
+    VLine(x, y + r, h - 2 * r, color);
+    VLine(x + w - 1, y + r, h - 2 * r, color);
+    detail::CircleQuarters(*this, x + r, y + r, r, 1, color);
+    detail::CircleQuarters(*this, x + w - r - 1, y + r, r, 2, color);
+    detail::CircleQuarters(*this, x + w - r - 1, y + h - r - 1, r, 4, color);
+    detail::CircleQuarters(*this, x + r, y + h - r - 1, r, 8, color);
+  }
+
+  void DrawRoundRectFill(int16_t x, int16_t y, int16_t w, int16_t h,
+      int16_t r, uint16_t color)
+  {
+    int16_t max_radius = ((w < h) ? w : h) / 2;
+    if (r > max_radius) { r = max_radius; }
+    if (r < 0) { r = 0; }
+    FillRect(x + r, y, w - 2 * r, h, color);
+    detail::CircleQuartersFill(*this, x + w - r - 1, y + r, r, 1,
+        h - 2 * r - 1, color);
+    detail::CircleQuartersFill(*this, x + r, y + r, r, 2, h - 2 * r - 1,
+        color);
+  }
+
+  void DrawCircle(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+  {
+    DrawPixel(x0, y0 + r, color);
+    DrawPixel(x0, y0 - r, color);
+    DrawPixel(x0 + r, y0, color);
+    DrawPixel(x0 - r, y0, color);
+    detail::CircleQuarters(*this, x0, y0, r, 0xF, color);
+  }
+
+  void DrawCircleFill(int16_t x0, int16_t y0, int16_t r, uint16_t color)
+  {
+    VLine(x0, y0 - r, 2 * r + 1, color);
+    detail::CircleQuartersFill(*this, x0, y0, r, 3, 0, color);
+  }
+
+  void DrawTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      int16_t x2, int16_t y2, uint16_t color)
+  {
+    DrawLine(x0, y0, x1, y1, color);
+    DrawLine(x1, y1, x2, y2, color);
+    DrawLine(x2, y2, x0, y0, color);
+  }
+
+  void DrawTriangleFill(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+      int16_t x2, int16_t y2, uint16_t color)
+  {
+    detail::TriangleFill(*this, x0, y0, x1, y1, x2, y2, color);
+  }
+
+  void DrawChar(int16_t x, int16_t y, uint8_t c, uint16_t color, uint16_t bg,
+      uint8_t size_x = 1, uint8_t size_y = 1, bool cp437 = false)
+  {
+    if ((x >= Width) || (y >= Height) || ((x + 6 * size_x - 1) < 0) ||
+        ((y + 8 * size_y - 1) < 0))
+    {
+      return;
+    }
+    detail::Char(*this, x, y, c, color, bg, size_x, size_y, cp437);
+  }
+
+  void SendString(int16_t x, int16_t y, const char *text, uint32_t length,
+      uint16_t color, uint16_t bg, uint8_t size_x = 1, uint8_t size_y = 1)
+  {
+    for (uint32_t i = 0; i < length; i++) {
+      DrawChar(x, y, (uint8_t)text[i], color, bg, size_x, size_y);
+      x += size_x * 6;
+    }
+  }
+
+  /* Target interface of the detail algorithms */
+
+  void Plot(int16_t x, int16_t y, uint16_t color)
+  {
+    /* One unsigned compare per axis also rejects negative coordinates */
+    if (((uint16_t)x >= Width) || ((uint16_t)y >= Height)) {
+      return;
+    }
+    Format::Put(buffer_, W, PhysX(x, y), PhysY(x, y), color);
+  }
+
+  void HLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+  {
+    if (((uint16_t)y >= Height) || !Clip(x, w, Width)) {
+      return;
+    }
+    /* Rotation picks the buffer axis and direction at compile time */
+    switch (Rotation) {
+    case 0: Format::Run(buffer_, W, x, y, w, false, color); break;
+    case 1: Format::Run(buffer_, W, W - 1 - y, x, w, true, color); break;
+    case 2: Format::Run(buffer_, W, W - x - w, H - 1 - y, w, false, color);
+            break;
+    default: Format::Run(buffer_, W, y, H - x - w, w, true, color); break;
+    }
+  }
+
+  void VLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+  {
+    if (((uint16_t)x >= Width) || !Clip(y, h, Height)) {
+      return;
+    }
+    switch (Rotation) {
+    case 0: Format::Run(buffer_, W, x, y, h, true, color); break;
+    case 1: Format::Run(buffer_, W, W - y - h, x, h, false, color); break;
+    case 2: Format::Run(buffer_, W, W - 1 - x, H - y - h, h, true, color);
+            break;
+    default: Format::Run(buffer_, W, y, H - 1 - x, h, false, color); break;
+    }
+  }
+
+  void FillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+  {
+    if (!Clip(x, w, Width) || !Clip(y, h, Height)) {
+      return;
+    }
+    /* Walk rows of the buffer, whatever the rotation */
+    if (Rotation & 1) {
+      for (int16_t i = 0; i < w; i++) {
+        VLine(x + i, y, h, color);
+      }
+    } else {
+      for (int16_t j = 0; j < h; j++) {
+        HLine(x, y + j, w, color);
+      }
+    }
+  }
+
+private:
+  static constexpr uint32_t PhysX(int16_t x, int16_t y)
+  {
+    return (Rotation == 1) ? W - 1 - y : (Rotation == 2) ? W - 1 - x :
+        (Rotation == 3) ? y : x;
+  }
+
+  static constexpr uint32_t PhysY(int16_t x, int16_t y)
+  {
+    return (Rotation == 1) ? x : (Rotation == 2) ? H - 1 - y :
+        (Rotation == 3) ? H - 1 - x : y;
+  }
+
+  /* Clip [Start, Start + Length) to [0, Limit), false if nothing is left */
+  static bool Clip(int16_t &Start, int16_t &Length, int32_t Limit)
+  {
+    int32_t start = Start, end = (int32_t)Start + Length;
+    if (start < 0) { start = 0; }
+    if (end > Limit) { end = Limit; }
+    if (end <= start) { return false; }
+    Start = (int16_t)start;
+    Length = (int16_t)(end - start);
+    return true;
+  }
+
+  Storage buffer_[Length];
+};
+
+} /* namespace bgfx */
+
+#endif /* BGFX_CANVAS_HPP */
@@ -0,0 +1,276 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_chart.h"
+
+
+static int16_t BGFX_ChartRow(const BGFX_Chart_t *Chart, int16_t Value);
+
+static void BGFX_ChartColumn(const BGFX_Chart_t *Chart, int16_t Slot,
+    int16_t x, BGFX_Parameters_t Display);
+
+static uint8_t BGFX_ChartScroll(const BGFX_Chart_t *Chart,
+    BGFX_Parameters_t Display);
+
+static void BGFX_ChartMark(BGFX_Chart_t *Chart, int16_t Start, int16_t End);
+
+
+
+void BGFX_ChartInit(BGFX_Chart_t *Chart, BGFX_Parameters_t Display)
+{
+  uint8_t k;
+
+  if (Chart->Channels > BGFX_CHART_MAX_CHANNELS) {
+    Chart->Channels = BGFX_CHART_MAX_CHANNELS;
+  }
+  Chart->Head = 0;
+  Chart->Count = 0;
+  Chart->Pending = 0;
+  Chart->Scale = 0;
+  if ((Chart->Max > Chart->Min) && (Chart->H > 1)) {
+    Chart->Scale = (int32_t)(((int64_t)(Chart->H - 1) * 65536) /
+        ((int32_t)Chart->Max - Chart->Min));
+  }
+  for (k = 0; k < BGFX_CHART_MAX_CHANNELS; k++) {
+    Chart->Last[k] = -1;
+  }
+  Chart->DirtyStart = 0;
+  Chart->DirtyEnd = 0;
+
+  BGFX_ChartRedraw(Chart, Display);
+}
+
+
+
+
+uint16_t BGFX_ChartPush(BGFX_Chart_t *Chart, const int16_t *Samples,
+    uint16_t Count, BGFX_Parameters_t Display)
+{
+  uint16_t decimation = (Chart->Decimation > 1) ? Chart->Decimation : 1;
+  uint16_t drawn = 0;
+  int16_t row, x, i;
+  int16_t *column;
+  uint8_t k;
+
+  if ((Chart->W <= 0) || (Chart->H <= 0) || (Chart->Channels == 0)) {
+    return 0;
+  }
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  for (; Count > 0; Count--, Samples += Chart->Channels) {
+    /* Grow the column of every channel with the new sample */
+    for (k = 0; k < Chart->Channels; k++) {
+      row = BGFX_ChartRow(Chart, Samples[k]);
+      if (Chart->Pending == 0) {
+        Chart->Top[k] = Chart->Bottom[k] = row;
+        /* Join with the previous column, without drawing over it */
+        if (Chart->Last[k] >= 0) {
+          if (Chart->Last[k] < row) {
+            Chart->Top[k] = Chart->Last[k] + 1;
+          } else if (Chart->Last[k] > row) {
+            Chart->Bottom[k] = Chart->Last[k] - 1;
+          }
+        }
+      } else if (row < Chart->Top[k]) {
+        Chart->Top[k] = row;
+      } else if (row > Chart->Bottom[k]) {
+        Chart->Bottom[k] = row;
+      }
+      Chart->Last[k] = row;
+    }
+    if (++Chart->Pending < decimation) {
+      continue;
+    }
+
+    /* Column complete, store it in the ring and draw it */
+    column = &Chart->Columns[(uint32_t)Chart->Head * Chart->Channels * 2];
+    for (k = 0; k < Chart->Channels; k++) {
+      column[2 * k] = Chart->Top[k];
+      column[2 * k + 1] = Chart->Bottom[k];
+    }
+
+    if (Chart->Mode == BGFX_CHART_SWEEP) {
+      x = Chart->X + Chart->Head;
+      BGFX_ChartColumn(Chart, Chart->Head, x, Display);
+      BGFX_ChartMark(Chart, x, x + 1);
+      for (i = 1; (i <= Chart->Gap) && (i < Chart->W); i++) {
+        x = Chart->X + (Chart->Head + i) % Chart->W;
+        BGFX_DrawVLine(x, Chart->Y, Chart->H, Chart->Background, Display);
+        BGFX_ChartMark(Chart, x, x + 1);
+      }
+      Chart->Head = (Chart->Head + 1) % Chart->W;
+      if (Chart->Count < Chart->W) {
+        Chart->Count++;
+      }
+    } else {
+      Chart->Head = (Chart->Head + 1) % Chart->W;
+      if (Chart->Count < Chart->W) {
+        Chart->Count++;
+      }
+      if (BGFX_ChartScroll(Chart, Display)) {
+        BGFX_ChartColumn(Chart, (Chart->Head + Chart->W - 1) % Chart->W,
+            Chart->X + Chart->W - 1, Display);
+      } else {
+        BGFX_ChartRedraw(Chart, Display);
+      }
+      BGFX_ChartMark(Chart, Chart->X, Chart->X + Chart->W);
+    }
+
+    Chart->Pending = 0;
+    drawn++;
+  }
+
+  return drawn;
+}
+
+
+
+
+void BGFX_ChartRedraw(BGFX_Chart_t *Chart, BGFX_Parameters_t Display)
+{
+  int16_t i, slot;
+  uint8_t valid;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  for (i = 0; i < Chart->W; i++) {
+    if (Chart->Mode == BGFX_CHART_SWEEP) {
+      slot = i;
+      valid = (i < Chart->Count) &&
+          (((i - Chart->Head + Chart->W) % Chart->W) >= Chart->Gap);
+    } else {
+      slot = (Chart->Head + i) % Chart->W;
+      valid = (i >= Chart->W - Chart->Count);
+    }
+
+    if (valid) {
+      BGFX_ChartColumn(Chart, slot, Chart->X + i, Display);
+    } else {
+      BGFX_DrawVLine(Chart->X + i, Chart->Y, Chart->H, Chart->Background,
+          Display);
+    }
+  }
+  BGFX_ChartMark(Chart, Chart->X, Chart->X + Chart->W);
+}
+
+
+
+
+uint8_t BGFX_ChartGetDirty(BGFX_Chart_t *Chart, int16_t *x, int16_t *w)
+{
+  if (Chart->DirtyEnd <= Chart->DirtyStart) {
+    return 0;
+  }
+
+  *x = Chart->DirtyStart;
+  *w = Chart->DirtyEnd - Chart->DirtyStart;
+  Chart->DirtyStart = 0;
+  Chart->DirtyEnd = 0;
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Row of a sample value inside the plot, 0 on top
+    @param  Chart   Chart the sample belongs to
+    @param  Value   Sample value
+    @return Row, from 0 to H - 1
+ */
+/**************************************************************************/
+static int16_t BGFX_ChartRow(const BGFX_Chart_t *Chart, int16_t Value)
+{
+  if (Value <= Chart->Min) {
+    return Chart->H - 1;
+  }
+  if (Value >= Chart->Max) {
+    return 0;
+  }
+  return Chart->H - 1 -
+      (int16_t)((((int32_t)Value - Chart->Min) * Chart->Scale) >> 16);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw one column of the ring: background, then one vertical span
+            per channel
+    @param  Chart   Chart the column belongs to
+    @param  Slot    Ring slot of the column
+    @param  x   Screen x coordinate to draw at
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+ */
+/**************************************************************************/
+static void BGFX_ChartColumn(const BGFX_Chart_t *Chart, int16_t Slot,
+    int16_t x, BGFX_Parameters_t Display)
+{
+  const int16_t *column = &Chart->Columns[(uint32_t)Slot * Chart->Channels * 2];
+  uint8_t k;
+
+  BGFX_DrawVLine(x, Chart->Y, Chart->H, Chart->Background, Display);
+  for (k = 0; k < Chart->Channels; k++) {
+    BGFX_DrawVLine(x, Chart->Y + column[2 * k],
+        column[2 * k + 1] - column[2 * k] + 1, Chart->Colors[k], Display);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Move the plot one pixel to the left with BGFX_CopyArea. Only
+            done when every pixel of the plot can be read back: buffer
+            written directly, plot fully inside the display, no band and no
+            clip rectangle.
+    @param  Chart   Chart to scroll
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+    @return 1 if the plot was moved, 0 if it has to be drawn again
+ */
+/**************************************************************************/
+static uint8_t BGFX_ChartScroll(const BGFX_Chart_t *Chart,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t plot;
+
+  if ((Display.DrawPixel != NULL) || (Display.Buffer == NULL) ||
+      (Display.BandHeight > 0) ||
+      ((Display.Clip.W > 0) && (Display.Clip.H > 0))) {
+    return 0;
+  }
+  if ((Chart->W < 2) || (Chart->X < 0) || (Chart->Y < 0) ||
+      (Chart->X + Chart->W > Display.Width) ||
+      (Chart->Y + Chart->H > Display.Height)) {
+    return 0;
+  }
+
+  plot.X = Chart->X + 1;
+  plot.Y = Chart->Y;
+  plot.W = Chart->W - 1;
+  plot.H = Chart->H;
+  BGFX_CopyArea(plot, Chart->X, Chart->Y, Display);
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Add columns Start to End - 1 to the changed area
+    @param  Chart   Chart to update
+    @param  Start   First changed column
+    @param  End     Column after the last changed one
+ */
+/**************************************************************************/
+static void BGFX_ChartMark(BGFX_Chart_t *Chart, int16_t Start, int16_t End)
+{
+  if (Chart->DirtyEnd <= Chart->DirtyStart) {
+    Chart->DirtyStart = Start;
+    Chart->DirtyEnd = End;
+    return;
+  }
+  if (Start < Chart->DirtyStart) {
+    Chart->DirtyStart = Start;
+  }
+  if (End > Chart->DirtyEnd) {
+    Chart->DirtyEnd = End;
+  }
+}
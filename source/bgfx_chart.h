@@ -0,0 +1,139 @@
+/**
+ * @file  bgfx_chart.h
+ * @date  19-October-2026
+ * @brief Streaming strip chart for live plots.
+ *
+ * @author
+ * @author
+ *
+ * The chart owns a plot rectangle and a ring of already drawn columns, one
+ * vertical span per channel and column. Samples are pushed as they arrive;
+ * every Decimation samples become one column holding their minimum and
+ * maximum, joined to the previous column so the trace has no holes. Only the
+ * newest column is drawn:
+ *  - BGFX_CHART_SCROLL moves the plot one pixel to the left with
+ *    BGFX_CopyArea when the buffer can be read back, and by redrawing the
+ *    ring otherwise.
+ *  - BGFX_CHART_SWEEP writes the columns left to right over the old ones,
+ *    as an oscilloscope, with Gap blank columns ahead of the trace.
+ * The columns changed since the last call to BGFX_ChartGetDirty are
+ * reported, so only them need to be sent to the display.
+ */
+
+#ifndef BGFX_CHART_H
+#define BGFX_CHART_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef BGFX_CHART_MAX_CHANNELS
+#define BGFX_CHART_MAX_CHANNELS 4 /*!< Maximum traces in a chart */
+#endif
+
+/*! Number of int16_t in the column ring of a chart */
+#define BGFX_CHART_STORAGE(w, channels) ((uint32_t)(w) * (channels) * 2)
+
+
+/**
+ * @brief How new columns enter the plot
+ */
+typedef enum
+{
+  BGFX_CHART_SCROLL = 0,  /*!< Newest column on the right, plot scrolls left */
+  BGFX_CHART_SWEEP,       /*!< Columns written left to right, then wrap */
+}BGFX_ChartMode_t;
+
+
+/**
+ * @brief Strip chart. The fields up to Columns are set by the caller, the
+ *        others are handled by the chart functions.
+ */
+typedef struct
+{
+  int16_t X;            /*!< Plot rectangle top left corner x coordinate */
+  int16_t Y;            /*!< Plot rectangle top left corner y coordinate */
+  int16_t W;            /*!< Plot width in pixels, one column per pixel */
+  int16_t H;            /*!< Plot height in pixels */
+  int16_t Min;          /*!< Sample value drawn on the bottom row */
+  int16_t Max;          /*!< Sample value drawn on the top row */
+  uint8_t Channels;     /*!< Number of traces, 1 to BGFX_CHART_MAX_CHANNELS */
+  const uint16_t *Colors; /*!< Trace colors, one per channel */
+  uint16_t Background;  /*!< Plot background color */
+  uint16_t Decimation;  /*!< Samples per column, 0 is the same as 1 */
+  BGFX_ChartMode_t Mode; /*!< Scroll or sweep */
+  uint8_t Gap;          /*!< Sweep mode: blank columns ahead of the trace */
+  int16_t *Columns;     /*!< Ring of BGFX_CHART_STORAGE(W, Channels) values */
+
+  int16_t Head;         /*!< Ring slot of the next column */
+  int16_t Count;        /*!< Columns in the ring */
+  uint16_t Pending;     /*!< Samples in the column being built */
+  int32_t Scale;        /*!< Rows per sample unit, 16.16 */
+  int16_t Top[BGFX_CHART_MAX_CHANNELS];    /*!< Column being built, top row */
+  int16_t Bottom[BGFX_CHART_MAX_CHANNELS]; /*!< Column being built, bottom row */
+  int16_t Last[BGFX_CHART_MAX_CHANNELS];   /*!< Row of the last sample */
+  int16_t DirtyStart;   /*!< First changed column x coordinate */
+  int16_t DirtyEnd;     /*!< Column after the last changed one */
+}BGFX_Chart_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Reset a chart and clear its plot rectangle
+    @param  Chart   Chart, with the caller fields set
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_ChartInit(BGFX_Chart_t *Chart, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Add samples to a chart, drawing a column every Decimation
+            samples
+    @param  Chart   Chart to add to
+    @param  Samples Count samples per channel, interleaved: channel 0 to
+            Channels - 1 of the first sample, then of the second, and so on
+    @param  Count   Number of samples per channel
+    @param  Display Structure to display parameters and functions
+    @return Number of columns drawn
+ */
+/**************************************************************************/
+uint16_t BGFX_ChartPush(BGFX_Chart_t *Chart, const int16_t *Samples,
+    uint16_t Count, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw the whole plot again from the ring, for example after
+            something was drawn over it
+    @param  Chart   Chart to draw
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_ChartRedraw(BGFX_Chart_t *Chart, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Get and clear the columns changed since the last call. The
+            changed area is x to x + w - 1, Y to Y + H - 1.
+    @param  Chart   Chart to query
+    @param  x   Returns the first changed column
+    @param  w   Returns the number of changed columns
+    @return 1 if some column changed, 0 otherwise
+ */
+/**************************************************************************/
+uint8_t BGFX_ChartGetDirty(BGFX_Chart_t *Chart, int16_t *x, int16_t *w);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_CHART_H */
@@ -0,0 +1,310 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_console.h"
+
+
+static BGFX_Cell_t *BGFX_ConsoleLine(const BGFX_Console_t *Console,
+    int32_t Row, uint16_t View);
+
+static void BGFX_ConsoleClearLine(BGFX_Console_t *Console, uint8_t Row);
+
+static void BGFX_ConsoleNewLine(BGFX_Console_t *Console);
+
+static uint8_t BGFX_ConsoleShift(BGFX_Console_t *Console, int32_t Shift,
+    BGFX_Parameters_t Display);
+
+static void BGFX_ConsoleCell(const BGFX_Console_t *Console, int16_t x,
+    int16_t y, BGFX_Cell_t Cell, BGFX_Parameters_t Display);
+
+
+
+void BGFX_ConsoleInit(BGFX_Console_t *Console)
+{
+  uint8_t row;
+
+  Console->First = 0;
+  Console->History = 0;
+  Console->View = 0;
+  Console->Col = 0;
+  Console->Row = 0;
+  Console->Top = 0;
+  Console->ShownTop = 0;
+  Console->Valid = 0;
+  for (row = 0; row < Console->Rows; row++) {
+    BGFX_ConsoleClearLine(Console, row);
+  }
+}
+
+
+
+
+void BGFX_ConsoleWrite(BGFX_Console_t *Console, const uint8_t *Data,
+    uint32_t Length)
+{
+  BGFX_Cell_t *line;
+  uint32_t i;
+  uint16_t tab;
+  uint8_t row;
+
+  if ((Console->Cols == 0) || (Console->Rows == 0)) {
+    return;
+  }
+  Console->View = 0;
+
+  for (i = 0; i < Length; i++) {
+    switch (Data[i]) {
+    case '\n':
+      BGFX_ConsoleNewLine(Console);
+      break;
+    case '\r':
+      Console->Col = 0;
+      break;
+    case '\b':
+      if (Console->Col > 0) {
+        Console->Col--;
+      }
+      break;
+    case '\t':
+      /* Next multiple of 8, computed wide as it may pass 255 */
+      tab = (Console->Col + 8) & ~7;
+      Console->Col = (tab < Console->Cols) ? tab : Console->Cols;
+      break;
+    case '\f':
+      for (row = 0; row < Console->Rows; row++) {
+        BGFX_ConsoleClearLine(Console, row);
+      }
+      Console->Col = 0;
+      Console->Row = 0;
+      break;
+    default:
+      if (Data[i] < 0x20) {
+        break;
+      }
+      if (Console->Col >= Console->Cols) {
+        BGFX_ConsoleNewLine(Console);
+      }
+      line = BGFX_ConsoleLine(Console, Console->Row, 0);
+      line[Console->Col].Char = Data[i];
+      line[Console->Col].Attr = Console->Attr;
+      Console->Col++;
+      break;
+    }
+  }
+}
+
+
+
+
+void BGFX_ConsoleScrollBack(BGFX_Console_t *Console, uint16_t Lines)
+{
+  Console->View = (Lines < Console->History) ? Lines : Console->History;
+}
+
+
+
+
+void BGFX_ConsoleInvalidate(BGFX_Console_t *Console)
+{
+  Console->Valid = 0;
+}
+
+
+
+
+uint8_t BGFX_ConsoleDraw(BGFX_Console_t *Console, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t cell, area = {0, 0, 0, 0};
+  BGFX_Cell_t *line, *shown;
+  uint8_t size = Console->Size ? Console->Size : 1;
+  uint32_t top = Console->Top - Console->View;
+  uint8_t force = !Console->Valid;
+  int16_t row, col;
+  uint8_t moved = 0;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  Display.GfxFont = NULL;
+  cell.W = 6 * size;
+  cell.H = 8 * size;
+
+  if (!force && (top != Console->ShownTop)) {
+    moved = BGFX_ConsoleShift(Console, (int32_t)(top - Console->ShownTop),
+        Display);
+  }
+  if (moved) {
+    area.X = Console->X;
+    area.Y = Console->Y;
+    area.W = Console->Cols * cell.W;
+    area.H = Console->Rows * cell.H;
+  }
+
+  shown = Console->Cells +
+      (uint32_t)Console->Cols * (Console->Rows + Console->Scrollback);
+  for (row = 0; row < Console->Rows; row++, shown += Console->Cols) {
+    line = BGFX_ConsoleLine(Console, row, Console->View);
+    cell.Y = Console->Y + row * cell.H;
+    for (col = 0; col < Console->Cols; col++) {
+      if (!force && (line[col].Char == shown[col].Char) &&
+          (line[col].Attr == shown[col].Attr)) {
+        continue;
+      }
+      cell.X = Console->X + col * cell.W;
+      BGFX_ConsoleCell(Console, cell.X, cell.Y, line[col], Display);
+      shown[col] = line[col];
+      BGFX_RectUnion(&area, cell);
+    }
+  }
+
+  Console->ShownTop = top;
+  Console->Valid = 1;
+  if (Region != NULL) {
+    *Region = area;
+  }
+  return (area.W > 0) && (area.H > 0);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Find the cells of a screen row in the ring
+    @param  Console Console
+    @param  Row     Screen row, 0 is the top row
+    @param  View    Lines scrolled back
+    @return First cell of the line
+ */
+/**************************************************************************/
+static BGFX_Cell_t *BGFX_ConsoleLine(const BGFX_Console_t *Console,
+    int32_t Row, uint16_t View)
+{
+  int32_t lines = Console->Rows + Console->Scrollback;
+  int32_t line = (Console->First + Row - View + lines) % lines;
+
+  return Console->Cells + line * Console->Cols;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a screen row with spaces of the current attributes
+    @param  Console Console
+    @param  Row     Screen row
+ */
+/**************************************************************************/
+static void BGFX_ConsoleClearLine(BGFX_Console_t *Console, uint8_t Row)
+{
+  BGFX_Cell_t *line = BGFX_ConsoleLine(Console, Row, 0);
+  uint8_t col;
+
+  for (col = 0; col < Console->Cols; col++) {
+    line[col].Char = ' ';
+    line[col].Attr = Console->Attr;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Move the cursor to the start of the next line, scrolling the
+            screen up one line from the bottom row. The line leaving the
+            screen joins the scrollback, the oldest one is reused.
+    @param  Console Console
+ */
+/**************************************************************************/
+static void BGFX_ConsoleNewLine(BGFX_Console_t *Console)
+{
+  Console->Col = 0;
+  if (Console->Row + 1 < Console->Rows) {
+    Console->Row++;
+    return;
+  }
+
+  Console->First = (Console->First + 1) % (Console->Rows +
+      Console->Scrollback);
+  Console->Top++;
+  if (Console->History < Console->Scrollback) {
+    Console->History++;
+  }
+  BGFX_ConsoleClearLine(Console, Console->Rows - 1);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Scroll what is on the display by whole lines, pixels and the
+            cells on display together. The rows uncovered keep their pixels
+            and their cells, so they are compared as any other row.
+    @param  Console Console
+    @param  Shift   Lines to move up, negative to move down
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+    @return 1 if the pixels were moved, 0 if the shift is too large, the
+            console is not fully on the display or the buffer cannot be
+            read back
+ */
+/**************************************************************************/
+static uint8_t BGFX_ConsoleShift(BGFX_Console_t *Console, int32_t Shift,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Cell_t *shown = Console->Cells +
+      (uint32_t)Console->Cols * (Console->Rows + Console->Scrollback);
+  uint8_t size = Console->Size ? Console->Size : 1;
+  int16_t h = 8 * size;
+  int32_t lines = (Shift > 0) ? Shift : -Shift;
+  BGFX_Rect_t src;
+
+  src.X = Console->X;
+  src.W = Console->Cols * 6 * size;
+  if ((lines >= Console->Rows) || (Display.DrawPixel != NULL) ||
+      (Display.Buffer == NULL) || (Display.BandHeight > 0) ||
+      ((Display.Clip.W > 0) && (Display.Clip.H > 0))) {
+    return 0;
+  }
+  if ((Console->X < 0) || (Console->Y < 0) ||
+      (Console->X + src.W > Display.Width) ||
+      (Console->Y + Console->Rows * h > Display.Height)) {
+    return 0;
+  }
+
+  src.H = (Console->Rows - lines) * h;
+  if (Shift > 0) {
+    src.Y = Console->Y + lines * h;
+    BGFX_CopyArea(src, src.X, Console->Y, Display);
+    memmove(shown, shown + (uint32_t)lines * Console->Cols,
+        (uint32_t)(Console->Rows - lines) * Console->Cols *
+        sizeof(BGFX_Cell_t));
+  } else {
+    src.Y = Console->Y;
+    BGFX_CopyArea(src, src.X, Console->Y + lines * h, Display);
+    memmove(shown + (uint32_t)lines * Console->Cols, shown,
+        (uint32_t)(Console->Rows - lines) * Console->Cols *
+        sizeof(BGFX_Cell_t));
+  }
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a cell, background included
+    @param  Console Console
+    @param  x   Cell left side
+    @param  y   Cell top
+    @param  Cell    Character and attributes
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_ConsoleCell(const BGFX_Console_t *Console, int16_t x,
+    int16_t y, BGFX_Cell_t Cell, BGFX_Parameters_t Display)
+{
+  uint8_t size = Console->Size ? Console->Size : 1;
+  uint16_t fg = Console->Palette[Cell.Attr & 0x0F];
+  uint16_t bg = Console->Palette[Cell.Attr >> 4];
+
+  /* Blank cells, and cells DrawChar would leave transparent, are filled */
+  if ((Cell.Char == ' ') || (fg == bg)) {
+    BGFX_DrawRectFill(x, y, 6 * size, 8 * size, bg, Display);
+    return;
+  }
+  BGFX_DrawChar(x, y, Cell.Char, fg, bg, size, size, Display);
+}
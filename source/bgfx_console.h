@@ -0,0 +1,156 @@
+/**
+ * @file  bgfx_console.h
+ * @date  19-October-2026
+ * @brief Text console: character cell grid, scrollback and incremental
+ *        redraw.
+ *
+ * @author
+ * @author
+ *
+ * The console is a grid of Cols x Rows cells of the classic 6x8 font,
+ * scaled by Size. Each cell holds a character and its attributes, two
+ * indices in a 16 colors palette. BGFX_ConsoleWrite takes a byte stream and
+ * only updates the grid, so it can be called at any rate; BGFX_ConsoleDraw
+ * then brings the display up to date:
+ *  - lines scrolled since the last draw are moved with one BGFX_CopyArea,
+ *    with no text rendered again,
+ *  - only the cells whose character or attributes differ from what is on
+ *    the display are drawn.
+ * The grid is a ring of Rows + Scrollback lines, lines leaving the top of
+ * the screen stay available to BGFX_ConsoleScrollBack.
+ *
+ * Control characters: '\n' moves to the start of the next line, '\r' to the
+ * start of the line, '\b' one column back, '\t' to the next multiple of 8
+ * columns and '\f' clears the screen. Other bytes below 0x20 are ignored,
+ * the others are characters of the font. A line full of characters wraps
+ * on the next character.
+ *
+ * Pixels are only moved when the console is fully on the display and the
+ * buffer can be read back: no user DrawPixel function, no band and no clip
+ * rectangle. Otherwise the cells that changed are drawn again.
+ */
+
+#ifndef BGFX_CONSOLE_H
+#define BGFX_CONSOLE_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! Number of BGFX_Cell_t of a console: ring of lines and cells on display */
+#define BGFX_CONSOLE_STORAGE(cols, rows, scrollback)                          \
+    ((uint32_t)(cols) * ((rows) * 2 + (scrollback)))
+
+/*! Cell attributes from foreground and background palette indices */
+#define BGFX_ATTR(fg, bg) ((uint8_t)((((bg) & 0x0F) << 4) | ((fg) & 0x0F)))
+
+
+/**
+ * @brief Character cell
+ */
+typedef struct
+{
+  uint8_t Char;         /*!< Character of the classic font */
+  uint8_t Attr;         /*!< Foreground palette index in the low nibble,
+                             background in the high nibble */
+}BGFX_Cell_t;
+
+
+/**
+ * @brief Text console. The fields up to Cells are set by the caller, the
+ *        others are handled by the console functions.
+ */
+typedef struct
+{
+  int16_t X;            /*!< Top left corner x coordinate */
+  int16_t Y;            /*!< Top left corner y coordinate */
+  uint8_t Cols;         /*!< Characters per line */
+  uint8_t Rows;         /*!< Lines on the screen */
+  uint16_t Scrollback;  /*!< Lines kept above the screen */
+  uint8_t Size;         /*!< Font size multiplier, 0 is the same as 1 */
+  const uint16_t *Palette; /*!< 16 display colors indexed by attributes */
+  uint8_t Attr;         /*!< Attributes of the characters written, may be
+                             changed between writes */
+  BGFX_Cell_t *Cells;   /*!< BGFX_CONSOLE_STORAGE(Cols, Rows, Scrollback)
+                             cells */
+
+  uint16_t First;       /*!< Ring line of the top row of the screen */
+  uint16_t History;     /*!< Lines above the screen holding text */
+  uint16_t View;        /*!< Lines scrolled back, 0 follows the output */
+  uint8_t Col;          /*!< Cursor column, Cols when the next character
+                             wraps */
+  uint8_t Row;          /*!< Cursor row */
+  uint32_t Top;         /*!< Lines scrolled out of the screen since init */
+  uint32_t ShownTop;    /*!< Value of Top - View on the display */
+  uint8_t Valid;        /*!< Set once drawn, cleared to draw everything */
+}BGFX_Console_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Reset a console: empty screen and scrollback, cursor home. The
+            whole console is drawn on the next BGFX_ConsoleDraw.
+    @param  Console Console, with the caller fields set
+ */
+/**************************************************************************/
+void BGFX_ConsoleInit(BGFX_Console_t *Console);
+
+
+/**************************************************************************/
+/*!
+    @brief  Write bytes to a console, characters and control characters.
+            Only the grid is updated. The view goes back to the bottom.
+    @param  Console Console to write to
+    @param  Data    Bytes to write
+    @param  Length  Number of bytes
+ */
+/**************************************************************************/
+void BGFX_ConsoleWrite(BGFX_Console_t *Console, const uint8_t *Data,
+    uint32_t Length);
+
+
+/**************************************************************************/
+/*!
+    @brief  Show older lines, the change is drawn by BGFX_ConsoleDraw
+    @param  Console Console
+    @param  Lines   Lines to scroll back from the bottom, 0 for the newest
+            lines, limited to the lines kept
+ */
+/**************************************************************************/
+void BGFX_ConsoleScrollBack(BGFX_Console_t *Console, uint16_t Lines);
+
+
+/**************************************************************************/
+/*!
+    @brief  Have the whole console drawn again on the next BGFX_ConsoleDraw
+    @param  Console Console
+ */
+/**************************************************************************/
+void BGFX_ConsoleInvalidate(BGFX_Console_t *Console);
+
+
+/**************************************************************************/
+/*!
+    @brief  Bring the display up to date with the grid: scroll the pixels,
+            then draw the cells that changed
+    @param  Console Console to draw
+    @param  Region  Returns the area changed, screen coordinates, empty if
+            nothing changed, may be NULL
+    @param  Display Structure to display parameters and functions
+    @return 1 if something was drawn, 0 otherwise
+ */
+/**************************************************************************/
+uint8_t BGFX_ConsoleDraw(BGFX_Console_t *Console, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_CONSOLE_H */
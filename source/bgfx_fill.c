@@ -0,0 +1,455 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_fill.h"
+
+
+/**
+ * @brief Working state of a fill, in line coordinates: U along a line, V
+ *        from one line to the next
+ */
+typedef struct
+{
+  uint8_t *Buffer;      /*!< Framebuffer */
+  uint16_t Stride;      /*!< WIDTH of the display */
+  uint8_t Bytes;        /*!< Bytes per pixel, 0 for monochromatic */
+  uint8_t Boundary;     /*!< 0: inside is Target, 1: inside is neither
+                             Target nor Color */
+  uint16_t Target;      /*!< Color of the region, or of the border */
+  uint16_t Color;       /*!< Fill color */
+  int16_t U0;           /*!< First position along a line, clip included */
+  int16_t U1;           /*!< Last position along a line, clip included */
+  int16_t V0;           /*!< First line, clip included */
+  int16_t V1;           /*!< Last line, clip included */
+  BGFX_FillSpan_t *Stack; /*!< Runs waiting to be searched */
+  uint16_t Capacity;    /*!< Number of entries in Stack */
+  uint16_t Count;       /*!< Number of runs on the stack */
+  uint8_t Full;         /*!< Set when a run was dropped */
+}BGFX_FillJob_t;
+
+
+static int BGFX_FillStart(BGFX_FillJob_t *Job, int16_t x, int16_t y,
+    uint16_t color, int16_t *U, int16_t *V, BGFX_Parameters_t Display);
+
+static int BGFX_FillRegion(BGFX_FillJob_t *Job, int16_t u, int16_t v,
+    BGFX_FillSpan_t *Stack, uint16_t Capacity);
+
+static void BGFX_FillPush(BGFX_FillJob_t *Job, int16_t Left, int16_t Right,
+    int16_t Line, int8_t Dir);
+
+static uint16_t BGFX_FillRead(const BGFX_FillJob_t *Job, int16_t u,
+    int16_t v);
+
+static uint8_t BGFX_FillInside(const BGFX_FillJob_t *Job, int16_t u,
+    int16_t v);
+
+static uint8_t BGFX_FillByte(const BGFX_FillJob_t *Job, int16_t u,
+    int16_t v);
+
+static int16_t BGFX_FillScan(const BGFX_FillJob_t *Job, int16_t u, int16_t v,
+    int8_t Step, int16_t Limit);
+
+static int16_t BGFX_FillSkip(const BGFX_FillJob_t *Job, int16_t u, int16_t v,
+    int16_t Limit);
+
+static void BGFX_FillWrite(const BGFX_FillJob_t *Job, int16_t u0, int16_t u1,
+    int16_t v);
+
+
+
+int BGFX_FloodFill(int16_t x, int16_t y, uint16_t color,
+    BGFX_FillSpan_t *Stack, uint16_t Capacity, BGFX_Parameters_t Display)
+{
+  BGFX_FillJob_t job;
+  int16_t u, v;
+  int start = BGFX_FillStart(&job, x, y, color, &u, &v, Display);
+
+  if (start <= 0) {
+    return start;
+  }
+
+  job.Target = BGFX_FillRead(&job, u, v);
+  job.Boundary = 0;
+  if (job.Target == job.Color) {
+    return 0;
+  }
+  return BGFX_FillRegion(&job, u, v, Stack, Capacity);
+}
+
+
+
+
+int BGFX_BoundaryFill(int16_t x, int16_t y, uint16_t color, uint16_t border,
+    BGFX_FillSpan_t *Stack, uint16_t Capacity, BGFX_Parameters_t Display)
+{
+  BGFX_FillJob_t job;
+  int16_t u, v;
+  int start = BGFX_FillStart(&job, x, y, color, &u, &v, Display);
+
+  if (start <= 0) {
+    return start;
+  }
+
+  if (job.Bytes == 0) {
+    /* A pixel is either color or border: nothing to fill if they differ,
+     * otherwise the region is the other value, as a flood fill */
+    if (job.Color != (border != 0)) {
+      return 0;
+    }
+    job.Target = job.Color ^ 1;
+    job.Boundary = 0;
+  } else {
+    job.Target = (job.Bytes == 2) ? border : (border & 0xFF);
+    job.Boundary = 1;
+  }
+  return BGFX_FillRegion(&job, u, v, Stack, Capacity);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Set up the buffer and clip of a fill and find the seed. Lines
+            are buffer rows on 8 and 16 bits buffers, and follow the packed
+            axis (A) of monochromatic buffers, see BGFX_DrawPixel_01.
+    @param  Job     Working state to initialize, region left to the caller
+    @param  x       Seed x coordinate
+    @param  y       Seed y coordinate
+    @param  color   Fill color
+    @param  U       Returns the seed position along its line
+    @param  V       Returns the line of the seed
+    @param  Display Structure to display parameters and functions
+    @return 1 if the fill can go on, 0 if the seed is outside the clip
+            rectangle, -1 if the buffer cannot be read back
+ */
+/**************************************************************************/
+static int BGFX_FillStart(BGFX_FillJob_t *Job, int16_t x, int16_t y,
+    uint16_t color, int16_t *U, int16_t *V, BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip, seed = {0, 0, 1, 1};
+  int16_t t;
+
+  if ((Display.DrawPixel != NULL) || (Display.Buffer == NULL) ||
+      (Display.BandHeight > 0))
+  {
+    return -1;
+  }
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+  if ((x < clip.X) || (y < clip.Y) || (x >= clip.X + clip.W) ||
+      (y >= clip.Y + clip.H))
+  {
+    return 0;
+  }
+
+  /* The region is the same in buffer coordinates */
+  seed.X = x;
+  seed.Y = y;
+  seed = BGFX_RectToBuffer(seed, Display);
+  clip = BGFX_RectToBuffer(clip, Display);
+
+  Job->Buffer = (uint8_t *)Display.Buffer;
+  Job->Stride = Display.WIDTH;
+  switch (Display.ColorScheme) {
+  case BGFX_16BITS:
+    Job->Bytes = 2;
+    Job->Color = color;
+    break;
+  case BGFX_8BITS:
+  case BGFX_INDEXED8:
+    Job->Bytes = 1;
+    Job->Color = color & 0xFF;
+    break;
+  default:
+    Job->Bytes = 0;
+    Job->Color = (color != 0);
+    break;
+  }
+
+  if ((Job->Bytes == 0) && (Display.HeightPixelsOnWrite > 1) &&
+      (Display.WidthPixelsOnWrite == 1))
+  {
+    /* Pages: bits along y */
+    t = seed.X; seed.X = seed.Y; seed.Y = t;
+    t = clip.X; clip.X = clip.Y; clip.Y = t;
+    t = clip.W; clip.W = clip.H; clip.H = t;
+  }
+  Job->U0 = clip.X;
+  Job->U1 = clip.X + clip.W - 1;
+  Job->V0 = clip.Y;
+  Job->V1 = clip.Y + clip.H - 1;
+  *U = seed.X;
+  *V = seed.Y;
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill the region around a seed, Heckbert's scanline seed fill.
+            Every run popped was filled on its line; the next line (Line +
+            Dir) is searched below it, runs found there are filled and
+            pushed to search further, and the parts of them sticking out of
+            the run popped are pushed back towards its line.
+    @param  Job     Working state, colors set
+    @param  u       Seed position along its line
+    @param  v       Line of the seed
+    @param  Stack   Memory for the runs waiting to be searched
+    @param  Capacity    Number of entries in Stack
+    @return 0 when the region is filled, 1 if runs were dropped because the
+            stack was full
+ */
+/**************************************************************************/
+static int BGFX_FillRegion(BGFX_FillJob_t *Job, int16_t u, int16_t v,
+    BGFX_FillSpan_t *Stack, uint16_t Capacity)
+{
+  BGFX_FillSpan_t run;
+  int16_t l, r, line;
+
+  if (!BGFX_FillInside(Job, u, v)) {
+    return 0;
+  }
+  Job->Stack = Stack;
+  Job->Capacity = (Stack != NULL) ? Capacity : 0;
+  Job->Count = 0;
+  Job->Full = 0;
+
+  l = BGFX_FillScan(Job, u, v, -1, Job->U0);
+  r = BGFX_FillScan(Job, u, v, 1, Job->U1);
+  BGFX_FillWrite(Job, l, r, v);
+  BGFX_FillPush(Job, l, r, v, 1);
+  BGFX_FillPush(Job, l, r, v, -1);
+
+  while (Job->Count > 0) {
+    run = Stack[--Job->Count];
+    line = run.Line + run.Dir;
+
+    /* First run of the line: it may start left of the run popped */
+    if (BGFX_FillInside(Job, run.Left, line)) {
+      l = BGFX_FillScan(Job, run.Left, line, -1, Job->U0);
+      if (l < run.Left) {
+        BGFX_FillPush(Job, l, run.Left - 1, line, -run.Dir);
+      }
+    } else {
+      l = BGFX_FillSkip(Job, run.Left + 1, line, run.Right);
+    }
+
+    /* Runs starting below the run popped */
+    while (l <= run.Right) {
+      r = BGFX_FillScan(Job, l, line, 1, Job->U1);
+      BGFX_FillWrite(Job, l, r, line);
+      BGFX_FillPush(Job, l, r, line, run.Dir);
+      if (r > run.Right) {
+        BGFX_FillPush(Job, run.Right + 1, r, line, -run.Dir);
+      }
+      if (r + 2 > run.Right) {
+        break;
+      }
+      l = BGFX_FillSkip(Job, r + 2, line, run.Right);
+    }
+  }
+  return Job->Full;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Push a run to search the line next to it, unless that line is
+            outside the clip rectangle. The run is dropped if the stack is
+            full.
+    @param  Job     Working state
+    @param  Left    First pixel of the run
+    @param  Right   Last pixel of the run
+    @param  Line    Line of the run
+    @param  Dir     Line to search, Line + Dir
+ */
+/**************************************************************************/
+static void BGFX_FillPush(BGFX_FillJob_t *Job, int16_t Left, int16_t Right,
+    int16_t Line, int8_t Dir)
+{
+  BGFX_FillSpan_t *span;
+
+  if ((Line + Dir < Job->V0) || (Line + Dir > Job->V1)) {
+    return;
+  }
+  if (Job->Count >= Job->Capacity) {
+    Job->Full = 1;
+    return;
+  }
+  span = &Job->Stack[Job->Count++];
+  span->Left = Left;
+  span->Right = Right;
+  span->Line = Line;
+  span->Dir = Dir;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Read a pixel
+    @param  Job     Working state
+    @param  u       Position along the line
+    @param  v       Line
+    @return Pixel value, 0 or 1 on monochromatic buffers
+ */
+/**************************************************************************/
+static uint16_t BGFX_FillRead(const BGFX_FillJob_t *Job, int16_t u,
+    int16_t v)
+{
+  int32_t index = (int32_t)v * Job->Stride + u;
+
+  switch (Job->Bytes) {
+  case 2:
+    return ((uint16_t *)Job->Buffer)[index];
+  case 1:
+    return Job->Buffer[index];
+  default:
+    return (Job->Buffer[(int32_t)(u >> 3) * Job->Stride + v] >> (u & 7)) & 1;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Tell if a pixel belongs to the region and is not filled yet
+    @param  Job     Working state
+    @param  u       Position along the line
+    @param  v       Line
+    @return 1 if the pixel is to be filled
+ */
+/**************************************************************************/
+static uint8_t BGFX_FillInside(const BGFX_FillJob_t *Job, int16_t u,
+    int16_t v)
+{
+  uint16_t pixel = BGFX_FillRead(Job, u, v);
+
+  if (Job->Boundary) {
+    return (pixel != Job->Target) && (pixel != Job->Color);
+  }
+  return pixel == Job->Target;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Read the 8 pixels of a monochromatic byte as inside bits
+    @param  Job     Working state, monochromatic
+    @param  u       Position along the line, any pixel of the byte
+    @param  v       Line
+    @return Bit i set if pixel i of the byte is inside
+ */
+/**************************************************************************/
+static uint8_t BGFX_FillByte(const BGFX_FillJob_t *Job, int16_t u,
+    int16_t v)
+{
+  uint8_t byte = Job->Buffer[(int32_t)(u >> 3) * Job->Stride + v];
+
+  return Job->Target ? byte : (uint8_t)~byte;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Extend a run from an inside pixel for as long as the pixels are
+            inside. Whole bytes are stepped over on monochromatic buffers.
+    @param  Job     Working state
+    @param  u       Inside pixel to start from
+    @param  v       Line
+    @param  Step    1 to go right (up the line), -1 to go left
+    @param  Limit   Last position that may be reached
+    @return Last inside pixel of the run in the Step direction
+ */
+/**************************************************************************/
+static int16_t BGFX_FillScan(const BGFX_FillJob_t *Job, int16_t u, int16_t v,
+    int8_t Step, int16_t Limit)
+{
+  while (u != Limit) {
+    if (Job->Bytes == 0) {
+      if ((Step > 0) && (((u + 1) & 7) == 0) && (u + 8 <= Limit) &&
+          (BGFX_FillByte(Job, u + 1, v) == 0xFF))
+      {
+        u += 8;
+        continue;
+      }
+      if ((Step < 0) && ((u & 7) == 0) && (u - 8 >= Limit) &&
+          (BGFX_FillByte(Job, u - 1, v) == 0xFF))
+      {
+        u -= 8;
+        continue;
+      }
+    }
+    if (!BGFX_FillInside(Job, u + Step, v)) {
+      break;
+    }
+    u += Step;
+  }
+  return u;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Find the next inside pixel of a line. Bytes with no inside pixel
+            are skipped whole on monochromatic buffers.
+    @param  Job     Working state
+    @param  u       First position to look at
+    @param  v       Line
+    @param  Limit   Last position to look at
+    @return First inside pixel from u, Limit + 1 if there is none
+ */
+/**************************************************************************/
+static int16_t BGFX_FillSkip(const BGFX_FillJob_t *Job, int16_t u, int16_t v,
+    int16_t Limit)
+{
+  while (u <= Limit) {
+    if ((Job->Bytes == 0) && ((u & 7) == 0) && (u + 7 <= Limit) &&
+        (BGFX_FillByte(Job, u, v) == 0))
+    {
+      u += 8;
+      continue;
+    }
+    if (BGFX_FillInside(Job, u, v)) {
+      return u;
+    }
+    u++;
+  }
+  return Limit + 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Write the fill color to a run of a line
+    @param  Job     Working state
+    @param  u0      First pixel of the run
+    @param  u1      Last pixel of the run
+    @param  v       Line
+ */
+/**************************************************************************/
+static void BGFX_FillWrite(const BGFX_FillJob_t *Job, int16_t u0, int16_t u1,
+    int16_t v)
+{
+  int32_t index = (int32_t)v * Job->Stride + u0;
+  int16_t g, lo, hi;
+  uint8_t mask, *ptr;
+
+  switch (Job->Bytes) {
+  case 2:
+    for (; u0 <= u1; u0++, index++) {
+      ((uint16_t *)Job->Buffer)[index] = Job->Color;
+    }
+    break;
+  case 1:
+    memset(Job->Buffer + index, Job->Color, u1 - u0 + 1);
+    break;
+  default:
+    for (g = u0 >> 3; g <= (u1 >> 3); g++) {
+      lo = (g == (u0 >> 3)) ? (u0 & 7) : 0;
+      hi = (g == (u1 >> 3)) ? (u1 & 7) : 7;
+      mask = (uint8_t)((0xFF << lo) & (0xFF >> (7 - hi)));
+      ptr = Job->Buffer + (int32_t)g * Job->Stride + v;
+      *ptr = Job->Color ? (*ptr | mask) : (*ptr & ~mask);
+    }
+    break;
+  }
+}
@@ -0,0 +1,100 @@
+/**
+ * @file  bgfx_fill.h
+ * @date  19-October-2026
+ * @brief Region fills: flood fill and boundary fill.
+ *
+ * @author
+ * @author
+ *
+ * BGFX_FloodFill recolors the 4-connected region of pixels that have the
+ * color of the seed pixel; BGFX_BoundaryFill fills outwards from the seed
+ * until a border color, for shapes drawn in one color over any background.
+ *
+ * Both are scanline span fills: a run of pixels is found and written at
+ * once, then the lines above and below are searched for runs touching it.
+ * The runs left to search are kept on a stack given by the caller, there is
+ * no recursion, so memory use is fixed whatever the shape. If the stack
+ * gets full the runs that do not fit are dropped, the fill goes on with the
+ * others and reports it; a few dozen entries are enough for most shapes,
+ * deep spirals and combs need about one entry per branch.
+ *
+ * The fill works in buffer (unrotated) coordinates, where the region is the
+ * same. Lines are buffer rows on 8 and 16 bits buffers; on monochromatic
+ * buffers they follow the packed axis, so runs are searched and written a
+ * byte (8 pixels) at a time where the byte is all inside.
+ *
+ * Filling needs a buffer that can be read back: no user DrawPixel function
+ * and no band. The fill stays inside the clip rectangle, the raster
+ * operation is not applied.
+ */
+
+#ifndef BGFX_FILL_H
+#define BGFX_FILL_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Run of pixels waiting for the line next to it to be searched
+ */
+typedef struct
+{
+  int16_t Left;         /*!< First pixel of the run along the line */
+  int16_t Right;        /*!< Last pixel of the run along the line */
+  int16_t Line;         /*!< Line of the run */
+  int8_t Dir;           /*!< Line to search, Line + Dir, 1 or -1 */
+}BGFX_FillSpan_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill the region of pixels connected to a seed that have the same
+            color as the seed (4-connected)
+    @param  x   Seed x coordinate
+    @param  y   Seed y coordinate
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  Stack   Memory for the runs waiting to be searched
+    @param  Capacity    Number of entries in Stack
+    @param  Display Structure to display parameters and functions
+    @return 0 when the region is filled (or the seed is outside the clip
+            rectangle or already has the color), 1 if the stack got full
+            and part of the region may be left, -1 if the buffer cannot be
+            read back
+ */
+/**************************************************************************/
+int BGFX_FloodFill(int16_t x, int16_t y, uint16_t color,
+    BGFX_FillSpan_t *Stack, uint16_t Capacity, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill the region around a seed up to a border color
+            (4-connected). Pixels already of the fill color are not crossed
+            either.
+    @param  x   Seed x coordinate
+    @param  y   Seed y coordinate
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  border  16-bit 5-6-5 Color of the border
+    @param  Stack   Memory for the runs waiting to be searched
+    @param  Capacity    Number of entries in Stack
+    @param  Display Structure to display parameters and functions
+    @return 0 when the region is filled (or the seed is outside the clip
+            rectangle or on the border), 1 if the stack got full and part of
+            the region may be left, -1 if the buffer cannot be read back
+ */
+/**************************************************************************/
+int BGFX_BoundaryFill(int16_t x, int16_t y, uint16_t color, uint16_t border,
+    BGFX_FillSpan_t *Stack, uint16_t Capacity, BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_FILL_H */
@@ -0,0 +1,433 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include "bgfx_gradient.h"
+#include "bgfx_spans.h"
+
+
+#ifndef BGFX_GRADIENT_CHUNK
+#define BGFX_GRADIENT_CHUNK 64 /*!< Pixels shaded before each BGFX_WriteSpan */
+#endif
+
+#define BGFX_T_END  (255L << 16) /*!< Gradient position of the last stop */
+
+
+/**
+ * @brief Working state of a gradient fill, handed to the span function
+ */
+typedef struct
+{
+  const BGFX_Gradient_t *Gradient;  /*!< Gradient being drawn */
+  BGFX_Parameters_t *Display;       /*!< Display being drawn to */
+  int32_t DtDx;         /*!< Linear: position increment per pixel to the right */
+  int32_t DtDy;         /*!< Linear: position increment per pixel down */
+  int64_t Radius2;      /*!< Radial: squared radius */
+  int32_t TPerDist;     /*!< Radial: position per 1/16 pixel of distance */
+  uint16_t Line[BGFX_GRADIENT_CHUNK]; /*!< Shaded pixels not yet written */
+  int16_t LineX;        /*!< Screen x of Line[0] */
+  int16_t LineY;        /*!< Screen y of Line[0] */
+  int16_t LineLength;   /*!< Number of pixels in Line */
+}BGFX_GradientJob_t;
+
+
+/**
+ * @brief Ordered dither thresholds, 4x4 Bayer matrix
+ */
+static const uint8_t BGFX_Bayer4[4][4] = {
+    { 0,  8,  2, 10},
+    {12,  4, 14,  6},
+    { 3, 11,  1,  9},
+    {15,  7, 13,  5},
+};
+
+
+static void BGFX_GradientStart(BGFX_GradientJob_t *Job,
+    const BGFX_Gradient_t *Gradient, BGFX_Parameters_t *Display);
+
+static void BGFX_GradientSpan(int16_t x, int16_t y, int16_t w, void *Context);
+
+static void BGFX_GradientLinear(BGFX_GradientJob_t *Job, int16_t x,
+    int16_t y, int16_t w);
+
+static void BGFX_GradientRadial(BGFX_GradientJob_t *Job, int16_t x,
+    int16_t y, int16_t w);
+
+static void BGFX_StopComponents(const BGFX_Gradient_t *Gradient,
+    uint8_t Index, int32_t *c);
+
+static void BGFX_Put(BGFX_GradientJob_t *Job, const int32_t *c);
+
+static uint32_t BGFX_Sqrt64(uint64_t Value);
+
+
+
+void BGFX_DrawRectGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+    const BGFX_Gradient_t *Gradient, BGFX_Parameters_t Display)
+{
+  BGFX_GradientJob_t job;
+
+  if ((Gradient == NULL) || (Gradient->StopCount == 0)) {
+    return;
+  }
+  BGFX_GradientStart(&job, Gradient, &Display);
+  BGFX_SpansRect(x, y, w, h, BGFX_GradientSpan, &job, Display);
+}
+
+
+
+
+void BGFX_DrawRoundRectGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+    int16_t r, const BGFX_Gradient_t *Gradient, BGFX_Parameters_t Display)
+{
+  BGFX_GradientJob_t job;
+
+  if ((Gradient == NULL) || (Gradient->StopCount == 0)) {
+    return;
+  }
+  BGFX_GradientStart(&job, Gradient, &Display);
+  BGFX_SpansRoundRect(x, y, w, h, r, BGFX_GradientSpan, &job, Display);
+}
+
+
+
+
+void BGFX_DrawCircleGradient(int16_t x0, int16_t y0, int16_t r,
+    const BGFX_Gradient_t *Gradient, BGFX_Parameters_t Display)
+{
+  BGFX_GradientJob_t job;
+
+  if ((Gradient == NULL) || (Gradient->StopCount == 0)) {
+    return;
+  }
+  BGFX_GradientStart(&job, Gradient, &Display);
+  BGFX_SpansCircle(x0, y0, r, BGFX_GradientSpan, &job, Display);
+}
+
+
+
+
+void BGFX_DrawPolygonGradient(const int16_t *Points, uint16_t Count,
+    const BGFX_Gradient_t *Gradient, BGFX_Parameters_t Display)
+{
+  BGFX_GradientJob_t job;
+
+  if ((Gradient == NULL) || (Gradient->StopCount == 0)) {
+    return;
+  }
+  BGFX_GradientStart(&job, Gradient, &Display);
+  BGFX_SpansPolygon(Points, Count, BGFX_GradientSpan, &job, Display);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the per-fill constants of a gradient
+    @param  Job      Working state to initialize
+    @param  Gradient Gradient to draw
+    @param  Display  Display to draw to
+ */
+/**************************************************************************/
+static void BGFX_GradientStart(BGFX_GradientJob_t *Job,
+    const BGFX_Gradient_t *Gradient, BGFX_Parameters_t *Display)
+{
+  int64_t dx = Gradient->X1 - Gradient->X0;
+  int64_t dy = Gradient->Y1 - Gradient->Y0;
+  int64_t len2 = dx * dx + dy * dy;
+  uint16_t radius = (Gradient->Radius > 0) ? Gradient->Radius : 1;
+
+  Job->Gradient = Gradient;
+  Job->Display = Display;
+  Job->LineLength = 0;
+
+  /* Linear: position is the projection on the axis, scaled to 0..255 */
+  Job->DtDx = (len2 > 0) ? (int32_t)((dx * BGFX_T_END) / len2) : 0;
+  Job->DtDy = (len2 > 0) ? (int32_t)((dy * BGFX_T_END) / len2) : 0;
+
+  /* Radial: position is the distance to the center, scaled to 0..255 */
+  Job->Radius2 = (int64_t)radius * radius;
+  Job->TPerDist = (int32_t)((255L << 12) / radius);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Shade one span and send it to the display
+    @param  x   Left-most pixel x coordinate
+    @param  y   Row y coordinate
+    @param  w   Number of pixels
+    @param  Context Gradient working state
+ */
+/**************************************************************************/
+static void BGFX_GradientSpan(int16_t x, int16_t y, int16_t w, void *Context)
+{
+  BGFX_GradientJob_t *job = (BGFX_GradientJob_t *)Context;
+
+  job->LineX = x;
+  job->LineY = y;
+  job->LineLength = 0;
+
+  if (job->Gradient->Type == BGFX_GRADIENT_RADIAL) {
+    BGFX_GradientRadial(job, x, y, w);
+  } else {
+    BGFX_GradientLinear(job, x, y, w);
+  }
+
+  if (job->LineLength > 0) {
+    BGFX_WriteSpan(job->LineX, job->LineY, job->LineLength, job->Line,
+        *job->Display);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Shade a span of a linear gradient. The position moves by a
+            constant amount per pixel, so the span is cut where it crosses
+            color stops and the color components are stepped inside each
+            piece, without multiplications in the pixel loop.
+    @param  Job Gradient working state
+    @param  x   Left-most pixel x coordinate
+    @param  y   Row y coordinate
+    @param  w   Number of pixels
+ */
+/**************************************************************************/
+static void BGFX_GradientLinear(BGFX_GradientJob_t *Job, int16_t x,
+    int16_t y, int16_t w)
+{
+  const BGFX_Gradient_t *g = Job->Gradient;
+  int64_t t0 = (int64_t)(x - g->X0) * Job->DtDx +
+      (int64_t)(y - g->Y0) * Job->DtDy;
+  int32_t step = Job->DtDx;
+  int32_t c[3], c1[3], dc[3];
+  int32_t i = 0, n, j;
+  uint8_t k;
+
+  while (i < w) {
+    int64_t t = t0 + (int64_t)step * i;
+    int64_t lo, hi;
+
+    /* Find the stop segment [lo, hi) holding t, or the flat ends */
+    k = 0;
+    while ((k < g->StopCount) && (t >= ((int64_t)g->Stops[k].Offset << 16))) {
+      k++;
+    }
+    lo = (k == 0) ? INT64_MIN : ((int64_t)g->Stops[k - 1].Offset << 16);
+    hi = (k == g->StopCount) ? INT64_MAX : ((int64_t)g->Stops[k].Offset << 16);
+
+    /* Number of pixels before t leaves the segment */
+    if ((step > 0) && (hi != INT64_MAX)) {
+      n = (int32_t)((hi - t + step - 1) / step);
+    } else if ((step < 0) && (lo != INT64_MIN)) {
+      n = (int32_t)((t - lo) / -step) + 1;
+    } else {
+      n = w - i;
+    }
+    if (n > w - i) {
+      n = w - i;
+    }
+
+    /* Color at the first pixel and increment per pixel */
+    if ((k == 0) || (k == g->StopCount)) {
+      BGFX_StopComponents(g, (k == 0) ? 0 : k - 1, c);
+      dc[0] = dc[1] = dc[2] = 0;
+    } else {
+      int32_t span = (int32_t)(hi - lo);
+      BGFX_StopComponents(g, k - 1, c);
+      BGFX_StopComponents(g, k, c1);
+      for (j = 0; j < 3; j++) {
+        int32_t delta = c1[j] - c[j];
+        c[j] += (int32_t)(((int64_t)delta * (t - lo)) / span);
+        dc[j] = (int32_t)(((int64_t)delta * step) / span);
+      }
+    }
+
+    for (j = 0; j < n; j++) {
+      BGFX_Put(Job, c);
+      c[0] += dc[0];
+      c[1] += dc[1];
+      c[2] += dc[2];
+    }
+    i += n;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Shade a span of a radial gradient. The squared distance to the
+            center is updated with additions and its square root is tracked
+            from the previous pixel, in 1/16 pixel steps. Colors are the
+            start of the stop segment plus a slope per position, both
+            computed when the segment changes.
+    @param  Job Gradient working state
+    @param  x   Left-most pixel x coordinate
+    @param  y   Row y coordinate
+    @param  w   Number of pixels
+ */
+/**************************************************************************/
+static void BGFX_GradientRadial(BGFX_GradientJob_t *Job, int16_t x,
+    int16_t y, int16_t w)
+{
+  const BGFX_Gradient_t *g = Job->Gradient;
+  int64_t dx = x - g->X0;
+  int64_t dy = y - g->Y0;
+  int64_t d2 = dx * dx + dy * dy;
+  uint64_t q, s = 0, s2 = 0;
+  int32_t c[3], c0[3], c1[3];
+  int64_t slope[3];
+  int32_t t, lo = 0;
+  int16_t i;
+  uint16_t segment = 0xFFFF;
+  uint8_t k = 0, j;
+  uint8_t tracked = 0;
+
+  for (i = 0; i < w; i++) {
+    if (d2 >= Job->Radius2) {
+      t = BGFX_T_END;
+      tracked = 0;
+    } else if (!tracked) {
+      s = BGFX_Sqrt64((uint64_t)d2 << 8);
+      s2 = s * s;
+      tracked = 1;
+      t = (int32_t)s * Job->TPerDist;
+    } else {
+      /* Distance moves by at most one pixel, a few steps of s at most */
+      q = (uint64_t)d2 << 8;
+      while (s2 + 2 * s + 1 <= q) {
+        s2 += 2 * s + 1;
+        s++;
+      }
+      while (s2 > q) {
+        s--;
+        s2 -= 2 * s + 1;
+      }
+      t = (int32_t)s * Job->TPerDist;
+    }
+
+    /* Stop segment, usually the same as for the previous pixel */
+    while ((k > 0) && (t < ((int32_t)g->Stops[k - 1].Offset << 16))) {
+      k--;
+    }
+    while ((k < g->StopCount) && (t >= ((int32_t)g->Stops[k].Offset << 16))) {
+      k++;
+    }
+    if (k != segment) {
+      /* Slope in 8.16 color units per position, 24 bits of fraction */
+      segment = k;
+      if ((k == 0) || (k == g->StopCount)) {
+        BGFX_StopComponents(g, (k == 0) ? 0 : k - 1, c0);
+        lo = 0;
+        slope[0] = slope[1] = slope[2] = 0;
+      } else {
+        lo = (int32_t)g->Stops[k - 1].Offset << 16;
+        BGFX_StopComponents(g, k - 1, c0);
+        BGFX_StopComponents(g, k, c1);
+        for (j = 0; j < 3; j++) {
+          slope[j] = (int64_t)(c1[j] - c0[j]) * (1L << 24) /
+              (((int32_t)g->Stops[k].Offset << 16) - lo);
+        }
+      }
+    }
+    for (j = 0; j < 3; j++) {
+      c[j] = c0[j] + (int32_t)(((t - lo) * slope[j]) >> 24);
+    }
+    BGFX_Put(Job, c);
+
+    /* (dx + 1)^2 = dx^2 + 2 * dx + 1 */
+    d2 += 2 * dx + 1;
+    dx++;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Color components of a stop, in 8.16 fixed point. 5-6-5 colors
+            keep their dropped low bits at zero, so dithering an exact stop
+            color leaves it unchanged.
+    @param  Gradient Gradient owning the stop
+    @param  Index    Stop index
+    @param  c        Red, green and blue components, or gray three times
+ */
+/**************************************************************************/
+static void BGFX_StopComponents(const BGFX_Gradient_t *Gradient,
+    uint8_t Index, int32_t *c)
+{
+  uint16_t color = Gradient->Stops[Index].Color;
+
+  if (Gradient->Format == BGFX_GRADIENT_GRAY8) {
+    c[0] = c[1] = c[2] = (int32_t)(color & 0xFF) << 16;
+  } else {
+    c[0] = (int32_t)((color >> 11) << 3) << 16;
+    c[1] = (int32_t)(((color >> 5) & 0x3F) << 2) << 16;
+    c[2] = (int32_t)((color & 0x1F) << 3) << 16;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Pack one shaded pixel into the line, flushing it when full
+    @param  Job Gradient working state
+    @param  c   Red, green and blue components, 8.16 fixed point
+ */
+/**************************************************************************/
+static void BGFX_Put(BGFX_GradientJob_t *Job, const int32_t *c)
+{
+  int32_t r = c[0] >> 16, g = c[1] >> 16, b = c[2] >> 16;
+  uint8_t d;
+
+  /* Stepping may overshoot a stop by a rounding error */
+  r = (r < 0) ? 0 : r;
+  g = (g < 0) ? 0 : g;
+  b = (b < 0) ? 0 : b;
+
+  if (Job->Gradient->Format == BGFX_GRADIENT_GRAY8) {
+    Job->Line[Job->LineLength] = (r > 255) ? 255 : r;
+  } else {
+    if (Job->Gradient->Dither) {
+      d = BGFX_Bayer4[Job->LineY & 3][(Job->LineX + Job->LineLength) & 3];
+      r += d >> 1;
+      g += d >> 2;
+      b += d >> 1;
+    }
+    r = (r > 255) ? 31 : r >> 3;
+    g = (g > 255) ? 63 : g >> 2;
+    b = (b > 255) ? 31 : b >> 3;
+    Job->Line[Job->LineLength] = (r << 11) | (g << 5) | b;
+  }
+
+  if (++Job->LineLength == BGFX_GRADIENT_CHUNK) {
+    BGFX_WriteSpan(Job->LineX, Job->LineY, Job->LineLength, Job->Line,
+        *Job->Display);
+    Job->LineX += Job->LineLength;
+    Job->LineLength = 0;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Integer square root
+    @param  Value Number to take the root of
+    @return Largest integer whose square is not above Value
+ */
+/**************************************************************************/
+static uint32_t BGFX_Sqrt64(uint64_t Value)
+{
+  uint64_t root = 0;
+  uint64_t bit = (uint64_t)1 << 62;
+
+  while (bit > Value) {
+    bit >>= 2;
+  }
+  while (bit != 0) {
+    if (Value >= root + bit) {
+      Value -= root + bit;
+      root = (root >> 1) + bit;
+    } else {
+      root >>= 1;
+    }
+    bit >>= 2;
+  }
+  return (uint32_t)root;
+}
@@ -0,0 +1,138 @@
+/**
+ * @file  bgfx_gradient.h
+ * @date  19-October-2026
+ * @brief Linear and radial gradient fills.
+ *
+ * @author
+ * @author
+ *
+ * Shapes are split into spans by bgfx_spans.h. For every span the gradient
+ * position is computed once in 16.16 fixed point, then stepped from pixel to
+ * pixel, and the colors are written with BGFX_WriteSpan. An optional 4x4
+ * ordered dither hides the banding of 5-6-5 colors.
+ */
+
+#ifndef BGFX_GRADIENT_H
+#define BGFX_GRADIENT_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Shapes of gradients.
+ */
+typedef enum
+{
+  BGFX_GRADIENT_LINEAR = 0, /*!< Colors change along the (X0,Y0)-(X1,Y1) axis */
+  BGFX_GRADIENT_RADIAL,     /*!< Colors change with the distance to (X0,Y0) */
+}BGFX_GradientType_t;
+
+
+/**
+ * @brief Color formats of gradients, the stops use the same format.
+ */
+typedef enum
+{
+  BGFX_GRADIENT_565 = 0,    /*!< 16-bit 5-6-5 colors */
+  BGFX_GRADIENT_GRAY8,      /*!< 8-bit grayscale, 0 is black */
+}BGFX_GradientFormat_t;
+
+
+/**
+ * @brief A color at a given position along the gradient
+ */
+typedef struct
+{
+  uint8_t Offset;       /*!< Position, 0 at the start and 255 at the end */
+  uint16_t Color;       /*!< Color at this position */
+}BGFX_ColorStop_t;
+
+
+/**
+ * @brief Description of a gradient, in screen coordinates
+ */
+typedef struct
+{
+  BGFX_GradientType_t Type;     /*!< Linear or radial */
+  BGFX_GradientFormat_t Format; /*!< Format of the stop colors and output */
+  uint8_t Dither;       /*!< If set, ordered dithering on 5-6-5 output */
+  int16_t X0;           /*!< Linear start point or radial center x */
+  int16_t Y0;           /*!< Linear start point or radial center y */
+  int16_t X1;           /*!< Linear end point x, unused by radial */
+  int16_t Y1;           /*!< Linear end point y, unused by radial */
+  uint16_t Radius;      /*!< Radial gradient radius, unused by linear */
+  const BGFX_ColorStop_t *Stops; /*!< Color stops sorted by Offset */
+  uint8_t StopCount;    /*!< Number of stops, at least 1 */
+}BGFX_Gradient_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle with a gradient
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  Gradient Gradient to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawRectGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+    const BGFX_Gradient_t *Gradient, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rounded rectangle with a gradient
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  r   Radius of corner rounding
+    @param  Gradient Gradient to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawRoundRectGradient(int16_t x, int16_t y, int16_t w, int16_t h,
+    int16_t r, const BGFX_Gradient_t *Gradient, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a circle with a gradient
+    @param  x0  Center-point x coordinate
+    @param  y0  Center-point y coordinate
+    @param  r   Radius of circle
+    @param  Gradient Gradient to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawCircleGradient(int16_t x0, int16_t y0, int16_t r,
+    const BGFX_Gradient_t *Gradient, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a polygon with a gradient, see BGFX_SpansPolygon for the
+            fill rule
+    @param  Points  Vertices as x, y pairs, 2 * Count values
+    @param  Count   Number of vertices
+    @param  Gradient Gradient to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawPolygonGradient(const int16_t *Points, uint16_t Count,
+    const BGFX_Gradient_t *Gradient, BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_GRADIENT_H */
@@ -0,0 +1,318 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_layer.h"
+
+
+static void BGFX_ComposeMono(BGFX_Compositor_t *Compositor, uint8_t First,
+    BGFX_Rect_t Region, BGFX_Parameters_t Display);
+
+static void BGFX_RowKey16(uint16_t *Dst, const uint16_t *Src, int16_t Count,
+    uint16_t Key);
+
+static void BGFX_RowAlpha565(uint16_t *Dst, const uint16_t *Src,
+    int16_t Count, uint16_t Key, uint8_t Alpha);
+
+static void BGFX_RowKey8(uint8_t *Dst, const uint8_t *Src, int16_t Count,
+    uint8_t Key);
+
+static void BGFX_RowAlpha8(uint8_t *Dst, const uint8_t *Src, int16_t Count,
+    uint8_t Key, uint8_t Alpha);
+
+
+
+void BGFX_LayerInit(BGFX_Layer_t *Layer, void *Buffer,
+    BGFX_Parameters_t Display)
+{
+  Layer->Surface = Display;
+  Layer->Surface.Buffer = Buffer;
+  Layer->Surface.DrawPixel = NULL;
+  Layer->Blend = BGFX_BLEND_OPAQUE;
+  Layer->ColorKey = 0;
+  Layer->Alpha = 255;
+  Layer->Hidden = 0;
+  Layer->Dirty.X = 0;
+  Layer->Dirty.Y = 0;
+  Layer->Dirty.W = Display.WIDTH;
+  Layer->Dirty.H = Display.HEIGHT;
+}
+
+
+
+
+void BGFX_LayerInvalidate(BGFX_Layer_t *Layer, int16_t x, int16_t y,
+    int16_t w, int16_t h)
+{
+  BGFX_Rect_t r;
+
+  r.X = x;
+  r.Y = y;
+  r.W = w;
+  r.H = h;
+  BGFX_RectUnion(&Layer->Dirty, BGFX_RectToBuffer(r, Layer->Surface));
+}
+
+
+
+
+int BGFX_CompositorAdd(BGFX_Compositor_t *Compositor, BGFX_Layer_t *Layer)
+{
+  if (Compositor->Count >= BGFX_MAX_LAYERS) {
+    return -1;
+  }
+
+  Compositor->Layers[Compositor->Count++] = Layer;
+  return 0;
+}
+
+
+
+
+uint8_t BGFX_Compose(BGFX_Compositor_t *Compositor, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t r = {0, 0, 0, 0};
+  BGFX_Layer_t *layer;
+  uint8_t first = 0;
+  uint8_t bytes, started, i;
+  uint32_t offset;
+  int16_t j;
+
+  /* Layers are composed into a whole buffer only */
+  *Region = r;
+  if (Display.BandHeight > 0) {
+    return 0;
+  }
+
+  /* Union of the changed areas, hidden layers included */
+  for (i = 0; i < Compositor->Count; i++) {
+    layer = Compositor->Layers[i];
+    BGFX_RectUnion(&r, layer->Dirty);
+    layer->Dirty.W = 0;
+    layer->Dirty.H = 0;
+  }
+  *Region = r;
+  if ((r.W <= 0) || (r.H <= 0) || (Display.Buffer == NULL)) {
+    return 0;
+  }
+
+  /* Nothing under the top-most opaque layer shows */
+  for (i = Compositor->Count; i > 0; i--) {
+    layer = Compositor->Layers[i - 1];
+    if (!layer->Hidden && (layer->Blend == BGFX_BLEND_OPAQUE)) {
+      first = i - 1;
+      break;
+    }
+  }
+
+  if (Display.ColorScheme == BGFX_MONOCHROMATIC) {
+    BGFX_ComposeMono(Compositor, first, r, Display);
+    return 1;
+  }
+  bytes = (Display.ColorScheme == BGFX_16BITS) ? 2 : 1;
+
+  for (j = r.Y; j < r.Y + r.H; j++) {
+    offset = ((uint32_t)j * Display.WIDTH + r.X) * bytes;
+    started = 0;
+    for (i = first; i < Compositor->Count; i++) {
+      layer = Compositor->Layers[i];
+      if (layer->Hidden) {
+        continue;
+      }
+
+      if (!started) {
+        /* The bottom-most layer shown covers everything */
+        memcpy((uint8_t *)Display.Buffer + offset,
+            (const uint8_t *)layer->Surface.Buffer + offset, r.W * bytes);
+        started = 1;
+      } else if (bytes == 2) {
+        uint16_t *dst = (uint16_t *)((uint8_t *)Display.Buffer + offset);
+        const uint16_t *src =
+            (const uint16_t *)((const uint8_t *)layer->Surface.Buffer + offset);
+        if (layer->Blend == BGFX_BLEND_ALPHA) {
+          BGFX_RowAlpha565(dst, src, r.W, layer->ColorKey, layer->Alpha);
+        } else if (layer->Blend == BGFX_BLEND_KEY) {
+          BGFX_RowKey16(dst, src, r.W, layer->ColorKey);
+        } else {
+          memcpy(dst, src, r.W * sizeof(uint16_t));
+        }
+      } else {
+        uint8_t *dst = (uint8_t *)Display.Buffer + offset;
+        const uint8_t *src = (const uint8_t *)layer->Surface.Buffer + offset;
+        if ((layer->Blend == BGFX_BLEND_ALPHA) &&
+            (Display.ColorScheme == BGFX_8BITS)) {
+          BGFX_RowAlpha8(dst, src, r.W, layer->ColorKey, layer->Alpha);
+        } else if (layer->Blend != BGFX_BLEND_OPAQUE) {
+          BGFX_RowKey8(dst, src, r.W, layer->ColorKey);
+        } else {
+          memcpy(dst, src, r.W);
+        }
+      }
+    }
+  }
+
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Compose monochromatic layers, 8 pixels at a time. A key of 0
+            keeps the set bits of the layer (or), a key of 1 keeps its
+            clear bits (and). Alpha is handled as a key.
+    @param  Compositor  Layers to compose
+    @param  First   Index of the bottom-most layer to read
+    @param  Region  Area to compose, buffer coordinates, not empty
+    @param  Display Display to compose to
+ */
+/**************************************************************************/
+static void BGFX_ComposeMono(BGFX_Compositor_t *Compositor, uint8_t First,
+    BGFX_Rect_t Region, BGFX_Parameters_t Display)
+{
+  BGFX_Layer_t *layer;
+  int32_t a0, a1, b0, b1, g, b, offset;
+  uint8_t mask, value, started, i;
+
+  if (Display.HeightPixelsOnWrite > 1 && Display.WidthPixelsOnWrite == 1) {
+    /* Pages of 8 rows */
+    a0 = Region.Y;
+    a1 = Region.Y + Region.H - 1;
+    b0 = Region.X;
+    b1 = Region.X + Region.W - 1;
+  } else {
+    /* Groups of 8 columns, see BGFX_DrawPixel_01 */
+    a0 = Region.X;
+    a1 = Region.X + Region.W - 1;
+    b0 = Region.Y;
+    b1 = Region.Y + Region.H - 1;
+  }
+
+  for (g = a0 >> 3; g <= (a1 >> 3); g++) {
+    mask = 0xFF;
+    if (g == (a0 >> 3)) {
+      mask &= 0xFF << (a0 & 7);
+    }
+    if (g == (a1 >> 3)) {
+      mask &= 0xFF >> (7 - (a1 & 7));
+    }
+
+    for (b = b0; b <= b1; b++) {
+      offset = g * Display.WIDTH + b;
+      value = 0;
+      started = 0;
+      for (i = First; i < Compositor->Count; i++) {
+        layer = Compositor->Layers[i];
+        if (layer->Hidden) {
+          continue;
+        }
+        if (!started || (layer->Blend == BGFX_BLEND_OPAQUE)) {
+          value = ((const uint8_t *)layer->Surface.Buffer)[offset];
+          started = 1;
+        } else if (layer->ColorKey) {
+          value &= ((const uint8_t *)layer->Surface.Buffer)[offset];
+        } else {
+          value |= ((const uint8_t *)layer->Surface.Buffer)[offset];
+        }
+      }
+      if (started) {
+        ((uint8_t *)Display.Buffer)[offset] =
+            (((uint8_t *)Display.Buffer)[offset] & ~mask) | (value & mask);
+      }
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Copy the pixels of a row that are not the key color. Written
+            without branches so that compilers vectorize it.
+    @param  Dst     Composed row
+    @param  Src     Layer row
+    @param  Count   Number of pixels
+    @param  Key     Transparent color
+ */
+/**************************************************************************/
+static void BGFX_RowKey16(uint16_t *Dst, const uint16_t *Src, int16_t Count,
+    uint16_t Key)
+{
+  int16_t i;
+
+  for (i = 0; i < Count; i++) {
+    Dst[i] = (Src[i] == Key) ? Dst[i] : Src[i];
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Mix a row of 5-6-5 pixels over the composed row. The three
+            components are spread in a 32 bits word (--g-- r b) and mixed by
+            a single multiply, with 5 bits of opacity.
+    @param  Dst     Composed row
+    @param  Src     Layer row
+    @param  Count   Number of pixels
+    @param  Key     Transparent color
+    @param  Alpha   Opacity, 0 to 255
+ */
+/**************************************************************************/
+static void BGFX_RowAlpha565(uint16_t *Dst, const uint16_t *Src,
+    int16_t Count, uint16_t Key, uint8_t Alpha)
+{
+  uint32_t a = (Alpha + 4) >> 3;
+  uint32_t s, d, m;
+  int16_t i;
+
+  for (i = 0; i < Count; i++) {
+    s = (Src[i] | ((uint32_t)Src[i] << 16)) & 0x07E0F81FUL;
+    d = (Dst[i] | ((uint32_t)Dst[i] << 16)) & 0x07E0F81FUL;
+    m = ((((s - d) * a) >> 5) + d) & 0x07E0F81FUL;
+    m = (m | (m >> 16)) & 0xFFFF;
+    Dst[i] = (Src[i] == Key) ? Dst[i] : (uint16_t)m;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Copy the pixels of a row that are not the key color, see
+            BGFX_RowKey16
+    @param  Dst     Composed row
+    @param  Src     Layer row
+    @param  Count   Number of pixels
+    @param  Key     Transparent color
+ */
+/**************************************************************************/
+static void BGFX_RowKey8(uint8_t *Dst, const uint8_t *Src, int16_t Count,
+    uint8_t Key)
+{
+  int16_t i;
+
+  for (i = 0; i < Count; i++) {
+    Dst[i] = (Src[i] == Key) ? Dst[i] : Src[i];
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Mix a row of 8 bits grayscale pixels over the composed row
+    @param  Dst     Composed row
+    @param  Src     Layer row
+    @param  Count   Number of pixels
+    @param  Key     Transparent color
+    @param  Alpha   Opacity, 0 to 255
+ */
+/**************************************************************************/
+static void BGFX_RowAlpha8(uint8_t *Dst, const uint8_t *Src, int16_t Count,
+    uint8_t Key, uint8_t Alpha)
+{
+  uint16_t a = Alpha + (Alpha >> 7);
+  uint16_t m;
+  int16_t i;
+
+  for (i = 0; i < Count; i++) {
+    m = (Src[i] * a + Dst[i] * (256 - a)) >> 8;
+    Dst[i] = (Src[i] == Key) ? Dst[i] : (uint8_t)m;
+  }
+}
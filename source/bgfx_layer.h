@@ -0,0 +1,134 @@
+/**
+ * @file  bgfx_layer.h
+ * @date  19-October-2026
+ * @brief Layered compositor with dirty regions.
+ *
+ * @author
+ * @author
+ *
+ * A layer is a full display sized surface with its own buffer, drawn with
+ * the usual BGFX_ functions through its Surface parameters. Each layer keeps
+ * the area changed since the last composition. BGFX_Compose blends the
+ * layers, bottom to top, into the display buffer over the union of those
+ * areas only, and returns it for a partial flush. Layers above an opaque
+ * one are all that is read, the ones below it are skipped.
+ *
+ * Layers and target must share WIDTH, HEIGHT and ColorScheme. Areas are
+ * given in screen coordinates and reported in buffer (unrotated)
+ * coordinates, ready for BGFX_ExpandPalette or a display window.
+ */
+
+#ifndef BGFX_LAYER_H
+#define BGFX_LAYER_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef BGFX_MAX_LAYERS
+#define BGFX_MAX_LAYERS 4 /*!< Maximum layers in a compositor */
+#endif
+
+
+/**
+ * @brief How a layer covers the layers below it
+ */
+typedef enum
+{
+  BGFX_BLEND_OPAQUE = 0,  /*!< Every pixel replaces the ones below */
+  BGFX_BLEND_KEY,         /*!< Pixels equal to ColorKey are transparent */
+  BGFX_BLEND_ALPHA,       /*!< Mixed with the layers below by Alpha, 16 bits
+                               5-6-5 and 8 bits grayscale only, others behave
+                               as BGFX_BLEND_KEY */
+}BGFX_BlendMode_t;
+
+
+/**
+ * @brief Drawing layer
+ */
+typedef struct
+{
+  BGFX_Parameters_t Surface; /*!< Parameters to draw on this layer with */
+  BGFX_BlendMode_t Blend; /*!< How this layer covers the ones below */
+  uint16_t ColorKey;    /*!< Transparent color, key and alpha modes */
+  uint8_t Alpha;        /*!< Opacity, 0 to 255, alpha mode only */
+  uint8_t Hidden;       /*!< If set, the layer is not composed. Invalidate
+                             the layer after changing this or the blending */
+  BGFX_Rect_t Dirty;    /*!< Changed area, buffer coordinates */
+}BGFX_Layer_t;
+
+
+/**
+ * @brief Layers composed together, index 0 at the bottom
+ */
+typedef struct
+{
+  BGFX_Layer_t *Layers[BGFX_MAX_LAYERS]; /*!< Layers, bottom to top */
+  uint8_t Count;        /*!< Number of layers */
+}BGFX_Compositor_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Set up a layer with the geometry of a display. The whole layer
+            is marked as changed.
+    @param  Layer   Layer to set up, opaque and visible
+    @param  Buffer  Layer buffer, BGFX_GetBufferSize(Display) bytes
+    @param  Display Display the layer is composed to
+ */
+/**************************************************************************/
+void BGFX_LayerInit(BGFX_Layer_t *Layer, void *Buffer,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Mark an area of a layer as changed, to be composed again
+    @param  Layer   Layer that was drawn on
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+ */
+/**************************************************************************/
+void BGFX_LayerInvalidate(BGFX_Layer_t *Layer, int16_t x, int16_t y,
+    int16_t w, int16_t h);
+
+
+/**************************************************************************/
+/*!
+    @brief  Add a layer on top of the others
+    @param  Compositor  Compositor to add to
+    @param  Layer   Layer to add, must stay valid while in use
+    @return 0 on success, -1 if the compositor is full
+ */
+/**************************************************************************/
+int BGFX_CompositorAdd(BGFX_Compositor_t *Compositor, BGFX_Layer_t *Layer);
+
+
+/**************************************************************************/
+/*!
+    @brief  Compose the changed areas of all layers into the display buffer
+            and clear them
+    @param  Compositor  Layers to compose
+    @param  Region  Returns the composed area, buffer coordinates
+    @param  Display Display to compose to
+    @return 1 if something was composed, 0 if nothing changed or Display
+            holds a band (see bgfx_band.h), in which case nothing is
+            written and the changed areas are kept
+ */
+/**************************************************************************/
+uint8_t BGFX_Compose(BGFX_Compositor_t *Compositor, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_LAYER_H */
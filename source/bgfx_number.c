@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_number.h"
+
+
+
+uint8_t BGFX_FormatFixed(int32_t Value, uint8_t Decimals, char *Out)
+{
+  char digits[10];
+  uint32_t u = (Value < 0) ? 0u - (uint32_t)Value : (uint32_t)Value;
+  uint8_t n = 0, i = 0;
+
+  if (Decimals > 9) {
+    Decimals = 9;
+  }
+
+  /* Least significant first, at least one digit before the point */
+  do {
+    digits[n++] = '0' + (u % 10);
+    u /= 10;
+  } while ((u != 0) || (n <= Decimals));
+
+  if (Value < 0) {
+    Out[i++] = '-';
+  }
+  while (n > 0) {
+    if (n == Decimals) {
+      Out[i++] = '.';
+    }
+    Out[i++] = digits[--n];
+  }
+  return i;
+}
+
+
+
+
+uint8_t BGFX_DrawInt(BGFX_NumberField_t *Field, int32_t Value,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display)
+{
+  return BGFX_DrawFixed(Field, Value, 0, Region, Display);
+}
+
+
+
+
+uint8_t BGFX_DrawFixed(BGFX_NumberField_t *Field, int32_t Value,
+    uint8_t Decimals, BGFX_Rect_t *Region, BGFX_Parameters_t Display)
+{
+  char text[BGFX_NUMBER_TEXT_LENGTH];
+  uint8_t size = Field->Size ? Field->Size : 1;
+  uint8_t cells = (Field->Cells < BGFX_NUMBER_MAX_CELLS) ?
+      Field->Cells : BGFX_NUMBER_MAX_CELLS;
+  uint8_t n, i;
+  char c;
+  BGFX_Rect_t cell;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  n = BGFX_FormatFixed(Value, Decimals, text);
+  Region->X = Field->X;
+  Region->Y = Field->Y;
+  Region->W = 0;
+  Region->H = 0;
+
+  cell.Y = Field->Y;
+  cell.W = 6 * size;
+  cell.H = 8 * size;
+  for (i = 0; i < cells; i++) {
+    /* Right aligned, '#' when it does not fit */
+    if (n > cells) {
+      c = '#';
+    } else if (i < cells - n) {
+      c = ' ';
+    } else {
+      c = text[i - (cells - n)];
+    }
+    if (Field->Valid && (Field->Shown[i] == c)) {
+      continue;
+    }
+
+    cell.X = Field->X + i * cell.W;
+    BGFX_DrawChar(cell.X, cell.Y, c, Field->Color, Field->Background, size,
+        size, Display);
+    BGFX_RectUnion(Region, cell);
+    Field->Shown[i] = c;
+  }
+
+  Field->Valid = 1;
+  return (Region->W > 0);
+}
+
+
+
+
+void BGFX_NumberInvalidate(BGFX_NumberField_t *Field)
+{
+  Field->Valid = 0;
+}
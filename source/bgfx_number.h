@@ -0,0 +1,112 @@
+/**
+ * @file  bgfx_number.h
+ * @date  19-October-2026
+ * @brief Numeric fields redrawn digit by digit.
+ *
+ * @author
+ * @author
+ *
+ * Numbers are formatted without printf into a field of fixed width cells
+ * of the classic 6x8 font, right aligned. The field remembers the
+ * characters on screen and only the cells whose character changed are
+ * drawn again: a reading going from 23.51 to 23.58 draws one cell. The
+ * area drawn is returned for a partial flush.
+ */
+
+#ifndef BGFX_NUMBER_H
+#define BGFX_NUMBER_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef BGFX_NUMBER_MAX_CELLS
+#define BGFX_NUMBER_MAX_CELLS 12 /*!< Widest numeric field, in characters */
+#endif
+
+#define BGFX_NUMBER_TEXT_LENGTH 13 /*!< Longest formatted number, "-" and
+                                        "." included, terminator excluded */
+
+
+/**
+ * @brief Numeric field, the fields up to Size are set by the caller
+ */
+typedef struct
+{
+  int16_t X;            /*!< Top left corner x coordinate */
+  int16_t Y;            /*!< Top left corner y coordinate */
+  uint8_t Cells;        /*!< Width in characters, up to
+                             BGFX_NUMBER_MAX_CELLS */
+  uint16_t Color;       /*!< Digits color */
+  uint16_t Background;  /*!< Background color */
+  uint8_t Size;         /*!< Font size multiplier, 0 is the same as 1 */
+
+  uint8_t Valid;        /*!< Set once drawn, cleared to draw every cell */
+  char Shown[BGFX_NUMBER_MAX_CELLS]; /*!< Characters on screen */
+}BGFX_NumberField_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Write a fixed point number in decimal, without printf
+    @param  Value   Number, scaled by 10 ^ Decimals
+    @param  Decimals  Digits after the decimal point, up to 9
+    @param  Out     Returns the characters, BGFX_NUMBER_TEXT_LENGTH at most,
+            not zero terminated
+    @return Number of characters written
+ */
+/**************************************************************************/
+uint8_t BGFX_FormatFixed(int32_t Value, uint8_t Decimals, char *Out);
+
+
+/**************************************************************************/
+/*!
+    @brief  Show an integer in a numeric field, drawing only the cells that
+            changed. Numbers too wide for the field are shown as '#'.
+    @param  Field   Numeric field
+    @param  Value   Number to show
+    @param  Region  Returns the area drawn, empty if nothing changed
+    @param  Display Structure to display parameters and functions
+    @return 1 if something was drawn, 0 otherwise
+ */
+/**************************************************************************/
+uint8_t BGFX_DrawInt(BGFX_NumberField_t *Field, int32_t Value,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Show a fixed point number in a numeric field, drawing only the
+            cells that changed. BGFX_DrawFixed(Field, 2351, 2, ...) shows
+            23.51.
+    @param  Field   Numeric field
+    @param  Value   Number, scaled by 10 ^ Decimals
+    @param  Decimals  Digits after the decimal point, up to 9
+    @param  Region  Returns the area drawn, empty if nothing changed
+    @param  Display Structure to display parameters and functions
+    @return 1 if something was drawn, 0 otherwise
+ */
+/**************************************************************************/
+uint8_t BGFX_DrawFixed(BGFX_NumberField_t *Field, int32_t Value,
+    uint8_t Decimals, BGFX_Rect_t *Region, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Have every cell of a field drawn again on the next update
+    @param  Field   Numeric field
+ */
+/**************************************************************************/
+void BGFX_NumberInvalidate(BGFX_NumberField_t *Field);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_NUMBER_H */
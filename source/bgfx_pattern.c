@@ -0,0 +1,276 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include "bgfx_pattern.h"
+#include "bgfx_spans.h"
+
+
+/**
+ * @brief Working state of a pattern fill, handed to the span function
+ */
+typedef struct
+{
+  BGFX_Parameters_t *Display;   /*!< Display being drawn to */
+  uint32_t Rows[16];    /*!< Pattern rows written twice side by side, so a
+                             row starting at any column is one shift */
+  uint8_t Size;         /*!< 8 or 16 */
+  int16_t OriginX;      /*!< Screen x of the left column of the pattern */
+  int16_t OriginY;      /*!< Screen y of the top row of the pattern */
+  uint16_t Color;       /*!< Color of the set bits */
+  uint16_t Background;  /*!< Color of the clear bits */
+}BGFX_PatternJob_t;
+
+
+static uint8_t BGFX_PatternStart(BGFX_PatternJob_t *Job,
+    const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t *Display);
+
+static void BGFX_PatternSpan(int16_t x, int16_t y, int16_t w, void *Context);
+
+static uint32_t BGFX_DashTurn(uint32_t Bits, uint8_t Length, int32_t Phase);
+
+
+
+uint8_t BGFX_DrawLineDashed(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    const BGFX_Dash_t *Dash, uint8_t Phase, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display)
+{
+  uint32_t bits, reversed = 0;
+  int16_t steep, dx, dy, err, ystep, x, start, t;
+  int32_t count, first;
+  uint8_t length, k, backwards = 0;
+
+  if ((Dash == NULL) || (Dash->Length == 0) || (Dash->Length > 32)) {
+    return Phase;
+  }
+  length = Dash->Length;
+  bits = Dash->Bits;
+  for (k = 0; k < length; k++) {
+    reversed |= ((bits >> k) & 1UL) << (length - 1 - k);
+  }
+
+  /* Same pixels as BGFX_DrawLine: walked along the major axis from the
+   * smaller end, the dash read backwards when that is the end point */
+  steep = abs(y1 - y0) > abs(x1 - x0);
+  if (steep) {
+    t = x0; x0 = y0; y0 = t;
+    t = x1; x1 = y1; y1 = t;
+  }
+  if (x0 > x1) {
+    t = x0; x0 = x1; x1 = t;
+    t = y0; y0 = y1; y1 = t;
+    backwards = 1;
+  }
+  dx = x1 - x0;
+  dy = abs(y1 - y0);
+  err = dx / 2;
+  ystep = (y0 < y1) ? 1 : -1;
+  count = (int32_t)dx + 1;
+
+  /* One run per minor axis position */
+  for (x = start = x0; x <= x1; x++) {
+    err -= dy;
+    if ((err >= 0) && (x < x1)) {
+      continue;
+    }
+
+    /* Dash position of the first pixel of the run [start, x] */
+    first = start - x0;
+    if (backwards) {
+      bits = BGFX_DashTurn(reversed, length,
+          length - 1 - (Phase + count - 1 - first) % length);
+    } else {
+      bits = BGFX_DashTurn(Dash->Bits, length, Phase + first);
+    }
+    if (steep) {
+      BGFX_DrawVLineBits(y0, start, x - start + 1, bits, length, color, bg,
+          Display);
+    } else {
+      BGFX_DrawHLineBits(start, y0, x - start + 1, bits, length, color, bg,
+          Display);
+    }
+
+    if (err < 0) {
+      y0 += ystep;
+      err += dx;
+    }
+    start = x + 1;
+  }
+  return (uint8_t)((Phase + count) % length);
+}
+
+
+
+
+void BGFX_DrawRectDashed(int16_t x, int16_t y, int16_t w, int16_t h,
+    const BGFX_Dash_t *Dash, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display)
+{
+  uint8_t phase = 0;
+
+  if ((w <= 0) || (h <= 0)) {
+    return;
+  }
+  if ((w == 1) || (h == 1)) {
+    BGFX_DrawLineDashed(x, y, x + w - 1, y + h - 1, Dash, 0, color, bg,
+        Display);
+    return;
+  }
+
+  /* Each pixel once, clockwise */
+  phase = BGFX_DrawLineDashed(x, y, x + w - 2, y, Dash, phase, color, bg,
+      Display);
+  phase = BGFX_DrawLineDashed(x + w - 1, y, x + w - 1, y + h - 2, Dash,
+      phase, color, bg, Display);
+  phase = BGFX_DrawLineDashed(x + w - 1, y + h - 1, x + 1, y + h - 1, Dash,
+      phase, color, bg, Display);
+  BGFX_DrawLineDashed(x, y + h - 1, x, y + 1, Dash, phase, color, bg,
+      Display);
+}
+
+
+
+
+void BGFX_DrawRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+    const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display)
+{
+  BGFX_PatternJob_t job;
+
+  if (BGFX_PatternStart(&job, Pattern, color, bg, &Display)) {
+    BGFX_SpansRect(x, y, w, h, BGFX_PatternSpan, &job, Display);
+  }
+}
+
+
+
+
+void BGFX_DrawRoundRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+    int16_t r, const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display)
+{
+  BGFX_PatternJob_t job;
+
+  if (BGFX_PatternStart(&job, Pattern, color, bg, &Display)) {
+    BGFX_SpansRoundRect(x, y, w, h, r, BGFX_PatternSpan, &job, Display);
+  }
+}
+
+
+
+
+void BGFX_DrawCirclePattern(int16_t x0, int16_t y0, int16_t r,
+    const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display)
+{
+  BGFX_PatternJob_t job;
+
+  if (BGFX_PatternStart(&job, Pattern, color, bg, &Display)) {
+    BGFX_SpansCircle(x0, y0, r, BGFX_PatternSpan, &job, Display);
+  }
+}
+
+
+
+
+void BGFX_DrawTrianglePattern(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t x2, int16_t y2, const BGFX_Pattern_t *Pattern, uint16_t color,
+    uint16_t bg, BGFX_Parameters_t Display)
+{
+  BGFX_PatternJob_t job;
+
+  if (BGFX_PatternStart(&job, Pattern, color, bg, &Display)) {
+    BGFX_SpansTriangle(x0, y0, x1, y1, x2, y2, BGFX_PatternSpan, &job,
+        Display);
+  }
+}
+
+
+
+
+void BGFX_DrawPolygonPattern(const int16_t *Points, uint16_t Count,
+    const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display)
+{
+  BGFX_PatternJob_t job;
+
+  if (BGFX_PatternStart(&job, Pattern, color, bg, &Display)) {
+    BGFX_SpansPolygon(Points, Count, BGFX_PatternSpan, &job, Display);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Prepare the rows of a pattern fill
+    @param  Job     Working state to initialize
+    @param  Pattern Pattern to fill with
+    @param  color   Color of the set bits
+    @param  bg      Color of the clear bits
+    @param  Display Display to draw to
+    @return 1 if the pattern can be drawn, 0 otherwise
+ */
+/**************************************************************************/
+static uint8_t BGFX_PatternStart(BGFX_PatternJob_t *Job,
+    const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t *Display)
+{
+  uint32_t row;
+  uint8_t i;
+
+  if ((Pattern == NULL) || ((Pattern->Size != 8) && (Pattern->Size != 16))) {
+    return 0;
+  }
+  Job->Display = Display;
+  Job->Size = Pattern->Size;
+  Job->OriginX = Pattern->OriginX;
+  Job->OriginY = Pattern->OriginY;
+  Job->Color = color;
+  Job->Background = bg;
+  for (i = 0; i < Pattern->Size; i++) {
+    row = Pattern->Rows[i] & ((1UL << Pattern->Size) - 1);
+    Job->Rows[i] = row | (row << Pattern->Size);
+  }
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw one span with the pattern row of its y, starting at the
+            pattern column of its x
+    @param  x   Left-most pixel x coordinate
+    @param  y   Row y coordinate
+    @param  w   Number of pixels
+    @param  Context Pattern working state
+ */
+/**************************************************************************/
+static void BGFX_PatternSpan(int16_t x, int16_t y, int16_t w, void *Context)
+{
+  BGFX_PatternJob_t *job = (BGFX_PatternJob_t *)Context;
+  int32_t row = ((int32_t)y - job->OriginY) % job->Size;
+  int32_t column = ((int32_t)x - job->OriginX) % job->Size;
+
+  row += (row < 0) ? job->Size : 0;
+  column += (column < 0) ? job->Size : 0;
+  BGFX_DrawHLineBits(x, y, w, job->Rows[row] >> column, job->Size,
+      job->Color, job->Background, *job->Display);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Turn a dash so that it starts at a given position
+    @param  Bits    Dash mask, bit 0 first
+    @param  Length  Number of pixels in the mask, 1 to 32
+    @param  Phase   Position of the new first pixel, any value
+    @return Mask starting at Phase
+ */
+/**************************************************************************/
+static uint32_t BGFX_DashTurn(uint32_t Bits, uint8_t Length, int32_t Phase)
+{
+  uint64_t wide = Bits & (0xFFFFFFFFUL >> (32 - Length));
+
+  Phase %= Length;
+  Phase += (Phase < 0) ? Length : 0;
+  return (uint32_t)(((wide << Length) | wide) >> Phase);
+}
@@ -0,0 +1,205 @@
+/**
+ * @file  bgfx_pattern.h
+ * @date  19-October-2026
+ * @brief Pattern brush fills, dashed and dotted lines.
+ *
+ * @author
+ * @author
+ *
+ * A pattern is an 8x8 or 16x16 bitmap repeated over the screen from an
+ * origin, so shapes filled with the same pattern line up with each other.
+ * Shapes are split into spans by bgfx_spans.h; for every span the pattern
+ * row is picked and turned once to the first pixel of the span, then the
+ * span is written by BGFX_DrawHLineBits with set bits in one color and
+ * clear bits in another, or left unchanged (hatching over a background).
+ *
+ * Dashes are on/off masks of up to 32 pixels. A dashed line is drawn as its
+ * horizontal or vertical runs, each run written by BGFX_DrawHLineBits or
+ * BGFX_DrawVLineBits, and the dash position is carried from one line to
+ * the next so polylines and rectangles do not restart their pattern at
+ * every corner.
+ */
+
+#ifndef BGFX_PATTERN_H
+#define BGFX_PATTERN_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*! Dash of on pixels followed by off pixels, on from 1 to 31 */
+#define BGFX_DASH(on, off) { (1UL << (on)) - 1, (on) + (off) }
+
+
+/**
+ * @brief Dash of a line
+ */
+typedef struct
+{
+  uint32_t Bits;        /*!< On/off mask, bit 0 first */
+  uint8_t Length;       /*!< Number of pixels in the mask, 1 to 32 */
+}BGFX_Dash_t;
+
+
+/**
+ * @brief Pattern brush
+ */
+typedef struct
+{
+  uint16_t Rows[16];    /*!< Rows from the top, bit 0 for the left pixel.
+                             8x8 patterns use rows 0 to 7 and bits 0 to 7 */
+  uint8_t Size;         /*!< 8 or 16 */
+  int16_t OriginX;      /*!< Screen x of the left column of the pattern */
+  int16_t OriginY;      /*!< Screen y of the top row of the pattern */
+}BGFX_Pattern_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a dashed or dotted line, pixels as BGFX_DrawLine
+    @param  x0  Start point x coordinate
+    @param  y0  Start point y coordinate
+    @param  x1  End point x coordinate
+    @param  y1  End point y coordinate
+    @param  Dash    Dash, followed from the start point
+    @param  Phase   Position in the dash of the first pixel
+    @param  color   16-bit 5-6-5 Color of the dashes
+    @param  bg      16-bit 5-6-5 Color of the gaps, if same as color, the
+            gaps are left unchanged
+    @param  Display Structure to display parameters and functions
+    @return Position in the dash of the pixel after the end point, the
+            Phase of a line continuing this one
+ */
+/**************************************************************************/
+uint8_t BGFX_DrawLineDashed(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    const BGFX_Dash_t *Dash, uint8_t Phase, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a dashed or dotted rectangle, pixels as BGFX_DrawRect. The
+            dash goes around clockwise from the top left corner.
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  Dash    Dash
+    @param  color   16-bit 5-6-5 Color of the dashes
+    @param  bg      16-bit 5-6-5 Color of the gaps, if same as color, the
+            gaps are left unchanged
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawRectDashed(int16_t x, int16_t y, int16_t w, int16_t h,
+    const BGFX_Dash_t *Dash, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle with a pattern
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  Pattern Pattern to fill with
+    @param  color   16-bit 5-6-5 Color of the set bits
+    @param  bg      16-bit 5-6-5 Color of the clear bits, if same as color,
+            the pixels of the clear bits are left unchanged
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+    const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rounded rectangle with a pattern
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  r   Radius of corner rounding
+    @param  Pattern Pattern to fill with
+    @param  color   16-bit 5-6-5 Color of the set bits
+    @param  bg      16-bit 5-6-5 Color of the clear bits, if same as color,
+            the pixels of the clear bits are left unchanged
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawRoundRectPattern(int16_t x, int16_t y, int16_t w, int16_t h,
+    int16_t r, const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a circle with a pattern
+    @param  x0  Center-point x coordinate
+    @param  y0  Center-point y coordinate
+    @param  r   Radius of circle
+    @param  Pattern Pattern to fill with
+    @param  color   16-bit 5-6-5 Color of the set bits
+    @param  bg      16-bit 5-6-5 Color of the clear bits, if same as color,
+            the pixels of the clear bits are left unchanged
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawCirclePattern(int16_t x0, int16_t y0, int16_t r,
+    const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a triangle with a pattern, same outline as
+            BGFX_DrawTriangleFill
+    @param  x0  Vertex #0 x coordinate
+    @param  y0  Vertex #0 y coordinate
+    @param  x1  Vertex #1 x coordinate
+    @param  y1  Vertex #1 y coordinate
+    @param  x2  Vertex #2 x coordinate
+    @param  y2  Vertex #2 y coordinate
+    @param  Pattern Pattern to fill with
+    @param  color   16-bit 5-6-5 Color of the set bits
+    @param  bg      16-bit 5-6-5 Color of the clear bits, if same as color,
+            the pixels of the clear bits are left unchanged
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawTrianglePattern(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t x2, int16_t y2, const BGFX_Pattern_t *Pattern, uint16_t color,
+    uint16_t bg, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a polygon with a pattern, see BGFX_SpansPolygon for the
+            fill rule
+    @param  Points  Vertices as x, y pairs, 2 * Count values
+    @param  Count   Number of vertices
+    @param  Pattern Pattern to fill with
+    @param  color   16-bit 5-6-5 Color of the set bits
+    @param  bg      16-bit 5-6-5 Color of the clear bits, if same as color,
+            the pixels of the clear bits are left unchanged
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawPolygonPattern(const int16_t *Points, uint16_t Count,
+    const BGFX_Pattern_t *Pattern, uint16_t color, uint16_t bg,
+    BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_PATTERN_H */
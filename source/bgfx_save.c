@@ -0,0 +1,186 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_save.h"
+
+
+static uint8_t BGFX_SaveBytes(BGFX_Parameters_t Display);
+
+static void BGFX_SaveCopy(uint8_t *Store, BGFX_Rect_t Area, uint8_t Restore,
+    BGFX_Parameters_t Display);
+
+
+
+uint32_t BGFX_GetRegionSize(BGFX_Rect_t Area, BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t r = BGFX_RectToBuffer(Area, Display);
+
+  if ((r.W <= 0) || (r.H <= 0)) {
+    return 0;
+  }
+  if (Display.ColorScheme != BGFX_MONOCHROMATIC) {
+    return (uint32_t)r.W * r.H * BGFX_SaveBytes(Display);
+  }
+  if (Display.HeightPixelsOnWrite > 1 && Display.WidthPixelsOnWrite == 1) {
+    return (uint32_t)((r.Y + r.H - 1) / 8 - r.Y / 8 + 1) * r.W;
+  }
+  return (uint32_t)((r.X + r.W - 1) / 8 - r.X / 8 + 1) * r.H;
+}
+
+
+
+
+int BGFX_SaveRegion(BGFX_SaveStack_t *Stack, BGFX_Rect_t Area, void *Store,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t screen = {0, 0, 0, 0};
+  BGFX_Saved_t *save;
+  uint32_t size;
+
+  if ((Display.DrawPixel != NULL) || (Display.Buffer == NULL) ||
+      (Display.BandHeight > 0) || (Stack->Count >= BGFX_SAVE_DEPTH))
+  {
+    return -1;
+  }
+
+  save = &Stack->Saves[Stack->Count];
+  save->Store = (uint8_t *)Store;
+  save->Size = 0;
+  size = BGFX_GetRegionSize(Area, Display);
+  if (Store == NULL) {
+    if ((Stack->Pool == NULL) || (size > Stack->PoolSize - Stack->Used)) {
+      return -1;
+    }
+    save->Store = Stack->Pool + Stack->Used;
+    save->Size = size;
+    Stack->Used += size;
+  }
+
+  /* Area kept in both coordinates: screen for the caller, buffer for the
+   * copy back */
+  BGFX_SetRotation(Display.Rotation, &Display);
+  screen.W = Display.Width;
+  screen.H = Display.Height;
+  save->Area = Area;
+  BGFX_RectIntersect(&save->Area, screen);
+  save->Buffer = BGFX_RectToBuffer(Area, Display);
+
+  if (size > 0) {
+    BGFX_SaveCopy(save->Store, save->Buffer, 0, Display);
+  }
+  Stack->Count++;
+  return 0;
+}
+
+
+
+
+int BGFX_RestoreRegion(BGFX_SaveStack_t *Stack, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Saved_t *save;
+
+  if ((Stack->Count == 0) || (Display.BandHeight > 0)) {
+    return -1;
+  }
+
+  Stack->Count--;
+  save = &Stack->Saves[Stack->Count];
+  Stack->Used -= save->Size;
+  if ((save->Buffer.W > 0) && (save->Buffer.H > 0) &&
+      (Display.Buffer != NULL))
+  {
+    BGFX_SaveCopy(save->Store, save->Buffer, 1, Display);
+  }
+
+  if (Region != NULL) {
+    *Region = save->Area;
+    if ((save->Buffer.W <= 0) || (save->Buffer.H <= 0)) {
+      Region->W = 0;
+      Region->H = 0;
+    }
+  }
+  return 0;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Number of bytes of a pixel in an 8 or 16 bits buffer
+    @param  Display Structure to display parameters and functions
+    @return 2 for BGFX_16BITS, 1 otherwise
+ */
+/**************************************************************************/
+static uint8_t BGFX_SaveBytes(BGFX_Parameters_t Display)
+{
+  return (Display.ColorScheme == BGFX_16BITS) ? 2 : 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Copy an area between the framebuffer and a store, one buffer row
+            (or one group of 8 packed rows or columns) at a time
+    @param  Store   Store, rows of the area one after the other
+    @param  Area    Area, buffer coordinates, inside the buffer
+    @param  Restore 0 to copy from the framebuffer to the store, 1 to copy
+            back
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_SaveCopy(uint8_t *Store, BGFX_Rect_t Area, uint8_t Restore,
+    BGFX_Parameters_t Display)
+{
+  uint8_t *buffer = (uint8_t *)Display.Buffer;
+  uint8_t bytes = BGFX_SaveBytes(Display);
+  int32_t a0, a1, b0, n, g, i, row;
+  uint8_t *ptr, mask;
+
+  if (Display.ColorScheme != BGFX_MONOCHROMATIC) {
+    n = (int32_t)Area.W * bytes;
+    for (row = Area.Y; row < Area.Y + Area.H; row++, Store += n) {
+      ptr = buffer + ((int32_t)row * Display.WIDTH + Area.X) * bytes;
+      if (Restore) {
+        memcpy(ptr, Store, n);
+      } else {
+        memcpy(Store, ptr, n);
+      }
+    }
+    return;
+  }
+
+  /* Bits along A, bytes along B, see BGFX_DrawPixel_01 */
+  if (Display.HeightPixelsOnWrite > 1 && Display.WidthPixelsOnWrite == 1) {
+    a0 = Area.Y;
+    a1 = Area.Y + Area.H - 1;
+    b0 = Area.X;
+    n = Area.W;
+  } else {
+    a0 = Area.X;
+    a1 = Area.X + Area.W - 1;
+    b0 = Area.Y;
+    n = Area.H;
+  }
+
+  for (g = a0 >> 3; g <= (a1 >> 3); g++, Store += n) {
+    ptr = buffer + g * Display.WIDTH + b0;
+    if (!Restore) {
+      memcpy(Store, ptr, n);
+      continue;
+    }
+    mask = 0xFF;
+    if (g == (a0 >> 3)) {
+      mask &= 0xFF << (a0 & 7);
+    }
+    if (g == (a1 >> 3)) {
+      mask &= 0xFF >> (7 - (a1 & 7));
+    }
+    if (mask == 0xFF) {
+      memcpy(ptr, Store, n);
+      continue;
+    }
+    for (i = 0; i < n; i++) {
+      ptr[i] = (ptr[i] & ~mask) | (Store[i] & mask);
+    }
+  }
+}
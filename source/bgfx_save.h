@@ -0,0 +1,123 @@
+/**
+ * @file  bgfx_save.h
+ * @date  19-October-2026
+ * @brief Save-under: framebuffer areas saved before a popup and restored
+ *        when it closes.
+ *
+ * @author
+ * @author
+ *
+ * BGFX_SaveRegion copies an area of the framebuffer aside before a menu,
+ * tooltip or dialog is drawn over it; BGFX_RestoreRegion puts it back when
+ * it closes, so the screen below does not have to be drawn again. Saves
+ * are nested on a stack and restored in reverse order.
+ *
+ * The copies are made in buffer (unrotated) coordinates, one memcpy per
+ * buffer row. Monochromatic buffers are copied a byte at a time along the
+ * packed axis: whole pages for the vertical layout, whole groups of 8
+ * columns for the horizontal one. On restore the bits outside the area in
+ * the first and last bytes are kept, so pixels next to the area drawn in
+ * the meantime are not lost.
+ *
+ * The store of a save is either given by the caller or taken from the pool
+ * of the stack, last in first out. Saving needs a buffer that can be read
+ * back: no user DrawPixel function and no band. The clip rectangle does
+ * not apply.
+ */
+
+#ifndef BGFX_SAVE_H
+#define BGFX_SAVE_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef BGFX_SAVE_DEPTH
+#define BGFX_SAVE_DEPTH 4 /*!< Maximum nested saves on a stack */
+#endif
+
+
+/**
+ * @brief One saved area
+ */
+typedef struct
+{
+  BGFX_Rect_t Area;     /*!< Area saved, screen coordinates */
+  BGFX_Rect_t Buffer;   /*!< Area saved, buffer coordinates */
+  uint8_t *Store;       /*!< Copy of the pixels */
+  uint32_t Size;        /*!< Bytes taken from the pool, 0 if the store was
+                             given by the caller */
+}BGFX_Saved_t;
+
+
+/**
+ * @brief Stack of nested saves. Pool and PoolSize are set by the caller,
+ *        the other fields start at 0.
+ */
+typedef struct
+{
+  uint8_t *Pool;        /*!< Memory the stores are taken from, may be NULL
+                             if every save gives its store */
+  uint32_t PoolSize;    /*!< Size of the pool in bytes */
+
+  uint32_t Used;        /*!< Bytes of the pool in use */
+  uint8_t Count;        /*!< Number of saves on the stack */
+  BGFX_Saved_t Saves[BGFX_SAVE_DEPTH]; /*!< Saves, oldest first */
+}BGFX_SaveStack_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the size in bytes of the store of an area
+    @param  Area    Area, screen coordinates
+    @param  Display Structure to display parameters and functions
+    @return Size in bytes, 0 if the area is off the display
+ */
+/**************************************************************************/
+uint32_t BGFX_GetRegionSize(BGFX_Rect_t Area, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Save an area of the framebuffer on top of the stack
+    @param  Stack   Stack of saves
+    @param  Area    Area to save, screen coordinates, clipped to the
+            display
+    @param  Store   BGFX_GetRegionSize bytes to save into, NULL to take them
+            from the pool
+    @param  Display Structure to display parameters and functions
+    @return 0 on success, -1 if the stack or the pool is full, or the
+            buffer cannot be read back
+ */
+/**************************************************************************/
+int BGFX_SaveRegion(BGFX_SaveStack_t *Stack, BGFX_Rect_t Area, void *Store,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Put the last saved area back in the framebuffer and remove it
+            from the stack
+    @param  Stack   Stack of saves
+    @param  Region  Returns the area restored, screen coordinates, may be
+            NULL
+    @param  Display Structure to display parameters and functions, same
+            buffer and rotation as when saved
+    @return 0 on success, -1 if the stack is empty or Display holds a
+            band (see bgfx_band.h), the area then stays on the stack
+ */
+/**************************************************************************/
+int BGFX_RestoreRegion(BGFX_SaveStack_t *Stack, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_SAVE_H */
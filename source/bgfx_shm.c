@@ -0,0 +1,264 @@
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "bgfx_shm.h"
+
+
+static int BGFX_ShmMap(BGFX_Shm_t *Shm, int Fd, int Writable);
+
+
+
+int BGFX_ShmCreate(BGFX_Shm_t *Shm, BGFX_ShmMode_t Mode, const char *Name,
+    BGFX_Parameters_t *Display)
+{
+  BGFX_ShmHeader_t *header;
+  uint32_t size;
+  int fd;
+
+  size = BGFX_GetBufferSize(*Display);
+  if (size == 0) {
+    errno = EINVAL;
+    return -1;
+  }
+
+  switch (Mode) {
+  case BGFX_SHM_POSIX:
+    fd = shm_open(Name, O_RDWR | O_CREAT, 0644);
+    break;
+  case BGFX_SHM_MEMFD:
+    fd = memfd_create((Name != NULL) ? Name : "bgfx", MFD_CLOEXEC);
+    break;
+  case BGFX_SHM_FILE:
+    fd = open(Name, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    break;
+  default:
+    errno = EINVAL;
+    return -1;
+  }
+  if (fd < 0) {
+    return -1;
+  }
+
+  if (ftruncate(fd, sizeof(BGFX_ShmHeader_t) + size) != 0) {
+    close(fd);
+    return -1;
+  }
+  if (BGFX_ShmMap(Shm, fd, 1) != 0) {
+    return -1;
+  }
+
+  /* Header is written with a zero magic first, so a consumer that opens
+   * the object early does not trust a half-written header */
+  header = Shm->Header;
+  memset(header, 0, sizeof(*header));
+  header->Version = BGFX_SHM_VERSION;
+  header->HeaderSize = sizeof(BGFX_ShmHeader_t);
+  header->WIDTH = Display->WIDTH;
+  header->HEIGHT = Display->HEIGHT;
+  header->WidthPixelsOnWrite = Display->WidthPixelsOnWrite;
+  header->HeightPixelsOnWrite = Display->HeightPixelsOnWrite;
+  header->ColorScheme = Display->ColorScheme;
+  header->BufferSize = size;
+  __atomic_store_n(&header->Magic, BGFX_SHM_MAGIC, __ATOMIC_RELEASE);
+
+  Display->Buffer = Shm->Buffer;
+  return 0;
+}
+
+
+
+
+int BGFX_ShmOpen(BGFX_Shm_t *Shm, BGFX_ShmMode_t Mode, const char *Name)
+{
+  int fd;
+
+  switch (Mode) {
+  case BGFX_SHM_POSIX:
+    fd = shm_open(Name, O_RDONLY, 0);
+    break;
+  case BGFX_SHM_FILE:
+    fd = open(Name, O_RDONLY | O_CLOEXEC);
+    break;
+  default:
+    errno = EINVAL;
+    return -1;
+  }
+  if (fd < 0) {
+    return -1;
+  }
+  return BGFX_ShmOpenFd(Shm, fd);
+}
+
+
+
+
+int BGFX_ShmOpenFd(BGFX_Shm_t *Shm, int Fd)
+{
+  BGFX_ShmHeader_t *header;
+  BGFX_Parameters_t display;
+  uint32_t size;
+
+  if (BGFX_ShmMap(Shm, Fd, 0) != 0) {
+    return -1;
+  }
+
+  /* The producer may be stale or hostile: pixels must lie after the header
+   * and the display described must fit in them */
+  header = Shm->Header;
+  BGFX_ShmGetParameters(Shm, &display);
+  size = BGFX_GetBufferSize(display);
+  if ((__atomic_load_n(&header->Magic, __ATOMIC_ACQUIRE) != BGFX_SHM_MAGIC) ||
+      (header->Version != BGFX_SHM_VERSION) ||
+      (header->HeaderSize < sizeof(BGFX_ShmHeader_t)) ||
+      (header->HeaderSize + (size_t)header->BufferSize > Shm->MapSize) ||
+      (size == 0) || (size > header->BufferSize))
+  {
+    BGFX_ShmClose(Shm, BGFX_SHM_MEMFD, NULL);
+    errno = EPROTO;
+    return -1;
+  }
+  Shm->Buffer = (uint8_t *)header + header->HeaderSize;
+  return 0;
+}
+
+
+
+
+void BGFX_ShmGetParameters(const BGFX_Shm_t *Shm, BGFX_Parameters_t *Display)
+{
+  const BGFX_ShmHeader_t *header = Shm->Header;
+
+  memset(Display, 0, sizeof(*Display));
+  Display->WIDTH = header->WIDTH;
+  Display->HEIGHT = header->HEIGHT;
+  Display->WidthPixelsOnWrite = header->WidthPixelsOnWrite;
+  Display->HeightPixelsOnWrite = header->HeightPixelsOnWrite;
+  Display->ColorScheme = (BGFX_ColorScheme_t)header->ColorScheme;
+  Display->Buffer = Shm->Buffer;
+  BGFX_SetRotation(0, Display);
+}
+
+
+
+
+void BGFX_ShmBeginFrame(BGFX_Shm_t *Shm)
+{
+  uint32_t seq = __atomic_load_n(&Shm->Header->Sequence, __ATOMIC_RELAXED);
+
+  if ((seq & 1) == 0) {
+    __atomic_store_n(&Shm->Header->Sequence, seq + 1, __ATOMIC_RELAXED);
+    /* Pixel stores must not be seen before the counter turns odd */
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+  }
+}
+
+
+
+
+uint32_t BGFX_ShmEndFrame(BGFX_Shm_t *Shm)
+{
+  uint32_t seq = __atomic_load_n(&Shm->Header->Sequence, __ATOMIC_RELAXED);
+
+  /* Also accepts a frame drawn without BGFX_ShmBeginFrame */
+  seq += (seq & 1) ? 1 : 2;
+  __atomic_store_n(&Shm->Header->Sequence, seq, __ATOMIC_RELEASE);
+  return seq;
+}
+
+
+
+
+uint32_t BGFX_ShmReadBegin(const BGFX_Shm_t *Shm)
+{
+  uint32_t seq;
+
+  while ((seq = __atomic_load_n(&Shm->Header->Sequence, __ATOMIC_ACQUIRE)) & 1)
+  {
+    sched_yield();
+  }
+  return seq;
+}
+
+
+
+
+int BGFX_ShmReadValid(const BGFX_Shm_t *Shm, uint32_t Sequence)
+{
+  /* Pixel loads must complete before the counter is checked again */
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+  return __atomic_load_n(&Shm->Header->Sequence, __ATOMIC_RELAXED) == Sequence;
+}
+
+
+
+
+void BGFX_ShmClose(BGFX_Shm_t *Shm, BGFX_ShmMode_t Mode, const char *Name)
+{
+  if (Shm->Header != NULL) {
+    munmap(Shm->Header, Shm->MapSize);
+  }
+  if (Shm->Fd >= 0) {
+    close(Shm->Fd);
+  }
+  if (Name != NULL) {
+    if (Mode == BGFX_SHM_POSIX) {
+      shm_unlink(Name);
+    } else if (Mode == BGFX_SHM_FILE) {
+      unlink(Name);
+    }
+  }
+  Shm->Fd = -1;
+  Shm->MapSize = 0;
+  Shm->Header = NULL;
+  Shm->Buffer = NULL;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Map the whole memory object behind a descriptor
+    @param  Shm      Handle to fill
+    @param  Fd       Descriptor of the object, owned by the handle afterwards
+    @param  Writable If set, map read-write for the producer
+    @return 0 on success, -1 on failure with errno set and Fd closed
+ */
+/**************************************************************************/
+static int BGFX_ShmMap(BGFX_Shm_t *Shm, int Fd, int Writable)
+{
+  struct stat st;
+  void *map;
+  int err;
+
+  if (fstat(Fd, &st) != 0) {
+    goto fail;
+  }
+  if ((size_t)st.st_size < sizeof(BGFX_ShmHeader_t)) {
+    errno = EPROTO;
+    goto fail;
+  }
+
+  map = mmap(NULL, st.st_size, Writable ? (PROT_READ | PROT_WRITE) : PROT_READ,
+      MAP_SHARED, Fd, 0);
+  if (map == MAP_FAILED) {
+    goto fail;
+  }
+
+  Shm->Fd = Fd;
+  Shm->MapSize = st.st_size;
+  Shm->Header = (BGFX_ShmHeader_t *)map;
+  Shm->Buffer = (uint8_t *)map + sizeof(BGFX_ShmHeader_t);
+  return 0;
+
+fail:
+  err = errno;
+  close(Fd);
+  errno = err;
+  return -1;
+}
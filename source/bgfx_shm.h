@@ -0,0 +1,193 @@
+/**
+ * @file  bgfx_shm.h
+ * @date  19-October-2026
+ * @brief Shared-memory and file-backed framebuffers for headless Linux use.
+ *
+ * @author
+ * @author
+ *
+ * The framebuffer is placed inside a memory mapping made of a small header
+ * followed by the pixels, so a separate viewer or encoder process can map the
+ * same object and read the frames without copying them. The mapping can be a
+ * POSIX shared-memory object (shm_open), an anonymous memfd handed over by
+ * file descriptor, or a regular file.
+ *
+ * The header carries a frame sequence counter used as a seqlock: it is odd
+ * while the producer is drawing and even once a frame is complete. Readers
+ * take the counter before and after looking at the pixels and retry if it
+ * changed.
+ */
+
+#ifndef BGFX_SHM_H
+#define BGFX_SHM_H
+
+
+#include <stdint.h>
+#include <stddef.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define BGFX_SHM_MAGIC   0x58464742u /*!< "BGFX" in little endian */
+#define BGFX_SHM_VERSION 1           /*!< Layout version of the header */
+
+
+/**
+ * @brief Kinds of memory object used to back the framebuffer.
+ */
+typedef enum
+{
+  BGFX_SHM_POSIX = 0,     /*!< POSIX shared memory, name like "/bgfx0" */
+  BGFX_SHM_MEMFD,         /*!< Anonymous memfd, shared by file descriptor */
+  BGFX_SHM_FILE,          /*!< Regular file, mapped shared */
+}BGFX_ShmMode_t;
+
+
+/**
+ * @brief Header placed at the start of the mapping, before the pixels
+ */
+typedef struct
+{
+  uint32_t Magic;       /*!< Always BGFX_SHM_MAGIC */
+  uint16_t Version;     /*!< Always BGFX_SHM_VERSION */
+  uint16_t HeaderSize;  /*!< Offset in bytes from the header to the pixels */
+  uint16_t WIDTH;       /*!< 'Raw' display width, see BGFX_Parameters_t */
+  uint16_t HEIGHT;      /*!< 'Raw' display height, see BGFX_Parameters_t */
+  uint16_t WidthPixelsOnWrite;    /*!< Number of horizontal pixels in a byte */
+  uint16_t HeightPixelsOnWrite;   /*!< Number of vertical pixels in a byte */
+  uint32_t ColorScheme; /*!< One of BGFX_ColorScheme_t */
+  uint32_t BufferSize;  /*!< Size in bytes of the pixel area */
+  uint32_t Sequence;    /*!< Frame counter, odd while a frame is drawn */
+  uint32_t Reserved[9]; /*!< Pads the header to 64 bytes */
+}BGFX_ShmHeader_t;
+
+
+/**
+ * @brief Handle to a mapped framebuffer, on the producer or consumer side
+ */
+typedef struct
+{
+  int Fd;                   /*!< File descriptor of the memory object */
+  size_t MapSize;           /*!< Size of the whole mapping */
+  BGFX_ShmHeader_t *Header; /*!< Start of the mapping */
+  void *Buffer;             /*!< Pixels, right after the header */
+}BGFX_Shm_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Create a framebuffer in shared memory and attach it to a display
+    @param  Shm     Handle to initialize
+    @param  Mode    Kind of memory object to create
+    @param  Name    Object name for BGFX_SHM_POSIX, file path for
+                    BGFX_SHM_FILE, debug name for BGFX_SHM_MEMFD
+    @param  Display Display whose WIDTH, HEIGHT, ColorScheme and
+                    PixelsOnWrite fields describe the buffer. Its Buffer
+                    field is set to the mapped pixels.
+    @return 0 on success, -1 on failure with errno set
+ */
+/**************************************************************************/
+int BGFX_ShmCreate(BGFX_Shm_t *Shm, BGFX_ShmMode_t Mode, const char *Name,
+    BGFX_Parameters_t *Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Map an existing framebuffer read-only, consumer side
+    @param  Shm     Handle to initialize
+    @param  Mode    BGFX_SHM_POSIX or BGFX_SHM_FILE. A memfd can be opened as
+                    a file through "/proc/<pid>/fd/<fd>", or with
+                    BGFX_ShmOpenFd.
+    @param  Name    Object name or file path
+    @return 0 on success, -1 on failure with errno set
+ */
+/**************************************************************************/
+int BGFX_ShmOpen(BGFX_Shm_t *Shm, BGFX_ShmMode_t Mode, const char *Name);
+
+
+/**************************************************************************/
+/*!
+    @brief  Map an existing framebuffer read-only from a file descriptor
+    @param  Shm     Handle to initialize
+    @param  Fd      Descriptor inherited or received from the producer, the
+                    handle takes ownership of it
+    @return 0 on success, -1 on failure with errno set, EPROTO for
+            a header that is not valid or describes a display larger
+            than its pixels
+ */
+/**************************************************************************/
+int BGFX_ShmOpenFd(BGFX_Shm_t *Shm, int Fd);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a display structure describing a mapped framebuffer
+    @param  Shm     Mapped framebuffer
+    @param  Display Structure to fill, rotation is set to zero
+ */
+/**************************************************************************/
+void BGFX_ShmGetParameters(const BGFX_Shm_t *Shm, BGFX_Parameters_t *Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Mark the start of a frame, producer side. Readers that catch the
+            buffer in this state discard what they read.
+    @param  Shm     Mapped framebuffer
+ */
+/**************************************************************************/
+void BGFX_ShmBeginFrame(BGFX_Shm_t *Shm);
+
+
+/**************************************************************************/
+/*!
+    @brief  Publish the frame drawn since BGFX_ShmBeginFrame
+    @param  Shm     Mapped framebuffer
+    @return Sequence number of the published frame
+ */
+/**************************************************************************/
+uint32_t BGFX_ShmEndFrame(BGFX_Shm_t *Shm);
+
+
+/**************************************************************************/
+/*!
+    @brief  Start reading a frame, consumer side. Waits while a frame is
+            being drawn.
+    @param  Shm     Mapped framebuffer
+    @return Sequence number to pass to BGFX_ShmReadValid
+ */
+/**************************************************************************/
+uint32_t BGFX_ShmReadBegin(const BGFX_Shm_t *Shm);
+
+
+/**************************************************************************/
+/*!
+    @brief  Check that the pixels read since BGFX_ShmReadBegin were not
+            modified by the producer in the meantime
+    @param  Shm      Mapped framebuffer
+    @param  Sequence Value returned by BGFX_ShmReadBegin
+    @return 1 if the frame is consistent, 0 if it must be read again
+ */
+/**************************************************************************/
+int BGFX_ShmReadValid(const BGFX_Shm_t *Shm, uint32_t Sequence);
+
+
+/**************************************************************************/
+/*!
+    @brief  Unmap a framebuffer and close its descriptor
+    @param  Shm     Mapped framebuffer
+    @param  Mode    Kind of memory object, used with Name
+    @param  Name    If not NULL, the POSIX object or file is also removed
+ */
+/**************************************************************************/
+void BGFX_ShmClose(BGFX_Shm_t *Shm, BGFX_ShmMode_t Mode, const char *Name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_SHM_H */
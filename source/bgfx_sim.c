@@ -0,0 +1,549 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_sim.h"
+
+
+#define BGFX_SIM_CHUNK 256 /*!< Bytes converted at a time by BGFX_SimFlush */
+
+#define BGFX_MADCTL_MY 0x80 /*!< ILI9341 row address order */
+#define BGFX_MADCTL_MX 0x40 /*!< ILI9341 column address order */
+#define BGFX_MADCTL_MV 0x20 /*!< ILI9341 row / column exchange */
+
+
+static uint32_t BGFX_SimClocksNs(uint32_t Clocks, uint32_t Hz);
+
+static void BGFX_SimCharge(BGFX_Sim_t *Sim, uint32_t Overhead,
+    uint32_t Bytes);
+
+static void BGFX_SimWrite(BGFX_Sim_t *Sim, const uint8_t *Data,
+    uint32_t Count);
+
+static void BGFX_SimWrite1306(BGFX_Sim_t *Sim, uint8_t Data);
+
+static void BGFX_SimWrite9341(BGFX_Sim_t *Sim, uint16_t color);
+
+static void BGFX_SimCommand1306(BGFX_Sim_t *Sim, uint8_t Command,
+    const uint8_t *Args, uint16_t Count);
+
+static void BGFX_SimCommand9341(BGFX_Sim_t *Sim, uint8_t Command,
+    const uint8_t *Args, uint16_t Count);
+
+
+
+BGFX_SimBus_t BGFX_SimSpi(uint32_t Hz)
+{
+  BGFX_SimBus_t bus;
+
+  bus.ByteNs = BGFX_SimClocksNs(8, Hz);
+  bus.CommandNs = bus.ByteNs;
+  bus.TransferNs = bus.ByteNs;
+  return bus;
+}
+
+
+
+
+BGFX_SimBus_t BGFX_SimI2c(uint32_t Hz)
+{
+  BGFX_SimBus_t bus;
+
+  bus.ByteNs = BGFX_SimClocksNs(9, Hz);
+  bus.CommandNs = BGFX_SimClocksNs(20, Hz);
+  bus.TransferNs = bus.CommandNs;
+  return bus;
+}
+
+
+
+
+uint32_t BGFX_SimGramSize(BGFX_SimController_t Controller, uint16_t Width,
+    uint16_t Height)
+{
+  if (Controller == BGFX_SIM_SSD1306) {
+    return (uint32_t)((Height + 7) / 8) * Width;
+  }
+  return (uint32_t)Width * Height * sizeof(uint16_t);
+}
+
+
+
+
+void BGFX_SimInit(BGFX_Sim_t *Sim, BGFX_SimController_t Controller,
+    uint16_t Width, uint16_t Height, void *Gram, BGFX_SimBus_t Bus)
+{
+  memset(Sim, 0, sizeof(*Sim));
+  Sim->Controller = Controller;
+  Sim->Bus = Bus;
+  Sim->WIDTH = Width;
+  Sim->HEIGHT = Height;
+  Sim->Gram = Gram;
+  Sim->HighByte = -1;
+  Sim->ColEnd = Width - 1;
+  if (Controller == BGFX_SIM_SSD1306) {
+    Sim->Mode = 2; /* Page addressing after reset */
+    Sim->RowEnd = (Height + 7) / 8 - 1;
+  } else {
+    Sim->RowEnd = Height - 1;
+  }
+  memset(Gram, 0, BGFX_SimGramSize(Controller, Width, Height));
+}
+
+
+
+
+void BGFX_SimCommand(BGFX_Sim_t *Sim, uint8_t Command, const uint8_t *Args,
+    uint16_t Count)
+{
+  BGFX_SimCharge(Sim, Sim->Bus.CommandNs, 1 + Count);
+  Sim->Stats.Commands++;
+  Sim->Stats.CommandBytes += 1 + Count;
+
+  if (Sim->Controller == BGFX_SIM_SSD1306) {
+    BGFX_SimCommand1306(Sim, Command, Args, Count);
+  } else {
+    BGFX_SimCommand9341(Sim, Command, Args, Count);
+  }
+}
+
+
+
+
+void BGFX_SimData(BGFX_Sim_t *Sim, const uint8_t *Data, uint32_t Count)
+{
+  BGFX_SimCharge(Sim, Sim->Bus.TransferNs, Count);
+  Sim->Stats.Transfers++;
+  Sim->Stats.DataBytes += Count;
+  BGFX_SimWrite(Sim, Data, Count);
+}
+
+
+
+
+void BGFX_SimSetWindow(BGFX_Sim_t *Sim, BGFX_Rect_t Area)
+{
+  uint8_t args[4];
+
+  if (Sim->Controller == BGFX_SIM_SSD1306) {
+    if (Sim->Mode != 0) {
+      args[0] = 0;
+      BGFX_SimCommand(Sim, 0x20, args, 1);
+    }
+    args[0] = Area.X;
+    args[1] = Area.X + Area.W - 1;
+    BGFX_SimCommand(Sim, 0x21, args, 2);
+    args[0] = Area.Y / 8;
+    args[1] = (Area.Y + Area.H - 1) / 8;
+    BGFX_SimCommand(Sim, 0x22, args, 2);
+    return;
+  }
+
+  args[0] = Area.X >> 8;
+  args[1] = Area.X & 0xFF;
+  args[2] = (Area.X + Area.W - 1) >> 8;
+  args[3] = (Area.X + Area.W - 1) & 0xFF;
+  BGFX_SimCommand(Sim, 0x2A, args, 4);
+  args[0] = Area.Y >> 8;
+  args[1] = Area.Y & 0xFF;
+  args[2] = (Area.Y + Area.H - 1) >> 8;
+  args[3] = (Area.Y + Area.H - 1) & 0xFF;
+  BGFX_SimCommand(Sim, 0x2B, args, 4);
+  BGFX_SimCommand(Sim, 0x2C, NULL, 0);
+}
+
+
+
+
+int BGFX_SimFlush(BGFX_Sim_t *Sim, BGFX_Rect_t Area,
+    BGFX_Parameters_t Display)
+{
+  uint8_t chunk[BGFX_SIM_CHUNK];
+  const uint16_t *palette = (const uint16_t *)Display.Palette;
+  BGFX_Rect_t limit = {0, 0, 0, 0};
+  uint32_t n = 0, row;
+  uint16_t c;
+  int16_t x, y;
+
+  if (Display.Buffer == NULL) {
+    return -1;
+  }
+  if (Sim->Controller == BGFX_SIM_SSD1306) {
+    if ((Display.ColorScheme != BGFX_MONOCHROMATIC) ||
+        (Display.HeightPixelsOnWrite <= 1) ||
+        (Display.WidthPixelsOnWrite != 1))
+    {
+      return -1;
+    }
+  } else if ((Display.ColorScheme != BGFX_16BITS) &&
+      ((Display.ColorScheme != BGFX_INDEXED8) || (palette == NULL) ||
+      (Display.PaletteFormat != BGFX_PALETTE_565)))
+  {
+    return -1;
+  }
+
+  /* Only the rows held by the buffer can be sent */
+  limit.W = Display.WIDTH;
+  limit.H = Display.HEIGHT;
+  if (Display.BandHeight > 0) {
+    limit.Y = Display.BandY;
+    limit.H = Display.BandHeight;
+  }
+  BGFX_RectIntersect(&Area, limit);
+  if ((Area.W <= 0) || (Area.H <= 0)) {
+    return 0;
+  }
+
+  BGFX_SimSetWindow(Sim, Area);
+
+  if (Sim->Controller == BGFX_SIM_SSD1306) {
+    /* Whole pages, byte (page, x) of the buffer is byte (page, x) of the
+     * display memory */
+    Area.H = (Area.Y + Area.H + 7) / 8 - Area.Y / 8;
+    Area.Y /= 8;
+    BGFX_SimCharge(Sim, Sim->Bus.TransferNs, (uint32_t)Area.W * Area.H);
+    Sim->Stats.Transfers++;
+    Sim->Stats.DataBytes += (uint32_t)Area.W * Area.H;
+    for (y = Area.Y; y < Area.Y + Area.H; y++) {
+      row = (uint32_t)(y - Display.BandY / 8) * Display.WIDTH;
+      BGFX_SimWrite(Sim, (const uint8_t *)Display.Buffer + row + Area.X,
+          Area.W);
+    }
+    return 0;
+  }
+
+  /* One transfer for the whole window, 5-6-5 pixels sent high byte first */
+  BGFX_SimCharge(Sim, Sim->Bus.TransferNs, (uint32_t)Area.W * Area.H * 2);
+  Sim->Stats.Transfers++;
+  Sim->Stats.DataBytes += (uint32_t)Area.W * Area.H * 2;
+  for (y = Area.Y; y < Area.Y + Area.H; y++) {
+    row = (uint32_t)(y - Display.BandY) * Display.WIDTH;
+    for (x = Area.X; x < Area.X + Area.W; x++) {
+      if (Display.ColorScheme == BGFX_16BITS) {
+        c = ((const uint16_t *)Display.Buffer)[row + x];
+      } else {
+        c = palette[((const uint8_t *)Display.Buffer)[row + x]];
+      }
+      chunk[n++] = c >> 8;
+      chunk[n++] = c & 0xFF;
+      if (n == BGFX_SIM_CHUNK) {
+        BGFX_SimWrite(Sim, chunk, n);
+        n = 0;
+      }
+    }
+  }
+  BGFX_SimWrite(Sim, chunk, n);
+  return 0;
+}
+
+
+
+
+void BGFX_SimWritePixel(BGFX_Sim_t *Sim, uint16_t x, uint16_t y,
+    uint16_t color)
+{
+  BGFX_Rect_t area = {x, y, 1, 1};
+  uint8_t data[2];
+  uint8_t mode = 2;
+
+  if (Sim->Controller == BGFX_SIM_SSD1306) {
+    if ((x >= Sim->WIDTH) || (y >= Sim->HEIGHT)) {
+      return;
+    }
+    /* Page addressing: page, then low and high column nibbles */
+    if (Sim->Mode != 2) {
+      BGFX_SimCommand(Sim, 0x20, &mode, 1);
+    }
+    BGFX_SimCommand(Sim, 0xB0 | (y / 8), NULL, 0);
+    BGFX_SimCommand(Sim, 0x00 | (x & 0x0F), NULL, 0);
+    BGFX_SimCommand(Sim, 0x10 | (x >> 4), NULL, 0);
+    data[0] = ((uint8_t *)Sim->Gram)[(y / 8) * Sim->WIDTH + x];
+    if (color) {
+      data[0] |= 1 << (y & 7);
+    } else {
+      data[0] &= ~(1 << (y & 7));
+    }
+    BGFX_SimData(Sim, data, 1);
+    return;
+  }
+
+  BGFX_SimSetWindow(Sim, area);
+  data[0] = color >> 8;
+  data[1] = color & 0xFF;
+  BGFX_SimData(Sim, data, 2);
+}
+
+
+
+
+void BGFX_SimResetStats(BGFX_Sim_t *Sim)
+{
+  memset(&Sim->Stats, 0, sizeof(Sim->Stats));
+}
+
+
+
+
+int BGFX_SimDump(const BGFX_Sim_t *Sim, const char *Path)
+{
+  const uint8_t *pages = (const uint8_t *)Sim->Gram;
+  const uint16_t *pixels = (const uint16_t *)Sim->Gram;
+  uint8_t bits;
+  uint16_t x, y, c;
+  FILE *f;
+  int ok;
+
+  f = fopen(Path, "wb");
+  if (f == NULL) {
+    return -1;
+  }
+
+  if (Sim->Controller == BGFX_SIM_SSD1306) {
+    /* Rows of packed bits, left-most pixel in the high bit, 1 is lit */
+    fprintf(f, "P4\n%u %u\n", Sim->WIDTH, Sim->HEIGHT);
+    for (y = 0; y < Sim->HEIGHT; y++) {
+      bits = 0;
+      for (x = 0; x < Sim->WIDTH; x++) {
+        if ((pages[(y / 8) * Sim->WIDTH + x] >> (y & 7)) & 1) {
+          bits |= 0x80 >> (x & 7);
+        }
+        if (((x & 7) == 7) || (x == Sim->WIDTH - 1)) {
+          fputc(bits, f);
+          bits = 0;
+        }
+      }
+    }
+  } else {
+    fprintf(f, "P6\n%u %u\n255\n", Sim->WIDTH, Sim->HEIGHT);
+    for (y = 0; y < Sim->HEIGHT; y++) {
+      for (x = 0; x < Sim->WIDTH; x++) {
+        c = pixels[(uint32_t)y * Sim->WIDTH + x];
+        fputc(((c >> 11) & 0x1F) * 255 / 31, f);
+        fputc(((c >> 5) & 0x3F) * 255 / 63, f);
+        fputc((c & 0x1F) * 255 / 31, f);
+      }
+    }
+  }
+
+  ok = !ferror(f);
+  if ((fclose(f) != 0) || !ok) {
+    return -1;
+  }
+  return 0;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Time taken by clock cycles of a bus
+    @param  Clocks  Number of clock cycles
+    @param  Hz      Clock frequency, 0 for a bus taking no time
+    @return Time in nanoseconds, saturated to UINT32_MAX
+ */
+/**************************************************************************/
+static uint32_t BGFX_SimClocksNs(uint32_t Clocks, uint32_t Hz)
+{
+  uint64_t ns;
+
+  if (Hz == 0) {
+    return 0;
+  }
+  ns = (uint64_t)Clocks * 1000000000ULL / Hz;
+  return (ns > UINT32_MAX) ? UINT32_MAX : (uint32_t)ns;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Add the time of a command or a transfer to the statistics
+    @param  Sim     Simulated display
+    @param  Overhead  Fixed cost of the command or transfer, in nanoseconds
+    @param  Bytes   Number of bytes sent
+ */
+/**************************************************************************/
+static void BGFX_SimCharge(BGFX_Sim_t *Sim, uint32_t Overhead,
+    uint32_t Bytes)
+{
+  Sim->Stats.TimeNs += Overhead + (uint64_t)Bytes * Sim->Bus.ByteNs;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Execute data bytes on the display memory, already charged
+    @param  Sim     Simulated display
+    @param  Data    Bytes received
+    @param  Count   Number of bytes
+ */
+/**************************************************************************/
+static void BGFX_SimWrite(BGFX_Sim_t *Sim, const uint8_t *Data,
+    uint32_t Count)
+{
+  uint32_t i;
+
+  for (i = 0; i < Count; i++) {
+    if (Sim->Controller == BGFX_SIM_SSD1306) {
+      BGFX_SimWrite1306(Sim, Data[i]);
+    } else if (!Sim->Writing) {
+      /* Data outside of a memory write is not stored */
+    } else if (Sim->HighByte < 0) {
+      Sim->HighByte = Data[i];
+    } else {
+      BGFX_SimWrite9341(Sim, (uint16_t)(Sim->HighByte << 8) | Data[i]);
+      Sim->HighByte = -1;
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Store a byte in the SSD1306 memory and move to the next address
+            as the addressing mode says
+    @param  Sim     Simulated display
+    @param  Data    8 vertical pixels, top one in bit 0
+ */
+/**************************************************************************/
+static void BGFX_SimWrite1306(BGFX_Sim_t *Sim, uint8_t Data)
+{
+  uint16_t pages = (Sim->HEIGHT + 7) / 8;
+
+  if ((Sim->Col < Sim->WIDTH) && (Sim->Row < pages)) {
+    ((uint8_t *)Sim->Gram)[Sim->Row * Sim->WIDTH + Sim->Col] = Data;
+  }
+
+  switch (Sim->Mode) {
+  case 0: /* Horizontal: along the columns, then the next page */
+    if (++Sim->Col > Sim->ColEnd) {
+      Sim->Col = Sim->ColStart;
+      if (++Sim->Row > Sim->RowEnd) {
+        Sim->Row = Sim->RowStart;
+      }
+    }
+    break;
+  case 1: /* Vertical: along the pages, then the next column */
+    if (++Sim->Row > Sim->RowEnd) {
+      Sim->Row = Sim->RowStart;
+      if (++Sim->Col > Sim->ColEnd) {
+        Sim->Col = Sim->ColStart;
+      }
+    }
+    break;
+  default: /* Page: along the columns of one page */
+    if (++Sim->Col >= Sim->WIDTH) {
+      Sim->Col = 0;
+    }
+    break;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Store a pixel in the ILI9341 memory and move to the next
+            address of the window
+    @param  Sim     Simulated display
+    @param  color   5-6-5 color
+ */
+/**************************************************************************/
+static void BGFX_SimWrite9341(BGFX_Sim_t *Sim, uint16_t color)
+{
+  uint16_t x = Sim->Col, y = Sim->Row;
+
+  /* Window addresses to panel memory, see the memory access control */
+  if (Sim->Madctl & BGFX_MADCTL_MV) {
+    x = Sim->Row;
+    y = Sim->Col;
+  }
+  if (Sim->Madctl & BGFX_MADCTL_MX) {
+    x = Sim->WIDTH - 1 - x;
+  }
+  if (Sim->Madctl & BGFX_MADCTL_MY) {
+    y = Sim->HEIGHT - 1 - y;
+  }
+  if ((x < Sim->WIDTH) && (y < Sim->HEIGHT)) {
+    ((uint16_t *)Sim->Gram)[(uint32_t)y * Sim->WIDTH + x] = color;
+  }
+
+  if (++Sim->Col > Sim->ColEnd) {
+    Sim->Col = Sim->ColStart;
+    if (++Sim->Row > Sim->RowEnd) {
+      Sim->Row = Sim->RowStart;
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Execute an SSD1306 command
+    @param  Sim     Simulated display
+    @param  Command Command byte
+    @param  Args    Parameters
+    @param  Count   Number of parameters
+ */
+/**************************************************************************/
+static void BGFX_SimCommand1306(BGFX_Sim_t *Sim, uint8_t Command,
+    const uint8_t *Args, uint16_t Count)
+{
+  if (Command <= 0x0F) {
+    Sim->Col = (Sim->Col & 0xF0) | Command;
+  } else if (Command <= 0x1F) {
+    Sim->Col = (Sim->Col & 0x0F) | ((Command & 0x0F) << 4);
+  } else if ((Command == 0x20) && (Count >= 1)) {
+    Sim->Mode = ((Args[0] & 3) == 3) ? 2 : (Args[0] & 3);
+  } else if ((Command == 0x21) && (Count >= 2)) {
+    Sim->ColStart = Args[0];
+    Sim->ColEnd = Args[1];
+    Sim->Col = Sim->ColStart;
+  } else if ((Command == 0x22) && (Count >= 2)) {
+    Sim->RowStart = Args[0] & 7;
+    Sim->RowEnd = Args[1] & 7;
+    Sim->Row = Sim->RowStart;
+  } else if ((Command >= 0xB0) && (Command <= 0xB7)) {
+    Sim->Row = Command & 7;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Execute an ILI9341 command
+    @param  Sim     Simulated display
+    @param  Command Command byte
+    @param  Args    Parameters
+    @param  Count   Number of parameters
+ */
+/**************************************************************************/
+static void BGFX_SimCommand9341(BGFX_Sim_t *Sim, uint8_t Command,
+    const uint8_t *Args, uint16_t Count)
+{
+  /* Any command ends a memory write */
+  Sim->Writing = 0;
+  Sim->HighByte = -1;
+
+  switch (Command) {
+  case 0x2A:
+    if (Count >= 4) {
+      Sim->ColStart = (Args[0] << 8) | Args[1];
+      Sim->ColEnd = (Args[2] << 8) | Args[3];
+    }
+    break;
+  case 0x2B:
+    if (Count >= 4) {
+      Sim->RowStart = (Args[0] << 8) | Args[1];
+      Sim->RowEnd = (Args[2] << 8) | Args[3];
+    }
+    break;
+  case 0x2C:
+    Sim->Col = Sim->ColStart;
+    Sim->Row = Sim->RowStart;
+    Sim->Writing = 1;
+    break;
+  case 0x36:
+    if (Count >= 1) {
+      Sim->Madctl = Args[0];
+    }
+    break;
+  }
+}
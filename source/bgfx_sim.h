@@ -0,0 +1,249 @@
+/**
+ * @file  bgfx_sim.h
+ * @date  19-October-2026
+ * @brief Headless display controller simulator with a bus cost model.
+ *
+ * @author
+ * @author
+ *
+ * The simulator stands for the display at the end of the bus: it receives
+ * the command and data bytes a driver would send to an SSD1306 or an
+ * ILI9341, executes them on its own display memory (GRAM) and charges the
+ * time they would take on the bus. Comparing flush strategies (full frame,
+ * changed areas only, no buffer at all) then comes down to comparing the
+ * statistics, before any hardware is involved.
+ *
+ * Modeled commands:
+ * - SSD1306: memory addressing mode (0x20: horizontal, vertical or page),
+ *   column and page addresses (0x21, 0x22), page start and column nibbles
+ *   of the page mode (0xB0-0xB7, 0x00-0x0F, 0x10-0x1F). The GRAM is the
+ *   BGFX_MONOCHROMATIC vertical pages layout.
+ * - ILI9341: column and page address set (0x2A, 0x2B), memory write (0x2C)
+ *   of 5-6-5 pixels sent most significant byte first, and the MY, MX and MV
+ *   bits of the memory access control (0x36).
+ * Other commands are charged and otherwise ignored.
+ *
+ * Only the bus is timed: the CPU time spent drawing is not part of the
+ * simulated time.
+ */
+
+#ifndef BGFX_SIM_H
+#define BGFX_SIM_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Simulated display controllers
+ */
+typedef enum
+{
+  BGFX_SIM_SSD1306 = 0,   /*!< Monochromatic OLED, 8 pixel pages */
+  BGFX_SIM_ILI9341,       /*!< 5-6-5 color LCD with address windows */
+}BGFX_SimController_t;
+
+
+/**
+ * @brief Cost of the bus transfers, in nanoseconds
+ */
+typedef struct
+{
+  uint32_t ByteNs;      /*!< Time to send one byte, command or data */
+  uint32_t CommandNs;   /*!< Overhead of each command: chip select, D/C
+                             line, I2C start, address and control bytes */
+  uint32_t TransferNs;  /*!< Overhead of each block of data bytes */
+}BGFX_SimBus_t;
+
+
+/**
+ * @brief What was sent on the bus since the last BGFX_SimResetStats
+ */
+typedef struct
+{
+  uint64_t TimeNs;      /*!< Bus time */
+  uint32_t Commands;    /*!< Number of commands */
+  uint32_t CommandBytes; /*!< Command bytes, parameters included */
+  uint32_t Transfers;   /*!< Number of blocks of data bytes */
+  uint32_t DataBytes;   /*!< Data bytes written to the GRAM */
+}BGFX_SimStats_t;
+
+
+/**
+ * @brief Simulated display, set up with BGFX_SimInit
+ */
+typedef struct
+{
+  BGFX_SimController_t Controller; /*!< Command set */
+  BGFX_SimBus_t Bus;    /*!< Cost of the transfers */
+  uint16_t WIDTH;       /*!< Panel width, in its native orientation */
+  uint16_t HEIGHT;      /*!< Panel height, in its native orientation */
+  void *Gram;           /*!< Display memory, see BGFX_SimGramSize */
+
+  uint8_t Mode;         /*!< SSD1306 memory addressing mode */
+  uint8_t Madctl;       /*!< ILI9341 memory access control */
+  uint8_t Writing;      /*!< ILI9341 memory write in progress */
+  int16_t HighByte;     /*!< ILI9341 first byte of a pixel, -1 if none */
+  uint16_t ColStart;    /*!< Address window, first column */
+  uint16_t ColEnd;      /*!< Address window, last column */
+  uint16_t RowStart;    /*!< Address window, first page (SSD1306) or row */
+  uint16_t RowEnd;      /*!< Address window, last page (SSD1306) or row */
+  uint16_t Col;         /*!< Column of the next data written */
+  uint16_t Row;         /*!< Page (SSD1306) or row of the next data */
+
+  BGFX_SimStats_t Stats; /*!< Statistics */
+}BGFX_Sim_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Bus costs of a SPI bus
+    @param  Hz  Clock frequency, 0 for a bus taking no time
+    @return Costs, one byte time of overhead per command and transfer for
+            the chip select and D/C lines
+ */
+/**************************************************************************/
+BGFX_SimBus_t BGFX_SimSpi(uint32_t Hz);
+
+
+/**************************************************************************/
+/*!
+    @brief  Bus costs of an I2C bus
+    @param  Hz  Clock frequency, 0 for a bus taking no time
+    @return Costs, 9 clocks per byte and 20 clocks of start, address,
+            control byte and stop per command and transfer
+ */
+/**************************************************************************/
+BGFX_SimBus_t BGFX_SimI2c(uint32_t Hz);
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the size in bytes of a controller display memory
+    @param  Controller  Simulated controller
+    @param  Width   Panel width
+    @param  Height  Panel height
+    @return Size in bytes
+ */
+/**************************************************************************/
+uint32_t BGFX_SimGramSize(BGFX_SimController_t Controller, uint16_t Width,
+    uint16_t Height);
+
+
+/**************************************************************************/
+/*!
+    @brief  Reset a simulated display: cleared memory, reset addressing and
+            statistics
+    @param  Sim     Simulated display
+    @param  Controller  Controller to simulate
+    @param  Width   Panel width, in its native orientation
+    @param  Height  Panel height, in its native orientation
+    @param  Gram    Display memory, BGFX_SimGramSize bytes
+    @param  Bus     Cost of the transfers
+ */
+/**************************************************************************/
+void BGFX_SimInit(BGFX_Sim_t *Sim, BGFX_SimController_t Controller,
+    uint16_t Width, uint16_t Height, void *Gram, BGFX_SimBus_t Bus);
+
+
+/**************************************************************************/
+/*!
+    @brief  Send a command and its parameters. SSD1306 parameters are
+            command bytes, ILI9341 parameters are data bytes.
+    @param  Sim     Simulated display
+    @param  Command Command byte
+    @param  Args    Parameters, may be NULL if Count is 0
+    @param  Count   Number of parameters
+ */
+/**************************************************************************/
+void BGFX_SimCommand(BGFX_Sim_t *Sim, uint8_t Command, const uint8_t *Args,
+    uint16_t Count);
+
+
+/**************************************************************************/
+/*!
+    @brief  Send a block of data bytes, written to the display memory at the
+            current address
+    @param  Sim     Simulated display
+    @param  Data    Bytes to send
+    @param  Count   Number of bytes
+ */
+/**************************************************************************/
+void BGFX_SimData(BGFX_Sim_t *Sim, const uint8_t *Data, uint32_t Count);
+
+
+/**************************************************************************/
+/*!
+    @brief  Send the commands selecting an area of the display, as a driver
+            would before writing pixels. SSD1306 rows are rounded to pages.
+    @param  Sim     Simulated display
+    @param  Area    Area, in panel coordinates
+ */
+/**************************************************************************/
+void BGFX_SimSetWindow(BGFX_Sim_t *Sim, BGFX_Rect_t Area);
+
+
+/**************************************************************************/
+/*!
+    @brief  Send an area of a framebuffer, window then pixels. BGFX_16BITS
+            and BGFX_INDEXED8 (5-6-5 palette) buffers go to an ILI9341,
+            BGFX_MONOCHROMATIC buffers with vertical pages to an SSD1306.
+            Band buffers (see bgfx_band.h) are read from their band.
+    @param  Sim     Simulated display
+    @param  Area    Area in buffer (unrotated) coordinates, see
+            BGFX_RectToBuffer
+    @param  Display Structure to display parameters, WIDTH and HEIGHT
+            matching the panel
+    @return 0 on success, -1 if the buffer does not fit the controller
+ */
+/**************************************************************************/
+int BGFX_SimFlush(BGFX_Sim_t *Sim, BGFX_Rect_t Area,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Write a single pixel, window then data, as an unbuffered driver
+            does. An SSD1306 cannot be read back: the page byte sent is
+            taken from the simulated memory, as if the driver kept a copy.
+    @param  Sim     Simulated display
+    @param  x       Panel x coordinate
+    @param  y       Panel y coordinate
+    @param  color   5-6-5 color, or on/off for an SSD1306
+ */
+/**************************************************************************/
+void BGFX_SimWritePixel(BGFX_Sim_t *Sim, uint16_t x, uint16_t y,
+    uint16_t color);
+
+
+/**************************************************************************/
+/*!
+    @brief  Clear the statistics, typically at the start of a frame
+    @param  Sim     Simulated display
+ */
+/**************************************************************************/
+void BGFX_SimResetStats(BGFX_Sim_t *Sim);
+
+
+/**************************************************************************/
+/*!
+    @brief  Write the display memory as seen on the panel to a netpbm file:
+            PBM for an SSD1306, PPM for an ILI9341
+    @param  Sim     Simulated display
+    @param  Path    File to write
+    @return 0 on success, -1 on failure with errno set
+ */
+/**************************************************************************/
+int BGFX_SimDump(const BGFX_Sim_t *Sim, const char *Path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_SIM_H */
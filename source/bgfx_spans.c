@@ -0,0 +1,310 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include "bgfx_spans.h"
+
+
+/**
+ * @brief Polygon edge, stepped one scanline at a time
+ */
+typedef struct
+{
+  int32_t X;      /*!< Crossing at the current scanline, 16.16 fixed point */
+  int32_t Slope;  /*!< X increment per scanline, 16.16 fixed point */
+  int16_t Y0;     /*!< First scanline crossed */
+  int16_t Y1;     /*!< Scanline after the last one crossed */
+}BGFX_Edge_t;
+
+
+static void BGFX_EmitSpan(int32_t x0, int32_t x1, int32_t y,
+    BGFX_SpanFunc_t Func, void *Context, BGFX_Rect_t Clip);
+
+static void BGFX_SpansCircleRows(int16_t xl, int16_t xr, int16_t yt,
+    int16_t yb, int16_t r, BGFX_SpanFunc_t Func, void *Context,
+    BGFX_Rect_t Clip);
+
+
+
+void BGFX_SpansRect(int16_t x, int16_t y, int16_t w, int16_t h,
+    BGFX_SpanFunc_t Func, void *Context, BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip = BGFX_GetClip(Display);
+  int32_t row, end;
+
+  if ((w <= 0) || (h <= 0)) {
+    return;
+  }
+
+  /* Rows outside the drawable area are skipped without being visited */
+  row = (y < clip.Y) ? clip.Y : y;
+  end = (y + h > clip.Y + clip.H) ? clip.Y + clip.H : y + h;
+  for (; row < end; row++) {
+    BGFX_EmitSpan(x, x + w - 1, row, Func, Context, clip);
+  }
+}
+
+
+
+
+void BGFX_SpansRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+    int16_t r, BGFX_SpanFunc_t Func, void *Context, BGFX_Parameters_t Display)
+{
+  int16_t max_radius;
+
+  if ((w <= 0) || (h <= 0)) {
+    return;
+  }
+
+  max_radius = ((w < h) ? w : h) / 2; /* 1/2 minor axis */
+  if (r > max_radius){
+    r = max_radius;
+  }
+  if (r < 0) {
+    r = 0;
+  }
+  BGFX_SpansCircleRows(x + r, x + w - 1 - r, y + r, y + h - 1 - r, r, Func,
+      Context, BGFX_GetClip(Display));
+}
+
+
+
+
+void BGFX_SpansCircle(int16_t x0, int16_t y0, int16_t r,
+    BGFX_SpanFunc_t Func, void *Context, BGFX_Parameters_t Display)
+{
+  if (r < 0) {
+    return;
+  }
+  BGFX_SpansCircleRows(x0, x0, y0, y0, r, Func, Context,
+      BGFX_GetClip(Display));
+}
+
+
+
+
+void BGFX_SpansPolygon(const int16_t *Points, uint16_t Count,
+    BGFX_SpanFunc_t Func, void *Context, BGFX_Parameters_t Display)
+{
+  BGFX_Edge_t edges[BGFX_POLYGON_MAX_POINTS];
+  int32_t cross[BGFX_POLYGON_MAX_POINTS];
+  BGFX_Rect_t clip = BGFX_GetClip(Display);
+  uint16_t n_edges = 0;
+  uint16_t i, j, n;
+  int32_t y, y_min, y_max, t;
+
+  if ((Count < 3) || (Count > BGFX_POLYGON_MAX_POINTS)) {
+    return;
+  }
+
+  /* Build the edge list, horizontal edges never cross a scanline center */
+  y_min = INT16_MAX;
+  y_max = INT16_MIN;
+  for (i = 0; i < Count; i++) {
+    int32_t xa = Points[2 * i], ya = Points[2 * i + 1];
+    int32_t xb = Points[2 * ((i + 1) % Count)];
+    int32_t yb = Points[2 * ((i + 1) % Count) + 1];
+    int32_t slope;
+
+    if (ya == yb) {
+      continue;
+    }
+    if (ya > yb) {
+      t = xa; xa = xb; xb = t;
+      t = ya; ya = yb; yb = t;
+    }
+    slope = (int32_t)(((int64_t)(xb - xa) * 65536) / (yb - ya));
+    edges[n_edges].Slope = slope;
+    edges[n_edges].X = xa * 65536 + slope / 2; /* Crossing at ya + 0.5 */
+    edges[n_edges].Y0 = ya;
+    edges[n_edges].Y1 = yb;
+    n_edges++;
+    y_min = (ya < y_min) ? ya : y_min;
+    y_max = (yb > y_max) ? yb : y_max;
+  }
+
+  /* Scanlines above the drawable area are skipped, edges starting there
+   * are moved forward in one step */
+  y = (y_min < clip.Y) ? clip.Y : y_min;
+  if (y_max > clip.Y + clip.H) {
+    y_max = clip.Y + clip.H;
+  }
+  for (i = 0; i < n_edges; i++) {
+    if (edges[i].Y0 < y) {
+      edges[i].X += (int32_t)((int64_t)edges[i].Slope * (y - edges[i].Y0));
+    }
+  }
+
+  for (; y < y_max; y++) {
+    /* Collect crossings of active edges and step them to the next row */
+    n = 0;
+    for (i = 0; i < n_edges; i++) {
+      if ((y >= edges[i].Y0) && (y < edges[i].Y1)) {
+        t = edges[i].X;
+        for (j = n; (j > 0) && (cross[j - 1] > t); j--) {
+          cross[j] = cross[j - 1];
+        }
+        cross[j] = t;
+        n++;
+        edges[i].X += edges[i].Slope;
+      }
+    }
+
+    /* Pixels whose center falls in [left, right) of each pair */
+    for (i = 0; i + 1 < n; i += 2) {
+      int32_t first = (cross[i] + 0x7FFF) >> 16;
+      int32_t last = ((cross[i + 1] + 0x7FFF) >> 16) - 1;
+      if (first <= last) {
+        BGFX_EmitSpan(first, last, y, Func, Context, clip);
+      }
+    }
+  }
+}
+
+
+void BGFX_SpansTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t x2, int16_t y2, BGFX_SpanFunc_t Func, void *Context,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip = BGFX_GetClip(Display);
+  int32_t sa, sb, a, b, t, y, last;
+
+  /* Sort coordinates by Y order (y2 >= y1 >= y0) */
+  if (y0 > y1) {
+    t = y0; y0 = y1; y1 = t;
+    t = x0; x0 = x1; x1 = t;
+  }
+  if (y1 > y2) {
+    t = y1; y1 = y2; y2 = t;
+    t = x1; x1 = x2; x2 = t;
+  }
+  if (y0 > y1) {
+    t = y0; y0 = y1; y1 = t;
+    t = x0; x0 = x1; x1 = t;
+  }
+
+  if (y0 == y2) {
+    a = (x0 < x1) ? x0 : x1;
+    a = (x2 < a) ? x2 : a;
+    b = (x0 > x1) ? x0 : x1;
+    b = (x2 > b) ? x2 : b;
+    BGFX_EmitSpan(a, b, y0, Func, Context, clip);
+    return;
+  }
+
+  /* Upper part on edges 0-1 and 0-2, row y1 included only when the
+   * bottom is flat, then lower part on edges 1-2 and 0-2, as
+   * BGFX_DrawTriangleFill */
+  last = (y1 == y2) ? y1 : y1 - 1;
+  sa = 0;
+  sb = 0;
+  for (y = y0; y <= last; y++) {
+    a = x0 + sa / (y1 - y0);
+    b = x0 + sb / (y2 - y0);
+    sa += x1 - x0;
+    sb += x2 - x0;
+    if (a > b) {
+      t = a; a = b; b = t;
+    }
+    BGFX_EmitSpan(a, b, y, Func, Context, clip);
+  }
+
+  sa = (int32_t)(x2 - x1) * (y - y1);
+  sb = (int32_t)(x2 - x0) * (y - y0);
+  for (; y <= y2; y++) {
+    a = x1 + sa / (y2 - y1);
+    b = x0 + sb / (y2 - y0);
+    sa += x2 - x1;
+    sb += x2 - x0;
+    if (a > b) {
+      t = a; a = b; b = t;
+    }
+    BGFX_EmitSpan(a, b, y, Func, Context, clip);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Clip a span to the drawable area and hand it to the span
+            function
+    @param  x0  Left-most pixel x coordinate
+    @param  x1  Right-most pixel x coordinate, included
+    @param  y   Row y coordinate
+    @param  Func    Span function
+    @param  Context Passed to Func
+    @param  Clip    Drawable area, see BGFX_GetClip
+ */
+/**************************************************************************/
+static void BGFX_EmitSpan(int32_t x0, int32_t x1, int32_t y,
+    BGFX_SpanFunc_t Func, void *Context, BGFX_Rect_t Clip)
+{
+  if ((y < Clip.Y) || (y >= Clip.Y + Clip.H)) {
+    return;
+  }
+  if (x0 < Clip.X) {
+    x0 = Clip.X;
+  }
+  if (x1 >= Clip.X + Clip.W) {
+    x1 = Clip.X + Clip.W - 1;
+  }
+  if (x0 <= x1) {
+    Func(x0, y, x1 - x0 + 1, Context);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Rows of a circle stretched into a rounded rectangle. The corner
+            centers are (xl, yt), (xr, yt), (xr, yb) and (xl, yb); a circle
+            has all four on the same point. Every row is emitted once, with
+            the midpoint steps of BGFX_DrawCircleFillHelper turned sideways.
+    @param  xl  Left corner centers x coordinate
+    @param  xr  Right corner centers x coordinate
+    @param  yt  Top corner centers y coordinate
+    @param  yb  Bottom corner centers y coordinate
+    @param  r   Radius of the corners
+    @param  Func    Span function
+    @param  Context Passed to Func
+    @param  Clip    Drawable area, see BGFX_GetClip
+ */
+/**************************************************************************/
+static void BGFX_SpansCircleRows(int16_t xl, int16_t xr, int16_t yt,
+    int16_t yb, int16_t r, BGFX_SpanFunc_t Func, void *Context,
+    BGFX_Rect_t Clip)
+{
+  int16_t f = 1 - r;
+  int16_t ddF_x = 1;
+  int16_t ddF_y = -2 * r;
+  int16_t x = 0;
+  int16_t y = r;
+  int16_t px = x;
+  int16_t py = y;
+  int32_t row;
+
+  /* Band between the corners, full width */
+  row = (yt < Clip.Y) ? Clip.Y : yt;
+  for (; (row <= yb) && (row < Clip.Y + Clip.H); row++) {
+    BGFX_EmitSpan(xl - r, xr + r, row, Func, Context, Clip);
+  }
+
+  while (x < y) {
+    if (f >= 0) {
+      y--;
+      ddF_y += 2;
+      f += ddF_y;
+    }
+    x++;
+    ddF_x += 2;
+    f += ddF_x;
+    if (x < (y + 1)) {
+      BGFX_EmitSpan(xl - y, xr + y, yt - x, Func, Context, Clip);
+      BGFX_EmitSpan(xl - y, xr + y, yb + x, Func, Context, Clip);
+    }
+    if (y != py) {
+      BGFX_EmitSpan(xl - px, xr + px, yt - py, Func, Context, Clip);
+      BGFX_EmitSpan(xl - px, xr + px, yb + py, Func, Context, Clip);
+      py = y;
+    }
+    px = x;
+  }
+}
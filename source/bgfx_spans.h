@@ -0,0 +1,134 @@
+/**
+ * @file  bgfx_spans.h
+ * @date  19-October-2026
+ * @brief Break filled shapes into horizontal spans.
+ *
+ * @author
+ * @author
+ *
+ * Each function walks the rows covered by a shape and calls back once per
+ * row with the horizontal run of pixels to fill, already clipped to the
+ * display and the clip rectangle. Fill styles other than a solid color
+ * (gradients, patterns) are written as span callbacks and work with every
+ * shape listed here.
+ */
+
+#ifndef BGFX_SPANS_H
+#define BGFX_SPANS_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef BGFX_POLYGON_MAX_POINTS
+#define BGFX_POLYGON_MAX_POINTS 32 /*!< Maximum vertices in a polygon */
+#endif
+
+
+/**
+ * @brief Called for every span of a shape
+ * @param x       Left-most pixel x coordinate
+ * @param y       Row y coordinate
+ * @param w       Number of pixels, always at least 1
+ * @param Context User pointer given to the span function
+ */
+typedef void (*BGFX_SpanFunc_t)(int16_t x, int16_t y, int16_t w,
+    void *Context);
+
+
+/**************************************************************************/
+/*!
+    @brief  Spans of a rectangle
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  Func    Called once per row
+    @param  Context Passed to Func
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SpansRect(int16_t x, int16_t y, int16_t w, int16_t h,
+    BGFX_SpanFunc_t Func, void *Context, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Spans of a rounded rectangle, same outline as
+            BGFX_DrawRoundRect
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  r   Radius of corner rounding
+    @param  Func    Called once per row
+    @param  Context Passed to Func
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SpansRoundRect(int16_t x, int16_t y, int16_t w, int16_t h,
+    int16_t r, BGFX_SpanFunc_t Func, void *Context, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Spans of a circle, 2 * r + 1 pixels wide and high, same
+            outline as BGFX_DrawCircle
+    @param  x0  Center-point x coordinate
+    @param  y0  Center-point y coordinate
+    @param  r   Radius of circle
+    @param  Func    Called once per row
+    @param  Context Passed to Func
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SpansCircle(int16_t x0, int16_t y0, int16_t r,
+    BGFX_SpanFunc_t Func, void *Context, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Spans of a polygon, even-odd rule. Vertices lie on pixel corners
+            and pixels are sampled at their center, so a square from (0, 0)
+            to (10, 10) covers 10 x 10 pixels and polygons sharing an edge
+            do not overlap.
+    @param  Points  Vertices as x, y pairs, 2 * Count values
+    @param  Count   Number of vertices, up to BGFX_POLYGON_MAX_POINTS
+    @param  Func    Called once per span, possibly several times per row
+    @param  Context Passed to Func
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SpansPolygon(const int16_t *Points, uint16_t Count,
+    BGFX_SpanFunc_t Func, void *Context, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Spans of a triangle, same outline as BGFX_DrawTriangleFill
+    @param  x0  Vertex #0 x coordinate
+    @param  y0  Vertex #0 y coordinate
+    @param  x1  Vertex #1 x coordinate
+    @param  y1  Vertex #1 y coordinate
+    @param  x2  Vertex #2 x coordinate
+    @param  y2  Vertex #2 y coordinate
+    @param  Func    Called once per row
+    @param  Context Passed to Func
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_SpansTriangle(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
+    int16_t x2, int16_t y2, BGFX_SpanFunc_t Func, void *Context,
+    BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_SPANS_H */
@@ -0,0 +1,223 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_supersample.h"
+
+
+static void BGFX_Resolve565(uint16_t *Dst, const uint16_t *Src,
+    uint32_t Stride, int16_t Count, uint8_t Scale);
+
+static void BGFX_ResolveGray(uint8_t *Dst, const uint8_t *Src,
+    uint32_t Stride, int16_t Count, uint8_t Scale);
+
+
+
+uint32_t BGFX_SupersampleBufferSize(uint8_t Scale, BGFX_Parameters_t Display)
+{
+  Display.WIDTH *= Scale;
+  Display.HEIGHT *= Scale;
+  return BGFX_GetBufferSize(Display);
+}
+
+
+
+
+int BGFX_SupersampleInit(BGFX_Supersample_t *Supersample, void *Buffer,
+    uint8_t Scale, BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t clip = Display.Clip;
+
+  if (((Scale != 2) && (Scale != 4)) ||
+      ((Display.ColorScheme != BGFX_16BITS) &&
+       (Display.ColorScheme != BGFX_8BITS)) ||
+      ((uint32_t)Display.WIDTH * Scale > INT16_MAX) ||
+      ((uint32_t)Display.HEIGHT * Scale > INT16_MAX)) {
+    return -1;
+  }
+
+  Supersample->Surface = Display;
+  Supersample->Surface.WIDTH = Display.WIDTH * Scale;
+  Supersample->Surface.HEIGHT = Display.HEIGHT * Scale;
+  Supersample->Surface.Buffer = Buffer;
+  Supersample->Surface.DrawPixel = NULL;
+  Supersample->Surface.BandY = 0;
+  Supersample->Surface.BandHeight = 0;
+  BGFX_SetRotation(Display.Rotation, &Supersample->Surface);
+  clip.X *= Scale;
+  clip.Y *= Scale;
+  clip.W *= Scale;
+  clip.H *= Scale;
+  BGFX_SetClip(clip, &Supersample->Surface);
+
+  Supersample->Scale = Scale;
+  Supersample->Dirty.X = 0;
+  Supersample->Dirty.Y = 0;
+  Supersample->Dirty.W = Display.WIDTH;
+  Supersample->Dirty.H = Display.HEIGHT;
+  return 0;
+}
+
+
+
+
+void BGFX_SupersampleInvalidate(BGFX_Supersample_t *Supersample, int16_t x,
+    int16_t y, int16_t w, int16_t h)
+{
+  uint8_t s = Supersample->Scale;
+  BGFX_Rect_t r;
+
+  r.X = x;
+  r.Y = y;
+  r.W = w;
+  r.H = h;
+  r = BGFX_RectToBuffer(r, Supersample->Surface);
+  if ((r.W <= 0) || (r.H <= 0)) {
+    return;
+  }
+
+  /* Display pixels holding the first and last surface pixels */
+  r.W = (r.X + r.W - 1) / s - r.X / s + 1;
+  r.H = (r.Y + r.H - 1) / s - r.Y / s + 1;
+  r.X /= s;
+  r.Y /= s;
+  BGFX_RectUnion(&Supersample->Dirty, r);
+}
+
+
+
+
+uint8_t BGFX_SupersampleResolve(BGFX_Supersample_t *Supersample,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t r = Supersample->Dirty;
+  BGFX_Rect_t all = {0, 0, 0, 0};
+  uint8_t s = Supersample->Scale;
+  uint32_t stride = Supersample->Surface.WIDTH;
+  uint32_t src, dst;
+  int16_t j;
+
+  /* Dirty area stays pending until a whole buffer is given */
+  *Region = all;
+  if (Display.BandHeight > 0) {
+    return 0;
+  }
+
+  all.W = Display.WIDTH;
+  all.H = Display.HEIGHT;
+  BGFX_RectIntersect(&r, all);
+  Supersample->Dirty.W = 0;
+  Supersample->Dirty.H = 0;
+  *Region = r;
+  if ((r.W <= 0) || (r.H <= 0) || (Display.Buffer == NULL) ||
+      (Supersample->Surface.Buffer == NULL)) {
+    return 0;
+  }
+
+  for (j = r.Y; j < r.Y + r.H; j++) {
+    dst = (uint32_t)j * Display.WIDTH + r.X;
+    src = (uint32_t)j * s * stride + (uint32_t)r.X * s;
+    if (Display.ColorScheme == BGFX_16BITS) {
+      BGFX_Resolve565((uint16_t *)Display.Buffer + dst,
+          (const uint16_t *)Supersample->Surface.Buffer + src, stride, r.W,
+          s);
+    } else {
+      BGFX_ResolveGray((uint8_t *)Display.Buffer + dst,
+          (const uint8_t *)Supersample->Surface.Buffer + src, stride, r.W,
+          s);
+    }
+  }
+
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Average blocks of 5-6-5 pixels into a display row. The three
+            components of a pixel are spread in a 32 bits word
+            (--g-- r b), leaving 5 free bits above each, so the 16 pixels
+            of a block are summed and rounded with single additions.
+    @param  Dst     Display row
+    @param  Src     First surface row of the blocks
+    @param  Stride  Surface row length in pixels
+    @param  Count   Number of display pixels
+    @param  Scale   Block size, 2 or 4
+ */
+/**************************************************************************/
+static void BGFX_Resolve565(uint16_t *Dst, const uint16_t *Src,
+    uint32_t Stride, int16_t Count, uint8_t Scale)
+{
+  uint8_t shift = (Scale == 4) ? 4 : 2;
+  uint32_t half = 1UL << (shift - 1);
+  uint32_t round = half | (half << 11) | (half << 21);
+  const uint16_t *row;
+  uint32_t sum, p;
+  int16_t i;
+  uint8_t k, n;
+
+  for (i = 0; i < Count; i++, Src += Scale) {
+    sum = round;
+    for (k = 0, row = Src; k < Scale; k++, row += Stride) {
+      for (n = 0; n < Scale; n++) {
+        p = row[n];
+        sum += (p | (p << 16)) & 0x07E0F81FUL;
+      }
+    }
+    sum = (sum >> shift) & 0x07E0F81FUL;
+    Dst[i] = (uint16_t)(sum | (sum >> 16));
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Average blocks of 8 bits grayscale pixels into a display row.
+            Four surface pixels are read as one word and summed in two
+            16 bits lanes, even and odd bytes added together: a lane holds
+            a 2 pixels wide block, two lanes a 4 pixels wide one.
+    @param  Dst     Display row
+    @param  Src     First surface row of the blocks
+    @param  Stride  Surface row length in pixels
+    @param  Count   Number of display pixels
+    @param  Scale   Block size, 2 or 4
+ */
+/**************************************************************************/
+static void BGFX_ResolveGray(uint8_t *Dst, const uint8_t *Src,
+    uint32_t Stride, int16_t Count, uint8_t Scale)
+{
+  const uint32_t one = 1;
+  /* Lane of the first two bytes of a word */
+  uint8_t first = (*(const uint8_t *)&one) ? 0 : 16;
+  const uint8_t *row;
+  uint32_t sum, w;
+  int16_t i = 0;
+  uint8_t k;
+
+  if (Scale == 4) {
+    for (; i < Count; i++, Src += 4) {
+      sum = 0;
+      for (k = 0, row = Src; k < 4; k++, row += Stride) {
+        memcpy(&w, row, sizeof(w));
+        sum += (w & 0x00FF00FFUL) + ((w >> 8) & 0x00FF00FFUL);
+      }
+      sum = (sum & 0xFFFF) + (sum >> 16);
+      Dst[i] = (uint8_t)((sum + 8) >> 4);
+    }
+    return;
+  }
+
+  /* Two display pixels per word */
+  for (; i + 1 < Count; i += 2, Src += 4) {
+    sum = 0x00020002UL;
+    memcpy(&w, Src, sizeof(w));
+    sum += (w & 0x00FF00FFUL) + ((w >> 8) & 0x00FF00FFUL);
+    memcpy(&w, Src + Stride, sizeof(w));
+    sum += (w & 0x00FF00FFUL) + ((w >> 8) & 0x00FF00FFUL);
+    Dst[i] = (uint8_t)(sum >> (first + 2));
+    Dst[i + 1] = (uint8_t)(sum >> (16 - first + 2));
+  }
+  if (i < Count) {
+    Dst[i] = (uint8_t)((Src[0] + Src[1] + Src[Stride] + Src[Stride + 1] + 2)
+        >> 2);
+  }
+}
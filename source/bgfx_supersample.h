@@ -0,0 +1,116 @@
+/**
+ * @file  bgfx_supersample.h
+ * @date  19-October-2026
+ * @brief Supersampled drawing, box filtered down to the display.
+ *
+ * @author
+ * @author
+ *
+ * Anti-aliasing for every primitive at once: the scene is drawn with the
+ * usual BGFX_ functions on a surface 2 or 4 times larger than the display
+ * in both directions, then BGFX_SupersampleResolve averages each block of
+ * Scale x Scale pixels into one display pixel. Triangles, circles, lines
+ * and text get smooth edges without anti-aliased variants of each function.
+ *
+ * The cost is fixed and easy to plan: Scale x Scale times the buffer memory
+ * and pixels drawn, plus one read of Scale x Scale pixels per display pixel
+ * resolved. Only the area marked as changed is resolved. The average works
+ * on whole words: the three 5-6-5 components of a pixel are spread in a
+ * 32 bits word and summed together, 8 bits grayscale pixels are summed two
+ * at a time in 16 bits lanes.
+ *
+ * Drawing coordinates, sizes and text sizes are those of the surface, the
+ * display ones multiplied by Scale. The display and surface share
+ * ColorScheme and Rotation; only BGFX_16BITS (5-6-5) and BGFX_8BITS
+ * (grayscale) can be averaged. Areas are reported in display buffer
+ * (unrotated) coordinates, ready for a partial flush.
+ */
+
+#ifndef BGFX_SUPERSAMPLE_H
+#define BGFX_SUPERSAMPLE_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/**
+ * @brief Supersampled drawing surface
+ */
+typedef struct
+{
+  BGFX_Parameters_t Surface; /*!< Parameters to draw at Scale times the
+                             display resolution with */
+  uint8_t Scale;        /*!< Surface pixels per display pixel along x and
+                             y, 2 or 4 */
+  BGFX_Rect_t Dirty;    /*!< Changed area, display buffer coordinates */
+}BGFX_Supersample_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Get the size of the surface buffer for a display
+    @param  Scale   2 or 4
+    @param  Display Display the surface is resolved to
+    @return Buffer size in bytes
+ */
+/**************************************************************************/
+uint32_t BGFX_SupersampleBufferSize(uint8_t Scale, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Set up a supersampled surface for a display. The whole surface
+            is marked as changed. The display clip rectangle is scaled to
+            the surface.
+    @param  Supersample Surface to set up
+    @param  Buffer  Surface buffer, BGFX_SupersampleBufferSize bytes
+    @param  Scale   2 or 4
+    @param  Display Display the surface is resolved to
+    @return 0 on success, -1 if the scale or color scheme is not supported
+            or the surface would be larger than 32767 pixels along x or y
+ */
+/**************************************************************************/
+int BGFX_SupersampleInit(BGFX_Supersample_t *Supersample, void *Buffer,
+    uint8_t Scale, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Mark an area of the surface as changed, to be resolved again
+    @param  Supersample Surface that was drawn on
+    @param  x   Top left corner x coordinate, surface screen coordinates
+    @param  y   Top left corner y coordinate, surface screen coordinates
+    @param  w   Width in surface pixels
+    @param  h   Height in surface pixels
+ */
+/**************************************************************************/
+void BGFX_SupersampleInvalidate(BGFX_Supersample_t *Supersample, int16_t x,
+    int16_t y, int16_t w, int16_t h);
+
+
+/**************************************************************************/
+/*!
+    @brief  Average the changed area of the surface into the display buffer
+            and clear it
+    @param  Supersample Surface to resolve
+    @param  Region  Returns the resolved area, display buffer coordinates
+    @param  Display Display to resolve to
+    @return 1 if something was resolved, 0 if nothing changed or Display
+            holds a band (see bgfx_band.h), in which case nothing is
+            written and the changed area is kept
+ */
+/**************************************************************************/
+uint8_t BGFX_SupersampleResolve(BGFX_Supersample_t *Supersample,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_SUPERSAMPLE_H */
@@ -0,0 +1,602 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_text.h"
+
+
+/**
+ * @brief Font metrics, scaled by the size multiplier
+ */
+typedef struct
+{
+  const BGFXfont *Font; /*!< Font, NULL for the classic 6x8 font */
+  uint8_t Size;         /*!< Size multiplier */
+  int16_t LineHeight;   /*!< Distance between two lines */
+  int16_t Ascent;       /*!< Distance from the top of a line to the baseline */
+}BGFX_TextFont_t;
+
+
+/**
+ * @brief One laid out line
+ */
+typedef struct
+{
+  const uint8_t *Text;  /*!< Whole text */
+  uint16_t Start;       /*!< First character of the line */
+  uint16_t End;         /*!< Character after the last one of the line */
+  uint16_t Next;        /*!< First character of the next line */
+  int16_t Width;        /*!< Width of the line in pixels */
+}BGFX_TextLine_t;
+
+
+/**
+ * @brief Unicode code points of CP437 characters 0x80 to 0xFF
+ */
+static const uint16_t BGFX_Cp437High[128] = {
+    0x00C7, 0x00FC, 0x00E9, 0x00E2, 0x00E4, 0x00E0, 0x00E5, 0x00E7,
+    0x00EA, 0x00EB, 0x00E8, 0x00EF, 0x00EE, 0x00EC, 0x00C4, 0x00C5,
+    0x00C9, 0x00E6, 0x00C6, 0x00F4, 0x00F6, 0x00F2, 0x00FB, 0x00F9,
+    0x00FF, 0x00D6, 0x00DC, 0x00A2, 0x00A3, 0x00A5, 0x20A7, 0x0192,
+    0x00E1, 0x00ED, 0x00F3, 0x00FA, 0x00F1, 0x00D1, 0x00AA, 0x00BA,
+    0x00BF, 0x2310, 0x00AC, 0x00BD, 0x00BC, 0x00A1, 0x00AB, 0x00BB,
+    0x2591, 0x2592, 0x2593, 0x2502, 0x2524, 0x2561, 0x2562, 0x2556,
+    0x2555, 0x2563, 0x2551, 0x2557, 0x255D, 0x255C, 0x255B, 0x2510,
+    0x2514, 0x2534, 0x252C, 0x251C, 0x2500, 0x253C, 0x255E, 0x255F,
+    0x255A, 0x2554, 0x2569, 0x2566, 0x2560, 0x2550, 0x256C, 0x2567,
+    0x2568, 0x2564, 0x2565, 0x2559, 0x2558, 0x2552, 0x2553, 0x256B,
+    0x256A, 0x2518, 0x250C, 0x2588, 0x2584, 0x258C, 0x2590, 0x2580,
+    0x03B1, 0x00DF, 0x0393, 0x03C0, 0x03A3, 0x03C3, 0x00B5, 0x03C4,
+    0x03A6, 0x0398, 0x03A9, 0x03B4, 0x221E, 0x03C6, 0x03B5, 0x2229,
+    0x2261, 0x00B1, 0x2265, 0x2264, 0x2320, 0x2321, 0x00F7, 0x2248,
+    0x00B0, 0x2219, 0x00B7, 0x221A, 0x207F, 0x00B2, 0x25A0, 0x00A0,
+};
+
+
+static void BGFX_TextFontSetup(BGFX_TextFont_t *Font, uint8_t Size,
+    BGFX_Parameters_t Display);
+
+static int16_t BGFX_TextAdvance(const BGFX_TextFont_t *Font, uint8_t c);
+
+static uint8_t BGFX_TextNextLine(BGFX_TextLine_t *Line, int16_t MaxWidth,
+    const BGFX_TextFont_t *Font);
+
+static void BGFX_TextPrepare(const char *Src, uint8_t *Dst,
+    BGFX_Parameters_t Display);
+
+static int16_t BGFX_TextOrigin(BGFX_Rect_t Box, BGFX_Align_t Align,
+    int16_t Width);
+
+static void BGFX_TextRun(const uint8_t *Text, uint16_t Start, uint16_t End,
+    int16_t x, int16_t y, uint16_t color, uint16_t bg, BGFX_Rect_t Box,
+    const BGFX_TextFont_t *Font, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display);
+
+static void BGFX_TextClear(int16_t x, int16_t y, int16_t w, uint16_t bg,
+    BGFX_Rect_t Box, const BGFX_TextFont_t *Font, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display);
+
+static void BGFX_TextGlyph(int16_t x, int16_t y, uint8_t c, uint16_t color,
+    const BGFX_TextFont_t *Font, BGFX_Parameters_t Display);
+
+
+
+uint16_t BGFX_Utf8ToCp437(const char *Src, uint8_t *Dst, uint16_t Size)
+{
+  const uint8_t *s = (const uint8_t *)Src;
+  uint32_t cp;
+  uint16_t n = 0;
+  uint8_t length, i;
+
+  if (Size == 0) {
+    return 0;
+  }
+
+  while ((*s != 0) && (n + 1 < Size)) {
+    /* Decode one code point, '?' for malformed sequences */
+    if (*s < 0x80) {
+      cp = *s;
+      length = 1;
+    } else if ((*s & 0xE0) == 0xC0) {
+      cp = *s & 0x1F;
+      length = 2;
+    } else if ((*s & 0xF0) == 0xE0) {
+      cp = *s & 0x0F;
+      length = 3;
+    } else if ((*s & 0xF8) == 0xF0) {
+      cp = *s & 0x07;
+      length = 4;
+    } else {
+      cp = '?';
+      length = 1;
+    }
+    for (i = 1; i < length; i++) {
+      if ((s[i] & 0xC0) != 0x80) {
+        cp = '?';
+        length = 1;
+        break;
+      }
+      cp = (cp << 6) | (s[i] & 0x3F);
+    }
+    s += length;
+
+    if (cp >= 0x80) {
+      for (i = 0; i < 128; i++) {
+        if (BGFX_Cp437High[i] == cp) {
+          break;
+        }
+      }
+      cp = (i < 128) ? 0x80 + i : '?';
+    }
+    Dst[n++] = (uint8_t)cp;
+  }
+
+  Dst[n] = 0;
+  return n;
+}
+
+
+
+
+uint16_t BGFX_TextMeasure(const char *Text, int16_t MaxWidth, uint8_t Size,
+    int16_t *w, int16_t *h, BGFX_Parameters_t Display)
+{
+  uint8_t buffer[BGFX_TEXT_MAX_LENGTH];
+  BGFX_TextFont_t font;
+  BGFX_TextLine_t line;
+  uint16_t lines = 0;
+
+  BGFX_TextFontSetup(&font, Size, Display);
+  BGFX_TextPrepare(Text, buffer, Display);
+  line.Text = buffer;
+  line.Next = 0;
+
+  *w = 0;
+  while (BGFX_TextNextLine(&line, MaxWidth, &font)) {
+    if (line.Width > *w) {
+      *w = line.Width;
+    }
+    lines++;
+  }
+  *h = lines * font.LineHeight;
+  return lines;
+}
+
+
+
+
+uint16_t BGFX_DrawText(const char *Text, BGFX_Rect_t Box, BGFX_Align_t Align,
+    uint8_t Wrap, uint16_t color, uint16_t bg, uint8_t Size,
+    BGFX_Parameters_t Display)
+{
+  uint8_t buffer[BGFX_TEXT_MAX_LENGTH];
+  BGFX_TextFont_t font;
+  BGFX_TextLine_t line;
+  BGFX_Rect_t region = {0, 0, 0, 0};
+  uint16_t lines = 0;
+  int16_t y = Box.Y;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  BGFX_TextFontSetup(&font, Size, Display);
+  BGFX_TextPrepare(Text, buffer, Display);
+  line.Text = buffer;
+  line.Next = 0;
+
+  while (BGFX_TextNextLine(&line, Wrap ? Box.W : 0, &font)) {
+    if (y + font.LineHeight > Box.Y + Box.H) {
+      break;
+    }
+    /* Lines off the display are laid out but not rendered */
+    if ((y + font.LineHeight > 0) && (y < Display.Height)) {
+      BGFX_TextRun(buffer, line.Start, line.End,
+          BGFX_TextOrigin(Box, Align, line.Width), y, color, bg, Box, &font,
+          &region, Display);
+    }
+    y += font.LineHeight;
+    lines++;
+  }
+
+  return lines;
+}
+
+
+
+
+void BGFX_TextInvalidate(BGFX_Text_t *Text)
+{
+  Text->Valid = 0;
+}
+
+
+
+
+uint8_t BGFX_TextUpdate(BGFX_Text_t *Text, const char *String,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display)
+{
+  uint8_t buffer[BGFX_TEXT_MAX_LENGTH];
+  BGFX_TextFont_t font;
+  BGFX_TextLine_t a, b;
+  BGFX_Rect_t box = Text->Box;
+  int16_t y = box.Y;
+  int16_t xa, xb, x, adv, wrap;
+  uint16_t la, lb, k;
+  uint8_t has_a, has_b, ca, cb;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  BGFX_TextFontSetup(&font, Text->Size, Display);
+  BGFX_TextPrepare(String, buffer, Display);
+  wrap = Text->Wrap ? box.W : 0;
+  Region->X = box.X;
+  Region->Y = box.Y;
+  Region->W = 0;
+  Region->H = 0;
+
+  if (!Text->Valid) {
+    BGFX_DrawRectFill(box.X, box.Y, box.W, box.H, Text->Background, Display);
+    BGFX_DrawText(String, box, Text->Align, Text->Wrap, Text->Color,
+        Text->Background, Text->Size, Display);
+    memcpy(Text->Shown, buffer, sizeof(buffer));
+    Text->Valid = 1;
+    *Region = box;
+    return 1;
+  }
+
+  /* Walk the lines on screen (a) and the new lines (b) side by side */
+  a.Text = Text->Shown;
+  a.Next = 0;
+  b.Text = buffer;
+  b.Next = 0;
+  has_a = BGFX_TextNextLine(&a, wrap, &font);
+  has_b = BGFX_TextNextLine(&b, wrap, &font);
+
+  while ((has_a || has_b) && (y + font.LineHeight <= box.Y + box.H)) {
+    if ((y + font.LineHeight > 0) && (y < Display.Height)) {
+      xa = has_a ? BGFX_TextOrigin(box, Text->Align, a.Width) : box.X;
+      xb = has_b ? BGFX_TextOrigin(box, Text->Align, b.Width) : box.X;
+      la = has_a ? a.End - a.Start : 0;
+      lb = has_b ? b.End - b.Start : 0;
+
+      if (has_a && has_b && (xa == xb) && (font.Font == NULL)) {
+        /* Fixed width cells, redraw the ones that differ */
+        adv = BGFX_TextAdvance(&font, ' ');
+        for (k = 0; (k < la) || (k < lb); k++) {
+          ca = (k < la) ? a.Text[a.Start + k] : 0;
+          cb = (k < lb) ? b.Text[b.Start + k] : 0;
+          if (ca == cb) {
+            continue;
+          }
+          x = xb + k * adv;
+          if (cb) {
+            BGFX_TextRun(b.Text, b.Start + k, b.Start + k + 1, x, y,
+                Text->Color, Text->Background, box, &font, Region, Display);
+          } else {
+            BGFX_TextClear(x, y, adv, Text->Background, box, &font, Region,
+                Display);
+          }
+        }
+      } else if (has_a && has_b && (xa == xb)) {
+        /* Proportional font, redraw the end of the line from the first
+           difference */
+        x = xb;
+        for (k = 0; (k < la) && (k < lb); k++) {
+          if (a.Text[a.Start + k] != b.Text[b.Start + k]) {
+            break;
+          }
+          x += BGFX_TextAdvance(&font, b.Text[b.Start + k]);
+        }
+        if ((k < la) || (k < lb)) {
+          adv = ((a.Width > b.Width) ? a.Width : b.Width) - (x - xb);
+          BGFX_TextClear(x, y, adv, Text->Background, box, &font, Region,
+              Display);
+          BGFX_TextRun(b.Text, b.Start + k, b.End, x, y, Text->Color,
+              Text->Color, box, &font, Region, Display);
+        }
+      } else {
+        /* Line moved or appeared or vanished, redraw it all */
+        if (has_a) {
+          BGFX_TextClear(xa, y, a.Width, Text->Background, box, &font, Region,
+              Display);
+        }
+        if (has_b) {
+          BGFX_TextClear(xb, y, b.Width, Text->Background, box, &font,
+              Region, Display);
+          BGFX_TextRun(b.Text, b.Start, b.End, xb, y, Text->Color,
+              Text->Color, box, &font, Region, Display);
+        }
+      }
+    }
+
+    y += font.LineHeight;
+    has_a = has_a ? BGFX_TextNextLine(&a, wrap, &font) : 0;
+    has_b = has_b ? BGFX_TextNextLine(&b, wrap, &font) : 0;
+  }
+
+  memcpy(Text->Shown, buffer, sizeof(buffer));
+  return (Region->W > 0) && (Region->H > 0);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the metrics of the font of a display
+    @param  Font    Returns the metrics
+    @param  Size    Size multiplier, 0 is the same as 1
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_TextFontSetup(BGFX_TextFont_t *Font, uint8_t Size,
+    BGFX_Parameters_t Display)
+{
+  const BGFXfont *f = Display.GfxFont;
+  int16_t top = 0;
+  uint16_t i;
+
+  Font->Font = f;
+  Font->Size = Size ? Size : 1;
+  if (f == NULL) {
+    Font->LineHeight = 8 * Font->Size;
+    Font->Ascent = 0;
+    return;
+  }
+
+  /* Highest glyph top above the baseline */
+  for (i = 0; i <= f->last - f->first; i++) {
+    if (f->glyph[i].yOffset < top) {
+      top = f->glyph[i].yOffset;
+    }
+  }
+  Font->LineHeight = f->yAdvance * Font->Size;
+  Font->Ascent = -top * Font->Size;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Horizontal advance of a character
+    @param  Font    Font metrics
+    @param  c       Character, font charset
+    @return Advance in pixels, 0 for characters missing from the font
+ */
+/**************************************************************************/
+static int16_t BGFX_TextAdvance(const BGFX_TextFont_t *Font, uint8_t c)
+{
+  if (Font->Font == NULL) {
+    return 6 * Font->Size;
+  }
+  if ((c < Font->Font->first) || (c > Font->Font->last)) {
+    return 0;
+  }
+  return Font->Font->glyph[c - Font->Font->first].xAdvance * Font->Size;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Lay out the next line of a text
+    @param  Line    Line, Text and Next set, moved to the next line
+    @param  MaxWidth  Width to wrap at, 0 or less for no wrapping
+    @param  Font    Font metrics
+    @return 1 if there is a line, 0 at the end of the text
+ */
+/**************************************************************************/
+static uint8_t BGFX_TextNextLine(BGFX_TextLine_t *Line, int16_t MaxWidth,
+    const BGFX_TextFont_t *Font)
+{
+  const uint8_t *t = Line->Text;
+  uint16_t i, space = 0;
+  int16_t w = 0, w_space = 0, adv;
+  uint8_t has_space = 0;
+
+  if (t[Line->Next] == 0) {
+    return 0;
+  }
+
+  Line->Start = Line->Next;
+  for (i = Line->Start; (t[i] != 0) && (t[i] != '\n'); i++) {
+    adv = BGFX_TextAdvance(Font, t[i]);
+    if ((MaxWidth > 0) && (w + adv > MaxWidth) && (i > Line->Start)) {
+      if (has_space) {
+        /* Break at the last space, which is dropped */
+        Line->End = space;
+        Line->Next = space + 1;
+        Line->Width = w_space;
+      } else {
+        /* A single word wider than the box, cut it */
+        Line->End = i;
+        Line->Next = i;
+        Line->Width = w;
+      }
+      return 1;
+    }
+    if (t[i] == ' ') {
+      space = i;
+      w_space = w;
+      has_space = 1;
+    }
+    w += adv;
+  }
+
+  Line->End = i;
+  Line->Next = (t[i] == '\n') ? i + 1 : i;
+  Line->Width = w;
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Copy a string in the charset of the font, converting it from
+            UTF-8 when Display.Cp437 is set
+    @param  Src     Zero terminated string
+    @param  Dst     BGFX_TEXT_MAX_LENGTH bytes, returns the converted string
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_TextPrepare(const char *Src, uint8_t *Dst,
+    BGFX_Parameters_t Display)
+{
+  if (Display.Cp437) {
+    BGFX_Utf8ToCp437(Src, Dst, BGFX_TEXT_MAX_LENGTH);
+  } else {
+    strncpy((char *)Dst, Src, BGFX_TEXT_MAX_LENGTH - 1);
+    Dst[BGFX_TEXT_MAX_LENGTH - 1] = 0;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Left side of a line once aligned
+    @param  Box     Layout box
+    @param  Align   Horizontal alignment
+    @param  Width   Width of the line
+    @return Line x coordinate
+ */
+/**************************************************************************/
+static int16_t BGFX_TextOrigin(BGFX_Rect_t Box, BGFX_Align_t Align,
+    int16_t Width)
+{
+  switch (Align) {
+  case BGFX_ALIGN_CENTER:
+    return Box.X + (Box.W - Width) / 2;
+  case BGFX_ALIGN_RIGHT:
+    return Box.X + Box.W - Width;
+  default:
+    return Box.X;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw characters of a line. Characters whose cell is not fully
+            inside the box, or is off the display, are skipped.
+    @param  Text    Text, font charset
+    @param  Start   First character to draw
+    @param  End     Character after the last one to draw
+    @param  x   Left side of the first character
+    @param  y   Top of the line
+    @param  color   Text color
+    @param  bg      Background color, same as color for a transparent
+                    background
+    @param  Box     Layout box
+    @param  Font    Font metrics
+    @param  Region  Grown to cover the cells drawn
+    @param  Display Structure to display parameters and functions, rotation
+            already applied
+ */
+/**************************************************************************/
+static void BGFX_TextRun(const uint8_t *Text, uint16_t Start, uint16_t End,
+    int16_t x, int16_t y, uint16_t color, uint16_t bg, BGFX_Rect_t Box,
+    const BGFX_TextFont_t *Font, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t cell;
+  int16_t adv;
+
+  cell.Y = y;
+  cell.H = Font->LineHeight;
+  for (; Start < End; Start++, x += adv) {
+    adv = BGFX_TextAdvance(Font, Text[Start]);
+    if ((adv == 0) || (x < Box.X) || (x + adv > Box.X + Box.W) ||
+        (x < 0) || (y < 0) || (x >= Display.Width)) {
+      continue;
+    }
+
+    if (Font->Font == NULL) {
+      BGFX_DrawChar(x, y, Text[Start], color, bg, Font->Size, Font->Size,
+          Display);
+    } else {
+      if (bg != color) {
+        BGFX_DrawRectFill(x, y, adv, Font->LineHeight, bg, Display);
+      }
+      BGFX_TextGlyph(x, y + Font->Ascent, Text[Start], color, Font, Display);
+    }
+    cell.X = x;
+    cell.W = adv;
+    BGFX_RectUnion(Region, cell);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Clear part of a line, clipped to the box
+    @param  x   Left side
+    @param  y   Top of the line
+    @param  w   Width in pixels
+    @param  bg  Background color
+    @param  Box     Layout box
+    @param  Font    Font metrics
+    @param  Region  Grown to cover the area cleared
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_TextClear(int16_t x, int16_t y, int16_t w, uint16_t bg,
+    BGFX_Rect_t Box, const BGFX_TextFont_t *Font, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t r;
+
+  if (x < Box.X) {
+    w -= Box.X - x;
+    x = Box.X;
+  }
+  if (x + w > Box.X + Box.W) {
+    w = Box.X + Box.W - x;
+  }
+  if (w <= 0) {
+    return;
+  }
+
+  BGFX_DrawRectFill(x, y, w, Font->LineHeight, bg, Display);
+  r.X = x;
+  r.Y = y;
+  r.W = w;
+  r.H = Font->LineHeight;
+  BGFX_RectUnion(Region, r);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a glyph of a BGFXfont, foreground only. Bits are read most
+            significant first, rows follow each other without padding, and
+            every run of set bits in a row is drawn as one span.
+    @param  x   Cursor x coordinate
+    @param  y   Baseline y coordinate
+    @param  c   Character, must be in the font
+    @param  color   Text color
+    @param  Font    Font metrics
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_TextGlyph(int16_t x, int16_t y, uint8_t c, uint16_t color,
+    const BGFX_TextFont_t *Font, BGFX_Parameters_t Display)
+{
+  const BGFXglyph *g = &Font->Font->glyph[c - Font->Font->first];
+  const uint8_t *bitmap = Font->Font->bitmap + g->bitmapOffset;
+  uint8_t s = Font->Size;
+  uint8_t bits = 0, bit = 0;
+  int16_t xx, yy, run;
+
+  for (yy = 0; yy < g->height; yy++) {
+    run = -1;
+    for (xx = 0; xx <= g->width; xx++) {
+      uint8_t on = 0;
+      if (xx < g->width) {
+        if ((bit++ & 7) == 0) {
+          bits = *bitmap++;
+        }
+        on = bits & 0x80;
+        bits <<= 1;
+      }
+      if (on && (run < 0)) {
+        run = xx;
+      } else if (!on && (run >= 0)) {
+        BGFX_DrawRectFill(x + (g->xOffset + run) * s, y + (g->yOffset + yy) * s,
+            (xx - run) * s, s, color, Display);
+        run = -1;
+      }
+    }
+  }
+}
@@ -0,0 +1,151 @@
+/**
+ * @file  bgfx_text.h
+ * @date  19-October-2026
+ * @brief Text layout: measurement, word wrap, alignment and incremental
+ *        redraw.
+ *
+ * @author
+ * @author
+ *
+ * Text is laid out in a box, line by line, with the classic 6x8 font or the
+ * BGFXfont pointed to by Display.GfxFont, scaled by Size. Lines break at
+ * '\n' and, when wrapping, at the last space that fits. Lines outside the
+ * box or the display are skipped without being rendered.
+ *
+ * When Display.Cp437 is set the strings are UTF-8 and are mapped to code
+ * page 437, the charset of the classic font. Otherwise bytes are used as
+ * they are.
+ *
+ * BGFX_Text_t remembers the text on screen: BGFX_TextUpdate only redraws
+ * the character cells that differ from it (with the classic font), or the
+ * end of the lines from the first difference (proportional fonts).
+ */
+
+#ifndef BGFX_TEXT_H
+#define BGFX_TEXT_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef BGFX_TEXT_MAX_LENGTH
+#define BGFX_TEXT_MAX_LENGTH 128 /*!< Longest text laid out, terminator
+                                      included, longer text is cut */
+#endif
+
+
+/**
+ * @brief Horizontal alignment of the lines in their box
+ */
+typedef enum
+{
+  BGFX_ALIGN_LEFT = 0,    /*!< Lines start at the left side of the box */
+  BGFX_ALIGN_CENTER,      /*!< Lines are centered in the box */
+  BGFX_ALIGN_RIGHT,       /*!< Lines end at the right side of the box */
+}BGFX_Align_t;
+
+
+/**
+ * @brief Text field, the fields up to Size are set by the caller
+ */
+typedef struct
+{
+  BGFX_Rect_t Box;      /*!< Layout box, screen coordinates */
+  BGFX_Align_t Align;   /*!< Horizontal alignment */
+  uint8_t Wrap;         /*!< If set, lines wrap at spaces to fit the box */
+  uint16_t Color;       /*!< Text color */
+  uint16_t Background;  /*!< Background color, cells and box are cleared
+                             with it */
+  uint8_t Size;         /*!< Font size multiplier, 0 is the same as 1 */
+
+  uint8_t Valid;        /*!< Set once drawn, cleared to draw everything */
+  uint8_t Shown[BGFX_TEXT_MAX_LENGTH]; /*!< Text on screen, font charset */
+}BGFX_Text_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Convert a UTF-8 string to code page 437. Characters without a
+            CP437 equivalent become '?'.
+    @param  Src     Zero terminated UTF-8 string
+    @param  Dst     Returns the zero terminated CP437 string
+    @param  Size    Size of Dst in bytes, terminator included
+    @return Number of characters written, terminator excluded
+ */
+/**************************************************************************/
+uint16_t BGFX_Utf8ToCp437(const char *Src, uint8_t *Dst, uint16_t Size);
+
+
+/**************************************************************************/
+/*!
+    @brief  Measure a text without drawing it
+    @param  Text    Zero terminated string
+    @param  MaxWidth  Width to wrap at, 0 or less for no wrapping
+    @param  Size    Font size multiplier, 0 is the same as 1
+    @param  w   Returns the width of the widest line
+    @param  h   Returns the height of all lines
+    @param  Display Structure to display parameters and functions
+    @return Number of lines
+ */
+/**************************************************************************/
+uint16_t BGFX_TextMeasure(const char *Text, int16_t MaxWidth, uint8_t Size,
+    int16_t *w, int16_t *h, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a text laid out in a box. Only the cells of the characters
+            are drawn, the rest of the box is left as it is.
+    @param  Text    Zero terminated string
+    @param  Box     Layout box, lines and characters outside are not drawn
+    @param  Align   Horizontal alignment
+    @param  Wrap    If set, lines wrap at spaces to fit the box
+    @param  color   Text color
+    @param  bg      Background color, same as color for a transparent
+                    background
+    @param  Size    Font size multiplier, 0 is the same as 1
+    @param  Display Structure to display parameters and functions
+    @return Number of lines
+ */
+/**************************************************************************/
+uint16_t BGFX_DrawText(const char *Text, BGFX_Rect_t Box, BGFX_Align_t Align,
+    uint8_t Wrap, uint16_t color, uint16_t bg, uint8_t Size,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Have the whole field drawn again on the next BGFX_TextUpdate
+    @param  Text    Text field
+ */
+/**************************************************************************/
+void BGFX_TextInvalidate(BGFX_Text_t *Text);
+
+
+/**************************************************************************/
+/*!
+    @brief  Show a new string in a text field, redrawing only what differs
+            from the text on screen. The first time, or after
+            BGFX_TextInvalidate, the box is cleared and everything drawn.
+    @param  Text    Text field
+    @param  String  Zero terminated string to show
+    @param  Region  Returns the area drawn, screen coordinates, empty if
+            nothing changed
+    @param  Display Structure to display parameters and functions
+    @return 1 if something was drawn, 0 otherwise
+ */
+/**************************************************************************/
+uint8_t BGFX_TextUpdate(BGFX_Text_t *Text, const char *String,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_TEXT_H */
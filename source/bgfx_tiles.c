@@ -0,0 +1,449 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_tiles.h"
+#include "bgfx_spans.h"
+
+
+/**
+ * @brief Working state of a shape fill, handed to the span function
+ */
+typedef struct
+{
+  BGFX_Tiles_t *Tiles;  /*!< Framebuffer being drawn to */
+  BGFX_Parameters_t *Display;   /*!< Display giving rotation and size */
+  uint16_t Color;       /*!< Color to fill with */
+}BGFX_TilesJob_t;
+
+
+static void BGFX_TilesSpan(int16_t x, int16_t y, int16_t w, void *Context);
+
+static void BGFX_TilesFill(BGFX_Tiles_t *Tiles, BGFX_Rect_t Area,
+    uint16_t color);
+
+static uint16_t BGFX_TilesSplit(BGFX_Tiles_t *Tiles, uint32_t Tile);
+
+static void BGFX_TilesRelease(BGFX_Tiles_t *Tiles, uint32_t Tile,
+    uint16_t color);
+
+static uint8_t BGFX_TilesSolid(const BGFX_Tiles_t *Tiles, uint32_t Tile);
+
+
+
+uint32_t BGFX_TilesGridSize(BGFX_Parameters_t Display)
+{
+  uint32_t columns = (Display.WIDTH + BGFX_TILE_SIZE - 1) / BGFX_TILE_SIZE;
+  uint32_t rows = (Display.HEIGHT + BGFX_TILE_SIZE - 1) / BGFX_TILE_SIZE;
+
+  return columns * rows * 2 * sizeof(uint16_t);
+}
+
+
+
+
+int BGFX_TilesInit(BGFX_Tiles_t *Tiles, void *Grid, void *Pool,
+    uint32_t PoolSize, uint16_t color, BGFX_Parameters_t Display)
+{
+  uint32_t count, i;
+
+  if (Display.ColorScheme != BGFX_16BITS) {
+    return -1;
+  }
+
+  Tiles->WIDTH = Display.WIDTH;
+  Tiles->HEIGHT = Display.HEIGHT;
+  Tiles->Columns = (Display.WIDTH + BGFX_TILE_SIZE - 1) / BGFX_TILE_SIZE;
+  Tiles->Rows = (Display.HEIGHT + BGFX_TILE_SIZE - 1) / BGFX_TILE_SIZE;
+  count = (uint32_t)Tiles->Columns * Tiles->Rows;
+  Tiles->Colors = (uint16_t *)Grid;
+  Tiles->Slots = (uint16_t *)Grid + count;
+  for (i = 0; i < count; i++) {
+    Tiles->Colors[i] = color;
+    Tiles->Slots[i] = BGFX_TILE_SOLID;
+  }
+
+  /* Every slot free, each one linked to the next */
+  Tiles->Pool = (uint16_t *)Pool;
+  PoolSize /= BGFX_TILE_SIZE * BGFX_TILE_SIZE * sizeof(uint16_t);
+  Tiles->PoolSlots = (Pool == NULL) ? 0 :
+      (PoolSize < BGFX_TILE_SOLID) ? (uint16_t)PoolSize : BGFX_TILE_SOLID - 1;
+  for (i = 0; i < Tiles->PoolSlots; i++) {
+    Tiles->Pool[i * BGFX_TILE_SIZE * BGFX_TILE_SIZE] =
+        (i + 1 < Tiles->PoolSlots) ? (uint16_t)(i + 1) : BGFX_TILE_SOLID;
+  }
+  Tiles->Free = (Tiles->PoolSlots > 0) ? 0 : BGFX_TILE_SOLID;
+  Tiles->Used = 0;
+  Tiles->Peak = 0;
+  Tiles->Dropped = 0;
+  return 0;
+}
+
+
+
+
+void BGFX_TilesFillRect(BGFX_Tiles_t *Tiles, int16_t x, int16_t y, int16_t w,
+    int16_t h, uint16_t color, BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t r;
+
+  if ((w <= 0) || (h <= 0)) {
+    return;
+  }
+
+  r.X = x;
+  r.Y = y;
+  r.W = w;
+  r.H = h;
+  BGFX_RectIntersect(&r, BGFX_GetClip(Display));
+  if ((r.W > 0) && (r.H > 0)) {
+    BGFX_TilesFill(Tiles, BGFX_RectToBuffer(r, Display), color);
+  }
+}
+
+
+
+
+void BGFX_TilesFillRoundRect(BGFX_Tiles_t *Tiles, int16_t x, int16_t y,
+    int16_t w, int16_t h, int16_t r, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_TilesJob_t job = {Tiles, &Display, color};
+
+  BGFX_SpansRoundRect(x, y, w, h, r, BGFX_TilesSpan, &job, Display);
+}
+
+
+
+
+void BGFX_TilesFillCircle(BGFX_Tiles_t *Tiles, int16_t x0, int16_t y0,
+    int16_t r, uint16_t color, BGFX_Parameters_t Display)
+{
+  BGFX_TilesJob_t job = {Tiles, &Display, color};
+
+  BGFX_SpansCircle(x0, y0, r, BGFX_TilesSpan, &job, Display);
+}
+
+
+
+
+void BGFX_TilesFillTriangle(BGFX_Tiles_t *Tiles, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_TilesJob_t job = {Tiles, &Display, color};
+
+  BGFX_SpansTriangle(x0, y0, x1, y1, x2, y2, BGFX_TilesSpan, &job, Display);
+}
+
+
+
+
+void BGFX_TilesFillPolygon(BGFX_Tiles_t *Tiles, const int16_t *Points,
+    uint16_t Count, uint16_t color, BGFX_Parameters_t Display)
+{
+  BGFX_TilesJob_t job = {Tiles, &Display, color};
+
+  BGFX_SpansPolygon(Points, Count, BGFX_TilesSpan, &job, Display);
+}
+
+
+
+
+void BGFX_TilesWritePixel(BGFX_Tiles_t *Tiles, uint16_t x, uint16_t y,
+    uint16_t color)
+{
+  uint32_t tile;
+  uint16_t slot;
+
+  if ((x >= Tiles->WIDTH) || (y >= Tiles->HEIGHT)) {
+    return;
+  }
+
+  tile = (uint32_t)(y / BGFX_TILE_SIZE) * Tiles->Columns + x / BGFX_TILE_SIZE;
+  slot = Tiles->Slots[tile];
+  if (slot == BGFX_TILE_SOLID) {
+    if (Tiles->Colors[tile] == color) {
+      return;
+    }
+    slot = BGFX_TilesSplit(Tiles, tile);
+    if (slot == BGFX_TILE_SOLID) {
+      return;
+    }
+  }
+  Tiles->Pool[(uint32_t)slot * BGFX_TILE_SIZE * BGFX_TILE_SIZE +
+      (y % BGFX_TILE_SIZE) * BGFX_TILE_SIZE + x % BGFX_TILE_SIZE] = color;
+}
+
+
+
+
+uint16_t BGFX_TilesReadPixel(const BGFX_Tiles_t *Tiles, uint16_t x,
+    uint16_t y)
+{
+  uint32_t tile;
+  uint16_t slot;
+
+  if ((x >= Tiles->WIDTH) || (y >= Tiles->HEIGHT)) {
+    return 0;
+  }
+
+  tile = (uint32_t)(y / BGFX_TILE_SIZE) * Tiles->Columns + x / BGFX_TILE_SIZE;
+  slot = Tiles->Slots[tile];
+  if (slot == BGFX_TILE_SOLID) {
+    return Tiles->Colors[tile];
+  }
+  return Tiles->Pool[(uint32_t)slot * BGFX_TILE_SIZE * BGFX_TILE_SIZE +
+      (y % BGFX_TILE_SIZE) * BGFX_TILE_SIZE + x % BGFX_TILE_SIZE];
+}
+
+
+
+
+uint16_t BGFX_TilesCompact(BGFX_Tiles_t *Tiles)
+{
+  uint32_t count = (uint32_t)Tiles->Columns * Tiles->Rows;
+  uint32_t tile;
+  uint16_t freed = 0;
+
+  for (tile = 0; tile < count; tile++) {
+    if ((Tiles->Slots[tile] != BGFX_TILE_SOLID) &&
+        BGFX_TilesSolid(Tiles, tile)) {
+      BGFX_TilesRelease(Tiles, tile, Tiles->Pool[(uint32_t)Tiles->Slots[tile]
+          * BGFX_TILE_SIZE * BGFX_TILE_SIZE]);
+      freed++;
+    }
+  }
+  return freed;
+}
+
+
+
+
+void BGFX_TilesFlush(const BGFX_Tiles_t *Tiles, BGFX_Rect_t Area,
+    uint16_t *Row, BGFX_TilesFlush_t Flush, void *Context)
+{
+  BGFX_Rect_t all = {0, 0, 0, 0};
+  const uint16_t *src;
+  uint32_t tile;
+  uint16_t color, slot;
+  int16_t x, y, end, n, i;
+
+  all.W = Tiles->WIDTH;
+  all.H = Tiles->HEIGHT;
+  BGFX_RectIntersect(&Area, all);
+  if ((Area.W <= 0) || (Area.H <= 0)) {
+    return;
+  }
+
+  for (y = Area.Y; y < Area.Y + Area.H; y++) {
+    tile = (uint32_t)(y / BGFX_TILE_SIZE) * Tiles->Columns;
+    end = Area.X + Area.W;
+
+    /* One piece per tile crossed by the row */
+    for (x = Area.X; x < end; x += n) {
+      n = BGFX_TILE_SIZE - x % BGFX_TILE_SIZE;
+      n = (x + n > end) ? end - x : n;
+      slot = Tiles->Slots[tile + x / BGFX_TILE_SIZE];
+      if (slot == BGFX_TILE_SOLID) {
+        color = Tiles->Colors[tile + x / BGFX_TILE_SIZE];
+        for (i = 0; i < n; i++) {
+          Row[x - Area.X + i] = color;
+        }
+      } else {
+        src = Tiles->Pool + (uint32_t)slot * BGFX_TILE_SIZE * BGFX_TILE_SIZE +
+            (y % BGFX_TILE_SIZE) * BGFX_TILE_SIZE + x % BGFX_TILE_SIZE;
+        memcpy(Row + (x - Area.X), src, n * sizeof(uint16_t));
+      }
+    }
+    Flush(Row, Area.X, y, Area.W, Context);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill one span of a shape, turned to buffer coordinates
+    @param  x   Left-most pixel x coordinate
+    @param  y   Row y coordinate
+    @param  w   Number of pixels
+    @param  Context Fill working state
+ */
+/**************************************************************************/
+static void BGFX_TilesSpan(int16_t x, int16_t y, int16_t w, void *Context)
+{
+  BGFX_TilesJob_t *job = (BGFX_TilesJob_t *)Context;
+  BGFX_Rect_t r;
+
+  r.X = x;
+  r.Y = y;
+  r.W = w;
+  r.H = 1;
+  if (job->Display->Rotation != 0) {
+    r = BGFX_RectToBuffer(r, *job->Display);
+  }
+  BGFX_TilesFill(job->Tiles, r, job->Color);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill an area tile by tile. Tiles covered whole become solid,
+            the others are split if needed and written.
+    @param  Tiles   Framebuffer to draw to
+    @param  Area    Area in buffer coordinates, inside the buffer
+    @param  color   Color to fill with
+ */
+/**************************************************************************/
+static void BGFX_TilesFill(BGFX_Tiles_t *Tiles, BGFX_Rect_t Area,
+    uint16_t color)
+{
+  uint16_t *dst;
+  uint32_t tile;
+  uint16_t slot;
+  int16_t tx, ty, x0, y0, x1, y1, tw, th, x, y;
+
+  for (ty = Area.Y / BGFX_TILE_SIZE;
+      ty <= (Area.Y + Area.H - 1) / BGFX_TILE_SIZE; ty++) {
+    /* Rows of the area inside this row of tiles, tile coordinates */
+    y0 = Area.Y - ty * BGFX_TILE_SIZE;
+    y0 = (y0 < 0) ? 0 : y0;
+    y1 = Area.Y + Area.H - ty * BGFX_TILE_SIZE;
+    y1 = (y1 > BGFX_TILE_SIZE) ? BGFX_TILE_SIZE : y1;
+    th = Tiles->HEIGHT - ty * BGFX_TILE_SIZE;
+    th = (th > BGFX_TILE_SIZE) ? BGFX_TILE_SIZE : th;
+
+    for (tx = Area.X / BGFX_TILE_SIZE;
+        tx <= (Area.X + Area.W - 1) / BGFX_TILE_SIZE; tx++) {
+      x0 = Area.X - tx * BGFX_TILE_SIZE;
+      x0 = (x0 < 0) ? 0 : x0;
+      x1 = Area.X + Area.W - tx * BGFX_TILE_SIZE;
+      x1 = (x1 > BGFX_TILE_SIZE) ? BGFX_TILE_SIZE : x1;
+      tw = Tiles->WIDTH - tx * BGFX_TILE_SIZE;
+      tw = (tw > BGFX_TILE_SIZE) ? BGFX_TILE_SIZE : tw;
+      tile = (uint32_t)ty * Tiles->Columns + tx;
+
+      /* Covered whole, edge tiles only up to the buffer side */
+      if ((x0 == 0) && (y0 == 0) && (x1 >= tw) && (y1 >= th)) {
+        BGFX_TilesRelease(Tiles, tile, color);
+        continue;
+      }
+
+      slot = Tiles->Slots[tile];
+      if (slot == BGFX_TILE_SOLID) {
+        if (Tiles->Colors[tile] == color) {
+          continue;
+        }
+        slot = BGFX_TilesSplit(Tiles, tile);
+        if (slot == BGFX_TILE_SOLID) {
+          continue;
+        }
+      }
+
+      dst = Tiles->Pool + (uint32_t)slot * BGFX_TILE_SIZE * BGFX_TILE_SIZE;
+      for (y = y0; y < y1; y++) {
+        for (x = x0; x < x1; x++) {
+          dst[y * BGFX_TILE_SIZE + x] = color;
+        }
+      }
+
+      /* A tile crossed by a whole line may be of a single color again once
+       * the shape is done with it, whatever the order of the lines */
+      if ((((x0 == 0) && (x1 >= tw)) || ((y0 == 0) && (y1 >= th))) &&
+          BGFX_TilesSolid(Tiles, tile)) {
+        BGFX_TilesRelease(Tiles, tile, color);
+      }
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Give pixels to a solid tile, all of its color
+    @param  Tiles   Framebuffer
+    @param  Tile    Index of a solid tile in the grid
+    @return Slot given, BGFX_TILE_SOLID if the pool is full
+ */
+/**************************************************************************/
+static uint16_t BGFX_TilesSplit(BGFX_Tiles_t *Tiles, uint32_t Tile)
+{
+  uint16_t slot = Tiles->Free;
+  uint16_t color = Tiles->Colors[Tile];
+  uint16_t *dst;
+  uint16_t i;
+
+  if (slot == BGFX_TILE_SOLID) {
+    Tiles->Dropped++;
+    return slot;
+  }
+
+  dst = Tiles->Pool + (uint32_t)slot * BGFX_TILE_SIZE * BGFX_TILE_SIZE;
+  Tiles->Free = dst[0];
+  for (i = 0; i < BGFX_TILE_SIZE * BGFX_TILE_SIZE; i++) {
+    dst[i] = color;
+  }
+  Tiles->Slots[Tile] = slot;
+  Tiles->Used++;
+  Tiles->Peak = (Tiles->Used > Tiles->Peak) ? Tiles->Used : Tiles->Peak;
+  return slot;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Make a tile solid, giving its pixels back to the pool
+    @param  Tiles   Framebuffer
+    @param  Tile    Index of the tile in the grid
+    @param  color   Color of the tile
+ */
+/**************************************************************************/
+static void BGFX_TilesRelease(BGFX_Tiles_t *Tiles, uint32_t Tile,
+    uint16_t color)
+{
+  uint16_t slot = Tiles->Slots[Tile];
+
+  if (slot != BGFX_TILE_SOLID) {
+    Tiles->Pool[(uint32_t)slot * BGFX_TILE_SIZE * BGFX_TILE_SIZE] =
+        Tiles->Free;
+    Tiles->Free = slot;
+    Tiles->Used--;
+    Tiles->Slots[Tile] = BGFX_TILE_SOLID;
+  }
+  Tiles->Colors[Tile] = color;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Test if the pixels of a detailed tile are all the same, those
+            inside the buffer only
+    @param  Tiles   Framebuffer
+    @param  Tile    Index of a tile with a slot
+    @return 1 if the tile has a single color, 0 otherwise
+ */
+/**************************************************************************/
+static uint8_t BGFX_TilesSolid(const BGFX_Tiles_t *Tiles, uint32_t Tile)
+{
+  const uint16_t *src = Tiles->Pool +
+      (uint32_t)Tiles->Slots[Tile] * BGFX_TILE_SIZE * BGFX_TILE_SIZE;
+  int16_t tw = Tiles->WIDTH - (Tile % Tiles->Columns) * BGFX_TILE_SIZE;
+  int16_t th = Tiles->HEIGHT - (Tile / Tiles->Columns) * BGFX_TILE_SIZE;
+  int16_t x, y;
+
+  tw = (tw > BGFX_TILE_SIZE) ? BGFX_TILE_SIZE : tw;
+  th = (th > BGFX_TILE_SIZE) ? BGFX_TILE_SIZE : th;
+
+  /* Corners first, they differ in most tiles that are not solid */
+  if ((src[tw - 1] != src[0]) || (src[(th - 1) * BGFX_TILE_SIZE] != src[0]) ||
+      (src[(th - 1) * BGFX_TILE_SIZE + tw - 1] != src[0])) {
+    return 0;
+  }
+  for (y = 0; y < th; y++) {
+    for (x = 0; x < tw; x++) {
+      if (src[y * BGFX_TILE_SIZE + x] != src[0]) {
+        return 0;
+      }
+    }
+  }
+  return 1;
+}
@@ -0,0 +1,251 @@
+/**
+ * @file  bgfx_tiles.h
+ * @date  19-October-2026
+ * @brief Tiled framebuffer: solid tiles stored as one color.
+ *
+ * @author
+ * @author
+ *
+ * A 5-6-5 framebuffer for large panels showing mostly flat screens. The
+ * buffer is cut in tiles of BGFX_TILE_SIZE x BGFX_TILE_SIZE pixels; a tile
+ * of a single color is kept as that color, only the tiles with detail get
+ * pixels, taken from a pool given by the caller. Memory grows with what is
+ * drawn rather than with the panel: a 480x320 screen of plain panels and
+ * a few icons needs the grid (2.4 KB with 16 pixels tiles) plus 512 bytes
+ * per detailed tile, instead of 300 KB.
+ *
+ * Rectangles cover whole tiles without touching pixels, they turn them
+ * back to solid and free their pixels. Other shapes are written span by
+ * span (see bgfx_spans.h); a detailed tile crossed by a whole row or column
+ * is checked, corners first, and made solid again if it holds a single
+ * color, so a large shape only keeps its edge tiles. Anything else
+ * can be drawn pixel by pixel through a DrawPixel function calling
+ * BGFX_TilesWritePixel. When the pool is full the pixels of tiles that
+ * would need splitting are not written and counted in Dropped.
+ *
+ * BGFX_TilesFlush expands an area row by row into a buffer of one row and
+ * hands each row to a callback, to be streamed to the panel. Areas are in
+ * buffer (unrotated) coordinates; drawing functions take screen coordinates
+ * and follow the rotation and clip rectangle of the Display given.
+ */
+
+#ifndef BGFX_TILES_H
+#define BGFX_TILES_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef BGFX_TILE_SIZE
+#define BGFX_TILE_SIZE 16 /*!< Tile width and height in pixels */
+#endif
+
+#define BGFX_TILE_SOLID 0xFFFF /*!< Slot of a tile stored as one color */
+
+
+/**
+ * @brief Tiled 5-6-5 framebuffer
+ */
+typedef struct
+{
+  uint16_t WIDTH;       /*!< Buffer width in pixels, as the display */
+  uint16_t HEIGHT;      /*!< Buffer height in pixels, as the display */
+  uint16_t Columns;     /*!< Tiles per row of tiles */
+  uint16_t Rows;        /*!< Rows of tiles */
+  uint16_t *Colors;     /*!< Color of each tile stored as one color */
+  uint16_t *Slots;      /*!< Pool slot of each tile, BGFX_TILE_SOLID for a
+                             tile stored as one color */
+  uint16_t *Pool;       /*!< Pixels of the other tiles, one slot of
+                             BGFX_TILE_SIZE rows after the other */
+  uint16_t PoolSlots;   /*!< Number of slots in the pool */
+  uint16_t Free;        /*!< First free slot, the next one is held in its
+                             first pixel, BGFX_TILE_SOLID if none */
+  uint16_t Used;        /*!< Slots in use */
+  uint16_t Peak;        /*!< Most slots in use at once */
+  uint32_t Dropped;     /*!< Writes lost because the pool was full */
+}BGFX_Tiles_t;
+
+
+/**
+ * @brief Sends a row of pixels to the display, called by BGFX_TilesFlush
+ * @param Pixels  5-6-5 pixels of the row
+ * @param x       Buffer x coordinate of the first pixel
+ * @param y       Buffer row
+ * @param Count   Number of pixels
+ * @param Context Pointer given to BGFX_TilesFlush
+ */
+typedef void (*BGFX_TilesFlush_t)(const uint16_t *Pixels, uint16_t x,
+    uint16_t y, uint16_t Count, void *Context);
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the size of the tile grid of a display
+    @param  Display Structure to display parameters and functions
+    @return Grid size in bytes
+ */
+/**************************************************************************/
+uint32_t BGFX_TilesGridSize(BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Set up a tiled framebuffer, every tile solid
+    @param  Tiles   Framebuffer to set up
+    @param  Grid    Memory for the grid, BGFX_TilesGridSize bytes
+    @param  Pool    Memory for the pixels of detailed tiles, 2 bytes per
+                    pixel, BGFX_TILE_SIZE squared pixels per tile
+    @param  PoolSize    Size of Pool in bytes
+    @param  color   16-bit 5-6-5 Color of the whole buffer
+    @param  Display Structure to display parameters and functions
+    @return 0 on success, -1 if the display is not BGFX_16BITS
+ */
+/**************************************************************************/
+int BGFX_TilesInit(BGFX_Tiles_t *Tiles, void *Grid, void *Pool,
+    uint32_t PoolSize, uint16_t color, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle
+    @param  Tiles   Framebuffer to draw to
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_TilesFillRect(BGFX_Tiles_t *Tiles, int16_t x, int16_t y, int16_t w,
+    int16_t h, uint16_t color, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a rectangle with rounded corners
+    @param  Tiles   Framebuffer to draw to
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  w   Width in pixels
+    @param  h   Height in pixels
+    @param  r   Radius of corner rounding
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_TilesFillRoundRect(BGFX_Tiles_t *Tiles, int16_t x, int16_t y,
+    int16_t w, int16_t h, int16_t r, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a circle
+    @param  Tiles   Framebuffer to draw to
+    @param  x0  Center-point x coordinate
+    @param  y0  Center-point y coordinate
+    @param  r   Radius of circle
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_TilesFillCircle(BGFX_Tiles_t *Tiles, int16_t x0, int16_t y0,
+    int16_t r, uint16_t color, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a triangle
+    @param  Tiles   Framebuffer to draw to
+    @param  x0  Vertex #0 x coordinate
+    @param  y0  Vertex #0 y coordinate
+    @param  x1  Vertex #1 x coordinate
+    @param  y1  Vertex #1 y coordinate
+    @param  x2  Vertex #2 x coordinate
+    @param  y2  Vertex #2 y coordinate
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_TilesFillTriangle(BGFX_Tiles_t *Tiles, int16_t x0, int16_t y0,
+    int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a polygon, see BGFX_SpansPolygon
+    @param  Tiles   Framebuffer to draw to
+    @param  Points  Vertices, x and y pairs
+    @param  Count   Number of vertices
+    @param  color   16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_TilesFillPolygon(BGFX_Tiles_t *Tiles, const int16_t *Points,
+    uint16_t Count, uint16_t color, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Write a pixel, without rotation or clipping. Meant to be called
+            from a DrawPixel function, which gets buffer coordinates.
+    @param  Tiles   Framebuffer to draw to
+    @param  x   Buffer x coordinate
+    @param  y   Buffer y coordinate
+    @param  color   16-bit 5-6-5 Color
+ */
+/**************************************************************************/
+void BGFX_TilesWritePixel(BGFX_Tiles_t *Tiles, uint16_t x, uint16_t y,
+    uint16_t color);
+
+
+/**************************************************************************/
+/*!
+    @brief  Read a pixel
+    @param  Tiles   Framebuffer to read
+    @param  x   Buffer x coordinate
+    @param  y   Buffer y coordinate
+    @return 16-bit 5-6-5 Color, 0 outside the buffer
+ */
+/**************************************************************************/
+uint16_t BGFX_TilesReadPixel(const BGFX_Tiles_t *Tiles, uint16_t x,
+    uint16_t y);
+
+
+/**************************************************************************/
+/*!
+    @brief  Turn every detailed tile that holds a single color back to a
+            solid tile, after drawing pixel by pixel for instance
+    @param  Tiles   Framebuffer to compact
+    @return Number of slots freed
+ */
+/**************************************************************************/
+uint16_t BGFX_TilesCompact(BGFX_Tiles_t *Tiles);
+
+
+/**************************************************************************/
+/*!
+    @brief  Expand an area row by row and send each row
+    @param  Tiles   Framebuffer to send
+    @param  Area    Area in buffer (unrotated) coordinates
+    @param  Row     Memory for one row of Area, Area.W pixels
+    @param  Flush   Called once per row, top to bottom
+    @param  Context Passed to Flush
+ */
+/**************************************************************************/
+void BGFX_TilesFlush(const BGFX_Tiles_t *Tiles, BGFX_Rect_t Area,
+    uint16_t *Row, BGFX_TilesFlush_t Flush, void *Context);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_TILES_H */
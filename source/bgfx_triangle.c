@@ -0,0 +1,338 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include "bgfx_triangle.h"
+
+
+#ifndef BGFX_TRIANGLE_CHUNK
+#define BGFX_TRIANGLE_CHUNK 64 /*!< Pixels shaded before each BGFX_WriteSpan */
+#endif
+
+
+/**
+ * @brief Triangle edge, stepped one scanline at a time
+ */
+typedef struct
+{
+  int32_t X;      /*!< Crossing at the current scanline, 16.16 pixels */
+  int32_t Step;   /*!< X increment per scanline, 16.16 pixels */
+  int32_t Y0;     /*!< First scanline crossed */
+  int32_t Y1;     /*!< Scanline after the last one crossed */
+}BGFX_TriEdge_t;
+
+
+/**
+ * @brief Color planes of a Gouraud triangle, 8.16 components
+ */
+typedef struct
+{
+  int32_t C0[3];        /*!< Components at vertex #0 */
+  int32_t DcDx[3];      /*!< Increment per pixel to the right */
+  int32_t DcDy[3];      /*!< Increment per pixel down */
+  int32_t X0;           /*!< Vertex #0 x, 28.4 */
+  int32_t Y0;           /*!< Vertex #0 y, 28.4 */
+  BGFX_GradientFormat_t Format; /*!< Output format */
+}BGFX_Shade_t;
+
+
+static void BGFX_TriangleRaster(const BGFX_Vertex_t *v0,
+    const BGFX_Vertex_t *v1, const BGFX_Vertex_t *v2, uint16_t color,
+    const BGFX_Shade_t *Shade, BGFX_Parameters_t Display);
+
+static void BGFX_EdgeSetup(BGFX_TriEdge_t *e, const BGFX_Vertex_t *a,
+    const BGFX_Vertex_t *b, int32_t FirstRow);
+
+static void BGFX_ShadeSetup(BGFX_Shade_t *s, const BGFX_Vertex_t *v0,
+    const BGFX_Vertex_t *v1, const BGFX_Vertex_t *v2,
+    BGFX_GradientFormat_t Format);
+
+static void BGFX_ShadeSpan(const BGFX_Shade_t *s, int16_t x, int16_t y,
+    int16_t w, BGFX_Parameters_t Display);
+
+static void BGFX_Components(uint16_t color, BGFX_GradientFormat_t Format,
+    int32_t *c);
+
+
+
+void BGFX_DrawTriangleFillFixed(const BGFX_Vertex_t *v0,
+    const BGFX_Vertex_t *v1, const BGFX_Vertex_t *v2, uint16_t color,
+    BGFX_Parameters_t Display)
+{
+  BGFX_TriangleRaster(v0, v1, v2, color, NULL, Display);
+}
+
+
+
+
+void BGFX_DrawTriangleGouraud(const BGFX_Vertex_t *v0,
+    const BGFX_Vertex_t *v1, const BGFX_Vertex_t *v2,
+    BGFX_GradientFormat_t Format, BGFX_Parameters_t Display)
+{
+  BGFX_Shade_t shade;
+
+  BGFX_ShadeSetup(&shade, v0, v1, v2, Format);
+  BGFX_TriangleRaster(v0, v1, v2, 0, &shade, Display);
+}
+
+
+
+
+void BGFX_DrawMeshFill(const BGFX_Vertex_t *Vertices, const uint16_t *Indices,
+    uint16_t TriangleCount, uint16_t color, BGFX_Parameters_t Display)
+{
+  uint16_t i;
+
+  for (i = 0; i < TriangleCount; i++, Indices += 3) {
+    BGFX_TriangleRaster(&Vertices[Indices[0]], &Vertices[Indices[1]],
+        &Vertices[Indices[2]], color, NULL, Display);
+  }
+}
+
+
+
+
+void BGFX_DrawMeshGouraud(const BGFX_Vertex_t *Vertices,
+    const uint16_t *Indices, uint16_t TriangleCount,
+    BGFX_GradientFormat_t Format, BGFX_Parameters_t Display)
+{
+  BGFX_Shade_t shade;
+  uint16_t i;
+
+  for (i = 0; i < TriangleCount; i++, Indices += 3) {
+    BGFX_ShadeSetup(&shade, &Vertices[Indices[0]], &Vertices[Indices[1]],
+        &Vertices[Indices[2]], Format);
+    BGFX_TriangleRaster(&Vertices[Indices[0]], &Vertices[Indices[1]],
+        &Vertices[Indices[2]], 0, &shade, Display);
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Scan a triangle. Row j is covered where its center j + 0.5 lies
+            in [top, bottom) of an edge, and pixel i where its center lies in
+            [left, right): left and top edges are inclusive, right and bottom
+            edges exclusive, which is the top-left rule. An edge is always
+            set up from its upper end, so two triangles sharing it step
+            through exactly the same positions.
+    @param  v0  Vertex #0
+    @param  v1  Vertex #1
+    @param  v2  Vertex #2
+    @param  color Solid color, used when Shade is NULL
+    @param  Shade Color planes for Gouraud shading, or NULL
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_TriangleRaster(const BGFX_Vertex_t *v0,
+    const BGFX_Vertex_t *v1, const BGFX_Vertex_t *v2, uint16_t color,
+    const BGFX_Shade_t *Shade, BGFX_Parameters_t Display)
+{
+  const BGFX_Vertex_t *t;
+  BGFX_TriEdge_t e02, e01, e12;
+  BGFX_TriEdge_t *left, *right, *shorter;
+  int64_t cross;
+  int32_t y, y_end, first, end;
+  BGFX_Rect_t clip;
+
+  BGFX_SetRotation(Display.Rotation, &Display);
+  clip = BGFX_GetClip(Display);
+
+  /* Sort vertices by y (v2 >= v1 >= v0) */
+  if (v0->Y > v1->Y) { t = v0; v0 = v1; v1 = t; }
+  if (v1->Y > v2->Y) { t = v1; v1 = v2; v2 = t; }
+  if (v0->Y > v1->Y) { t = v0; v0 = v1; v1 = t; }
+
+  /* Side of v1 relative to the long edge, zero for a degenerate triangle */
+  cross = (int64_t)(v2->X - v0->X) * (v1->Y - v0->Y) -
+      (int64_t)(v2->Y - v0->Y) * (v1->X - v0->X);
+  if (cross == 0) {
+    return;
+  }
+
+  /* Rows above the drawable area are skipped, edges are moved there at
+   * once */
+  y = (v0->Y + 7) >> 4;
+  if (y < clip.Y) {
+    y = clip.Y;
+  }
+  BGFX_EdgeSetup(&e02, v0, v2, y);
+  BGFX_EdgeSetup(&e01, v0, v1, y);
+  BGFX_EdgeSetup(&e12, v1, v2, (e01.Y1 > y) ? e01.Y1 : y);
+
+  y_end = e02.Y1;
+  if (y_end > clip.Y + clip.H) {
+    y_end = clip.Y + clip.H;
+  }
+
+  for (; y < y_end; y++) {
+    shorter = (y < e01.Y1) ? &e01 : &e12;
+    if (cross > 0) {
+      left = shorter;
+      right = &e02;
+    } else {
+      left = &e02;
+      right = shorter;
+    }
+
+    /* Pixels whose center falls in [left, right) */
+    first = (left->X + 0x7FFF) >> 16;
+    end = (right->X + 0x7FFF) >> 16;
+    if (first < clip.X) {
+      first = clip.X;
+    }
+    if (end > clip.X + clip.W) {
+      end = clip.X + clip.W;
+    }
+    if (first < end) {
+      if (Shade == NULL) {
+        BGFX_DrawHLine(first, y, end - first, color, Display);
+      } else {
+        BGFX_ShadeSpan(Shade, first, y, end - first, Display);
+      }
+    }
+
+    e02.X += e02.Step;
+    shorter->X += shorter->Step;
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Set up an edge from its upper to its lower vertex. The only
+            division of the rasterizer is here, once per edge.
+    @param  e   Edge to set up
+    @param  a   Upper vertex
+    @param  b   Lower vertex
+    @param  FirstRow  Row where stepping starts, the edge is advanced to it
+            if it starts above
+ */
+/**************************************************************************/
+static void BGFX_EdgeSetup(BGFX_TriEdge_t *e, const BGFX_Vertex_t *a,
+    const BGFX_Vertex_t *b, int32_t FirstRow)
+{
+  int32_t dy = b->Y - a->Y;
+  int32_t row;
+
+  /* Rows whose center j * 16 + 8 lies in [a->Y, b->Y) */
+  e->Y0 = (a->Y + 7) >> 4;
+  e->Y1 = (b->Y + 7) >> 4;
+  if (dy == 0) {
+    e->X = 0;
+    e->Step = 0;
+    return;
+  }
+
+  e->Step = (int32_t)(((int64_t)(b->X - a->X) * 65536) / dy);
+  row = (FirstRow > e->Y0) ? FirstRow : e->Y0;
+  e->X = (int32_t)((int64_t)a->X * 4096 +
+      ((int64_t)(row * 16 + 8 - a->Y) * e->Step) / 16);
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Compute the color planes of a triangle from its vertex colors
+    @param  s   Planes to fill
+    @param  v0  Vertex #0
+    @param  v1  Vertex #1
+    @param  v2  Vertex #2
+    @param  Format  Format of the vertex colors
+ */
+/**************************************************************************/
+static void BGFX_ShadeSetup(BGFX_Shade_t *s, const BGFX_Vertex_t *v0,
+    const BGFX_Vertex_t *v1, const BGFX_Vertex_t *v2,
+    BGFX_GradientFormat_t Format)
+{
+  int64_t x1 = v1->X - v0->X, y1 = v1->Y - v0->Y;
+  int64_t x2 = v2->X - v0->X, y2 = v2->Y - v0->Y;
+  int64_t area = x1 * y2 - x2 * y1;
+  int32_t c1[3], c2[3];
+  uint8_t j;
+
+  BGFX_Components(v0->Color, Format, s->C0);
+  BGFX_Components(v1->Color, Format, c1);
+  BGFX_Components(v2->Color, Format, c2);
+  s->X0 = v0->X;
+  s->Y0 = v0->Y;
+  s->Format = Format;
+
+  for (j = 0; j < 3; j++) {
+    int64_t d1 = c1[j] - s->C0[j];
+    int64_t d2 = c2[j] - s->C0[j];
+    if (area == 0) {
+      s->DcDx[j] = s->DcDy[j] = 0;
+    } else {
+      /* Plane gradients, per 28.4 unit times 16 to get per pixel */
+      s->DcDx[j] = (int32_t)(((d1 * y2 - d2 * y1) * 16) / area);
+      s->DcDy[j] = (int32_t)(((d2 * x1 - d1 * x2) * 16) / area);
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Shade a span with the color planes and write it
+    @param  s   Color planes
+    @param  x   Left-most pixel x coordinate
+    @param  y   Row y coordinate
+    @param  w   Number of pixels
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_ShadeSpan(const BGFX_Shade_t *s, int16_t x, int16_t y,
+    int16_t w, BGFX_Parameters_t Display)
+{
+  uint16_t line[BGFX_TRIANGLE_CHUNK];
+  int32_t c[3], v[3];
+  int64_t dx = (int64_t)x * 16 + 8 - s->X0;
+  int64_t dy = (int64_t)y * 16 + 8 - s->Y0;
+  int16_t n = 0;
+  uint8_t j;
+
+  /* Components at the first pixel center, then stepped */
+  for (j = 0; j < 3; j++) {
+    c[j] = (int32_t)(s->C0[j] + (s->DcDx[j] * dx + s->DcDy[j] * dy) / 16);
+  }
+
+  while (w > 0) {
+    for (j = 0; j < 3; j++) {
+      v[j] = c[j] >> 16;
+      v[j] = (v[j] < 0) ? 0 : (v[j] > 255) ? 255 : v[j];
+      c[j] += s->DcDx[j];
+    }
+    if (s->Format == BGFX_GRADIENT_GRAY8) {
+      line[n] = v[0];
+    } else {
+      line[n] = ((v[0] >> 3) << 11) | ((v[1] >> 2) << 5) | (v[2] >> 3);
+    }
+    n++;
+    w--;
+    if ((n == BGFX_TRIANGLE_CHUNK) || (w == 0)) {
+      BGFX_WriteSpan(x, y, n, line, Display);
+      x += n;
+      n = 0;
+    }
+  }
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Color components of a vertex color, in 8.16 fixed point
+    @param  color   Vertex color
+    @param  Format  Format of the color
+    @param  c       Red, green and blue components, or gray three times
+ */
+/**************************************************************************/
+static void BGFX_Components(uint16_t color, BGFX_GradientFormat_t Format,
+    int32_t *c)
+{
+  if (Format == BGFX_GRADIENT_GRAY8) {
+    c[0] = c[1] = c[2] = (int32_t)(color & 0xFF) << 16;
+  } else {
+    c[0] = (int32_t)((color >> 11) << 3) << 16;
+    c[1] = (int32_t)(((color >> 5) & 0x3F) << 2) << 16;
+    c[2] = (int32_t)((color & 0x1F) << 3) << 16;
+  }
+}
@@ -0,0 +1,110 @@
+/**
+ * @file  bgfx_triangle.h
+ * @date  19-October-2026
+ * @brief Sub-pixel precise triangle rasterizer.
+ *
+ * @author
+ * @author
+ *
+ * Vertices are given in 28.4 fixed point (1/16 pixel). Pixels are sampled at
+ * their center and the top-left fill rule decides the pixels lying exactly on
+ * an edge, so triangles sharing an edge cover each pixel once: no gaps and no
+ * double drawing inside a mesh. Edge positions are set up once per edge and
+ * stepped per scanline, with no division inside the loops.
+ *
+ * Integer coordinates on pixel corners are written BGFX_FIXED4(x): a triangle
+ * (0,0), (10,0), (0,10) covers the 45 pixels strictly above its diagonal.
+ */
+
+#ifndef BGFX_TRIANGLE_H
+#define BGFX_TRIANGLE_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+#include "bgfx_gradient.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define BGFX_FIXED4(v) ((int32_t)((v) * 16)) /*!< Pixels to 28.4 fixed point */
+
+
+/**
+ * @brief Triangle vertex
+ */
+typedef struct
+{
+  int32_t X;            /*!< x coordinate, 28.4 fixed point */
+  int32_t Y;            /*!< y coordinate, 28.4 fixed point */
+  uint16_t Color;       /*!< Vertex color, used by the Gouraud functions */
+}BGFX_Vertex_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a triangle with one color, top-left fill rule
+    @param  v0  Vertex #0
+    @param  v1  Vertex #1
+    @param  v2  Vertex #2
+    @param  color 16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawTriangleFillFixed(const BGFX_Vertex_t *v0,
+    const BGFX_Vertex_t *v1, const BGFX_Vertex_t *v2, uint16_t color,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill a triangle interpolating the vertex colors (Gouraud
+            shading), top-left fill rule
+    @param  v0  Vertex #0
+    @param  v1  Vertex #1
+    @param  v2  Vertex #2
+    @param  Format  Format of the vertex colors and of the output
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawTriangleGouraud(const BGFX_Vertex_t *v0,
+    const BGFX_Vertex_t *v1, const BGFX_Vertex_t *v2,
+    BGFX_GradientFormat_t Format, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill an indexed triangle mesh with one color
+    @param  Vertices  Shared vertices
+    @param  Indices   Three vertex indices per triangle
+    @param  TriangleCount Number of triangles
+    @param  color 16-bit 5-6-5 Color to fill with
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawMeshFill(const BGFX_Vertex_t *Vertices, const uint16_t *Indices,
+    uint16_t TriangleCount, uint16_t color, BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Fill an indexed triangle mesh with Gouraud shading
+    @param  Vertices  Shared vertices
+    @param  Indices   Three vertex indices per triangle
+    @param  TriangleCount Number of triangles
+    @param  Format  Format of the vertex colors and of the output
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+void BGFX_DrawMeshGouraud(const BGFX_Vertex_t *Vertices,
+    const uint16_t *Indices, uint16_t TriangleCount,
+    BGFX_GradientFormat_t Format, BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_TRIANGLE_H */
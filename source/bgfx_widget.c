@@ -0,0 +1,288 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "bgfx_widget.h"
+#include "bgfx_number.h"
+
+
+static int16_t BGFX_WidgetLevel(const BGFX_Widget_t *Widget, int16_t Length);
+
+static uint8_t BGFX_WidgetBar(BGFX_Widget_t *Widget, BGFX_Rect_t Bar,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display);
+
+static void BGFX_WidgetText(int16_t x, int16_t y, const char *Text,
+    uint8_t Length, uint16_t color, uint16_t bg, uint8_t Size,
+    BGFX_Parameters_t Display);
+
+
+
+void BGFX_WidgetSetText(BGFX_Widget_t *Widget, const char *Text)
+{
+  if (strncmp(Widget->Text, Text, BGFX_WIDGET_TEXT_LENGTH - 1) == 0) {
+    return;
+  }
+
+  strncpy(Widget->Text, Text, BGFX_WIDGET_TEXT_LENGTH - 1);
+  Widget->Text[BGFX_WIDGET_TEXT_LENGTH - 1] = '\0';
+  Widget->Valid = 0;
+}
+
+
+
+
+void BGFX_WidgetSetPressed(BGFX_Widget_t *Widget, uint8_t Pressed)
+{
+  if ((Widget->Pressed != 0) != (Pressed != 0)) {
+    Widget->Pressed = Pressed;
+    Widget->Valid = 0;
+  }
+}
+
+
+
+
+void BGFX_WidgetInvalidate(BGFX_Widget_t *Widget)
+{
+  Widget->Valid = 0;
+}
+
+
+
+
+uint8_t BGFX_WidgetDraw(BGFX_Widget_t *Widget, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t b = Widget->Bounds;
+  BGFX_Rect_t bar;
+  uint8_t size = Widget->Size ? Widget->Size : 1;
+  int16_t cw = 6 * size, ch = 8 * size;
+  char text[12 + BGFX_WIDGET_TEXT_LENGTH];
+  uint8_t n, fit, drawn = 0;
+  uint16_t fg, bg;
+  int32_t percent;
+
+  Region->X = b.X;
+  Region->Y = b.Y;
+  Region->W = 0;
+  Region->H = 0;
+  if ((b.W <= 0) || (b.H <= 0)) {
+    return 0;
+  }
+  fit = (b.W / cw > 255) ? 255 : b.W / cw;
+
+  switch (Widget->Type) {
+  case BGFX_WIDGET_LABEL:
+    if (Widget->Valid) {
+      break;
+    }
+    n = strlen(Widget->Text);
+    BGFX_DrawRectFill(b.X, b.Y, b.W, b.H, Widget->Background, Display);
+    BGFX_WidgetText(b.X, b.Y + (b.H - ch) / 2, Widget->Text,
+        (n < fit) ? n : fit, Widget->Color, Widget->Background, size,
+        Display);
+    *Region = b;
+    drawn = 1;
+    break;
+
+  case BGFX_WIDGET_NUMBER:
+    if (Widget->Valid && (Widget->ShownValue == Widget->Value)) {
+      break;
+    }
+    n = BGFX_FormatFixed(Widget->Value, 0, text);
+    strcpy(&text[n], Widget->Text);
+    n = strlen(text);
+    n = (n < fit) ? n : fit;
+    BGFX_DrawRectFill(b.X, b.Y, b.W, b.H, Widget->Background, Display);
+    BGFX_WidgetText(b.X + b.W - n * cw, b.Y + (b.H - ch) / 2, text, n,
+        Widget->Color, Widget->Background, size, Display);
+    Widget->ShownValue = Widget->Value;
+    *Region = b;
+    drawn = 1;
+    break;
+
+  case BGFX_WIDGET_BAR:
+    drawn = BGFX_WidgetBar(Widget, b, Region, Display);
+    break;
+
+  case BGFX_WIDGET_PROGRESS:
+    /* Bar on the left, room for "100%" on the right */
+    if (!Widget->Valid) {
+      BGFX_DrawRectFill(b.X, b.Y, b.W, b.H, Widget->Background, Display);
+    }
+    bar = b;
+    bar.W -= 4 * cw + size;
+    if (bar.W > 2) {
+      drawn = BGFX_WidgetBar(Widget, bar, Region, Display);
+    }
+    percent = 0;
+    if (Widget->Max > Widget->Min) {
+      percent = (int32_t)(((int64_t)Widget->Value - Widget->Min) * 100 /
+          ((int64_t)Widget->Max - Widget->Min));
+      percent = (percent < 0) ? 0 : (percent > 100) ? 100 : percent;
+    }
+    if (Widget->Valid && (Widget->ShownValue == percent)) {
+      break;
+    }
+    n = BGFX_FormatFixed(percent, 0, text);
+    text[n++] = '%';
+    bar.X = b.X + b.W - 4 * cw;
+    bar.Y = b.Y + (b.H - ch) / 2;
+    bar.W = 4 * cw;
+    bar.H = ch;
+    BGFX_DrawRectFill(bar.X, bar.Y, bar.W - n * cw, bar.H,
+        Widget->Background, Display);
+    BGFX_WidgetText(bar.X + bar.W - n * cw, bar.Y, text, n, Widget->Color,
+        Widget->Background, size, Display);
+    Widget->ShownValue = percent;
+    BGFX_RectUnion(Region, bar);
+    if (!Widget->Valid) {
+      /* Margins were cleared too */
+      *Region = b;
+    }
+    drawn = 1;
+    break;
+
+  case BGFX_WIDGET_BUTTON:
+    if (Widget->Valid) {
+      break;
+    }
+    fg = Widget->Pressed ? Widget->Background : Widget->Color;
+    bg = Widget->Pressed ? Widget->Color : Widget->Background;
+    n = strlen(Widget->Text);
+    n = (n < fit) ? n : fit;
+    BGFX_DrawRoundRectFill(b.X, b.Y, b.W, b.H, b.H / 4, bg, Display);
+    BGFX_DrawRoundRect(b.X, b.Y, b.W, b.H, b.H / 4, Widget->Color, Display);
+    BGFX_WidgetText(b.X + (b.W - n * cw) / 2, b.Y + (b.H - ch) / 2,
+        Widget->Text, n, fg, bg, size, Display);
+    *Region = b;
+    drawn = 1;
+    break;
+  }
+
+  Widget->Valid = 1;
+  return drawn;
+}
+
+
+
+
+uint16_t BGFX_WidgetsDraw(BGFX_Widget_t *Widgets, uint16_t Count,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display)
+{
+  BGFX_Rect_t r;
+  uint16_t drawn = 0;
+
+  Region->W = 0;
+  Region->H = 0;
+  for (; Count > 0; Count--, Widgets++) {
+    if (BGFX_WidgetDraw(Widgets, &r, Display)) {
+      BGFX_RectUnion(Region, r);
+      drawn++;
+    }
+  }
+
+  return drawn;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Length of the filled part of a bar
+    @param  Widget  Bar or progress widget
+    @param  Length  Length of a full bar, in pixels
+    @return Filled length, from 0 to Length
+ */
+/**************************************************************************/
+static int16_t BGFX_WidgetLevel(const BGFX_Widget_t *Widget, int16_t Length)
+{
+  int64_t level;
+
+  if ((Widget->Max <= Widget->Min) || (Length <= 0)) {
+    return 0;
+  }
+
+  level = ((int64_t)Widget->Value - Widget->Min) * Length /
+      ((int64_t)Widget->Max - Widget->Min);
+  return (level < 0) ? 0 : (level > Length) ? Length : (int16_t)level;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a bar with a one pixel border. Once drawn, only the strip
+            between the old and the new level is drawn again.
+    @param  Widget  Bar or progress widget
+    @param  Bar     Area of the bar, border included
+    @param  Region  Returns the area drawn
+    @param  Display Structure to display parameters and functions
+    @return 1 if something was drawn, 0 otherwise
+ */
+/**************************************************************************/
+static uint8_t BGFX_WidgetBar(BGFX_Widget_t *Widget, BGFX_Rect_t Bar,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display)
+{
+  uint8_t vertical = (Widget->Type == BGFX_WIDGET_BAR) && (Bar.H > Bar.W);
+  int16_t length = (vertical ? Bar.H : Bar.W) - 2;
+  int16_t level = BGFX_WidgetLevel(Widget, length);
+  int16_t lo, hi;
+  BGFX_Rect_t r;
+
+  if (!Widget->Valid) {
+    BGFX_DrawRect(Bar.X, Bar.Y, Bar.W, Bar.H, Widget->Color, Display);
+    BGFX_DrawRectFill(Bar.X + 1, Bar.Y + 1, Bar.W - 2, Bar.H - 2,
+        Widget->Background, Display);
+    Widget->ShownLevel = 0;
+    *Region = Bar;
+  } else if (level == Widget->ShownLevel) {
+    return 0;
+  }
+
+  /* Strip between the drawn and the new level */
+  lo = (level < Widget->ShownLevel) ? level : Widget->ShownLevel;
+  hi = (level < Widget->ShownLevel) ? Widget->ShownLevel : level;
+  if (vertical) {
+    r.X = Bar.X + 1;
+    r.Y = Bar.Y + 1 + length - hi;
+    r.W = Bar.W - 2;
+    r.H = hi - lo;
+  } else {
+    r.X = Bar.X + 1 + lo;
+    r.Y = Bar.Y + 1;
+    r.W = hi - lo;
+    r.H = Bar.H - 2;
+  }
+  if ((r.W > 0) && (r.H > 0)) {
+    BGFX_DrawRectFill(r.X, r.Y, r.W, r.H,
+        (level > Widget->ShownLevel) ? Widget->Color : Widget->Background,
+        Display);
+  }
+  if (Widget->Valid) {
+    *Region = r;
+  }
+
+  Widget->ShownLevel = level;
+  return 1;
+}
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw a run of characters with the default font
+    @param  x   Top left corner x coordinate
+    @param  y   Top left corner y coordinate
+    @param  Text    Characters to draw
+    @param  Length  Number of characters
+    @param  color   Text color
+    @param  bg      Background color
+    @param  Size    Text size multiplier
+    @param  Display Structure to display parameters and functions
+ */
+/**************************************************************************/
+static void BGFX_WidgetText(int16_t x, int16_t y, const char *Text,
+    uint8_t Length, uint16_t color, uint16_t bg, uint8_t Size,
+    BGFX_Parameters_t Display)
+{
+  BGFX_SendString(x, y, (uint8_t *)Text, Length, color, bg, Size, Size,
+      Display);
+}
+
@@ -0,0 +1,138 @@
+/**
+ * @file  bgfx_widget.h
+ * @date  19-October-2026
+ * @brief Retained-mode widgets: labels, numbers, bars, progress bars and
+ *        buttons.
+ *
+ * @author
+ * @author
+ *
+ * A widget remembers what it last drew. BGFX_WidgetDraw only draws again
+ * when a property changed, and only what changed: a bar that moves draws
+ * the strip between its old and new level, a number draws its cell when
+ * the value differs. The drawn area is returned so that only it is sent to
+ * the display. Widgets use the default 6x8 font (BGFX_SendString).
+ *
+ * Fields are set by the caller. Changes to Text and Pressed go through the
+ * setters, or are followed by BGFX_WidgetInvalidate; Value may be written
+ * directly. A zero-initialized widget is drawn entirely the first time.
+ */
+
+#ifndef BGFX_WIDGET_H
+#define BGFX_WIDGET_H
+
+
+#include <stdint.h>
+#include "basic_graphics.h"
+
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#ifndef BGFX_WIDGET_TEXT_LENGTH
+#define BGFX_WIDGET_TEXT_LENGTH 16 /*!< Text size, terminator included */
+#endif
+
+
+/**
+ * @brief Kinds of widgets
+ */
+typedef enum
+{
+  BGFX_WIDGET_LABEL = 0,  /*!< Text, left aligned */
+  BGFX_WIDGET_NUMBER,     /*!< Value followed by Text (unit), right aligned */
+  BGFX_WIDGET_BAR,        /*!< Level gauge, vertical if taller than wide */
+  BGFX_WIDGET_PROGRESS,   /*!< Horizontal bar followed by a percentage */
+  BGFX_WIDGET_BUTTON,     /*!< Rounded button with Text centered, colors
+                               swapped while Pressed */
+}BGFX_WidgetType_t;
+
+
+/**
+ * @brief Widget and its last drawn state
+ */
+typedef struct
+{
+  BGFX_WidgetType_t Type; /*!< Kind of widget */
+  BGFX_Rect_t Bounds;   /*!< Area covered, screen coordinates */
+  uint16_t Color;       /*!< Text, border and bar color */
+  uint16_t Background;  /*!< Background color */
+  uint8_t Size;         /*!< Text size multiplier, 0 is the same as 1 */
+  int32_t Min;          /*!< Bar and progress: value of an empty bar */
+  int32_t Max;          /*!< Bar and progress: value of a full bar */
+  int32_t Value;        /*!< Number, bar and progress value */
+  uint8_t Pressed;      /*!< Button state, use BGFX_WidgetSetPressed */
+  char Text[BGFX_WIDGET_TEXT_LENGTH]; /*!< Label, unit or caption, use
+                                           BGFX_WidgetSetText */
+
+  uint8_t Valid;        /*!< Set once drawn, cleared to draw everything */
+  int32_t ShownValue;   /*!< Value drawn */
+  int16_t ShownLevel;   /*!< Bar length drawn, in pixels */
+}BGFX_Widget_t;
+
+
+/**************************************************************************/
+/*!
+    @brief  Change the text of a widget, invalidating it if different
+    @param  Widget  Widget to change
+    @param  Text    Zero terminated text, truncated to fit
+ */
+/**************************************************************************/
+void BGFX_WidgetSetText(BGFX_Widget_t *Widget, const char *Text);
+
+
+/**************************************************************************/
+/*!
+    @brief  Change the state of a button, invalidating it if different
+    @param  Widget  Button to change
+    @param  Pressed 1 if pressed, 0 if released
+ */
+/**************************************************************************/
+void BGFX_WidgetSetPressed(BGFX_Widget_t *Widget, uint8_t Pressed);
+
+
+/**************************************************************************/
+/*!
+    @brief  Have the whole widget drawn again on the next BGFX_WidgetDraw,
+            after moving it, changing colors, or drawing over it
+    @param  Widget  Widget to invalidate
+ */
+/**************************************************************************/
+void BGFX_WidgetInvalidate(BGFX_Widget_t *Widget);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw what changed in a widget since it was last drawn
+    @param  Widget  Widget to draw
+    @param  Region  Returns the area drawn, screen coordinates, empty if
+            nothing changed
+    @param  Display Structure to display parameters and functions
+    @return 1 if something was drawn, 0 otherwise
+ */
+/**************************************************************************/
+uint8_t BGFX_WidgetDraw(BGFX_Widget_t *Widget, BGFX_Rect_t *Region,
+    BGFX_Parameters_t Display);
+
+
+/**************************************************************************/
+/*!
+    @brief  Draw what changed in a set of widgets
+    @param  Widgets Widgets to draw, in drawing order
+    @param  Count   Number of widgets
+    @param  Region  Returns the union of the areas drawn, screen
+            coordinates, empty if nothing changed
+    @param  Display Structure to display parameters and functions
+    @return Number of widgets drawn
+ */
+/**************************************************************************/
+uint16_t BGFX_WidgetsDraw(BGFX_Widget_t *Widgets, uint16_t Count,
+    BGFX_Rect_t *Region, BGFX_Parameters_t Display);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BGFX_WIDGET_H */